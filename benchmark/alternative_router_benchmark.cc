@@ -0,0 +1,180 @@
+// Alternative routes on a grid city: the via-node router, two searches for
+// all k routes with reused per-thread state, against the penalty method,
+// k plain Dijkstra searches that each raise the weights of the last route.
+#include <opendrive-engine/algo/route/alternative_router.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using opendrive::engine::geometry::Vec2d;
+using opendrive::engine::route::AlternativeRouter;
+using opendrive::engine::route::LaneGraph;
+using opendrive::engine::route::LaneGraphLane;
+using opendrive::engine::route::LaneGraphLanes;
+using opendrive::engine::route::LaneGraphParam;
+using opendrive::engine::route::Routes;
+
+namespace {
+
+template <typename Func>
+double Run(int rounds, Func func) {
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) func();
+  std::chrono::duration<double, std::micro> cost =
+      std::chrono::steady_clock::now() - start;
+  return cost.count() / rounds;
+}
+
+// streets between neighbouring crossings, two lanes each way
+LaneGraphLanes GridLanes(int size, double block) {
+  LaneGraphLanes lanes;
+  int section = 0;
+  auto add = [&](const std::string& id, int index, const Vec2d& a,
+                 const Vec2d& b) {
+    LaneGraphLane lane;
+    lane.id = id + "_" + std::to_string(index);
+    lane.section_id = id;
+    lane.index = index;
+    lane.length = a.DistanceTo(b);
+    lane.entry = a;
+    lane.exit = b;
+    lane.entry_heading = lane.exit_heading =
+        std::atan2(b.y() - a.y(), b.x() - a.x());
+    lanes.emplace_back(lane);
+  };
+  for (int i = 0; i < size; ++i) {
+    for (int j = 0; j < size; ++j) {
+      const Vec2d node(i * block, j * block);
+      if (i + 1 < size) {
+        const Vec2d next((i + 1) * block, j * block);
+        const std::string id = std::to_string(section++);
+        add(id, -1, node, next);
+        add(id, -2, node, next);
+        add(id, 1, next, node);
+        add(id, 2, next, node);
+      }
+      if (j + 1 < size) {
+        const Vec2d next(i * block, (j + 1) * block);
+        const std::string id = std::to_string(section++);
+        add(id, -1, node, next);
+        add(id, -2, node, next);
+        add(id, 1, next, node);
+        add(id, 2, next, node);
+      }
+    }
+  }
+  return lanes;
+}
+
+// lane to lane Dijkstra with its own state, as a route planner without
+// shared search state would run it
+std::vector<uint32_t> Dijkstra(const LaneGraph& graph,
+                               const std::vector<double>& weights,
+                               uint32_t from, uint32_t to, double* cost) {
+  std::vector<double> label(graph.num_lanes(),
+                            std::numeric_limits<double>::infinity());
+  std::vector<uint32_t> parent(graph.num_lanes(), from);
+  typedef std::pair<double, uint32_t> Entry;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+  label[from] = 0;
+  queue.push({0, from});
+  while (!queue.empty()) {
+    const Entry entry = queue.top();
+    queue.pop();
+    if (entry.first > label[entry.second]) continue;
+    if (entry.second == to) break;
+    for (auto it = graph.out_begin(entry.second);
+         it != graph.out_end(entry.second); ++it) {
+      const double value =
+          entry.first +
+          (opendrive::engine::route::LaneEdgeType::SUCCESSOR == it->type
+               ? weights[entry.second]
+               : graph.param().lane_change_cost);
+      if (value < label[it->lane]) {
+        label[it->lane] = value;
+        parent[it->lane] = entry.second;
+        queue.push({value, it->lane});
+      }
+    }
+  }
+  *cost = label[to];
+  std::vector<uint32_t> path;
+  if (std::isinf(label[to])) return path;
+  for (uint32_t lane = to; lane != from; lane = parent[lane]) {
+    path.emplace_back(lane);
+  }
+  path.emplace_back(from);
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+}  // namespace
+
+int main() {
+  constexpr size_t kRoutes = 3;
+  std::printf("%6s %8s %14s %14s %12s %12s\n", "grid", "lanes", "via(us)",
+              "penalty(us)", "via routes", "pen routes");
+  for (int size : {10, 20, 40}) {
+    LaneGraphParam graph_param;
+    graph_param.connect_heading = 2.0;
+    auto graph = std::make_shared<LaneGraph>();
+    graph->Init(GridLanes(size, 100.0), graph_param);
+    std::mt19937 rng(31);
+    std::uniform_real_distribution<double> factor(0.8, 1.5);
+    std::vector<double> weights(graph->num_lanes());
+    for (size_t i = 0; i < weights.size(); ++i) {
+      weights[i] = graph->lane(static_cast<uint32_t>(i)).length * factor(rng);
+    }
+    AlternativeRouter router;
+    router.Init(graph);
+
+    std::uniform_int_distribution<uint32_t> lane(
+        0, static_cast<uint32_t>(graph->num_lanes() - 1));
+    std::vector<std::pair<uint32_t, uint32_t>> queries(200);
+    for (auto& query : queries) query = {lane(rng), lane(rng)};
+
+    size_t via_routes = 0;
+    size_t index = 0;
+    Routes routes;
+    const double via = Run(static_cast<int>(queries.size()), [&]() {
+      const auto& query = queries[index++ % queries.size()];
+      router.Search(query.first, 0, query.second, 0, kRoutes, weights,
+                    &routes);
+      via_routes += routes.size();
+    });
+
+    size_t penalty_routes = 0;
+    index = 0;
+    const double penalty = Run(static_cast<int>(queries.size()), [&]() {
+      const auto& query = queries[index++ % queries.size()];
+      std::vector<double> penalized = weights;
+      std::vector<std::vector<uint32_t>> found;
+      for (size_t k = 0; k < kRoutes; ++k) {
+        double cost = 0;
+        auto path =
+            Dijkstra(*graph, penalized, query.first, query.second, &cost);
+        if (path.empty()) break;
+        for (uint32_t l : path) penalized[l] *= 1.5;
+        if (std::find(found.begin(), found.end(), path) == found.end()) {
+          found.emplace_back(std::move(path));
+        }
+      }
+      penalty_routes += found.size();
+    });
+
+    std::printf("%6d %8zu %14.1f %14.1f %12.2f %12.2f\n", size,
+                graph->num_lanes(), via, penalty,
+                static_cast<double>(via_routes) / queries.size(),
+                static_cast<double>(penalty_routes) / queries.size());
+  }
+  return 0;
+}
@@ -0,0 +1,108 @@
+// Trajectory footprints against obstacles: the pairwise Box2d::HasOverlap
+// loop against Box2dBatch::FirstOverlap.
+#include <opendrive-engine/geometry/box2d.h>
+#include <opendrive-engine/geometry/box2d_batch.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using opendrive::engine::geometry::Box2d;
+using opendrive::engine::geometry::Box2dBatch;
+
+namespace {
+
+int PairwiseFirstOverlap(const std::vector<Box2d>& trajectory,
+                         const std::vector<Box2d>& obstacles) {
+  for (size_t i = 0; i < trajectory.size(); ++i) {
+    for (const auto& obstacle : obstacles) {
+      if (trajectory[i].HasOverlap(obstacle)) {
+        return static_cast<int>(i);
+      }
+    }
+  }
+  return -1;
+}
+
+// footprints of a 4.8 x 2 m car every 0.2 m along a gentle curve
+std::vector<Box2d> MakeTrajectory(int num) {
+  std::vector<Box2d> boxes;
+  for (int i = 0; i < num; ++i) {
+    const double s = i * 0.2;
+    const double heading = 0.005 * s;
+    boxes.emplace_back(Box2d({100.0 * std::sin(heading),
+                              100.0 * (1 - std::cos(heading))},
+                             heading, 4.8, 2.0));
+  }
+  return boxes;
+}
+
+// obstacles scattered around the path, at least lateral_gap from it
+std::vector<Box2d> MakeObstacles(std::mt19937& rng, int num, double length,
+                                 double lateral_gap) {
+  std::uniform_real_distribution<double> s_dist(0, length);
+  std::uniform_real_distribution<double> l_dist(lateral_gap,
+                                                lateral_gap + 10.0);
+  std::uniform_real_distribution<double> heading(-M_PI, M_PI);
+  std::vector<Box2d> boxes;
+  for (int i = 0; i < num; ++i) {
+    const double s = s_dist(rng);
+    const double l = (i % 2 ? 1.0 : -1.0) * l_dist(rng);
+    const double path_heading = 0.005 * s;
+    boxes.emplace_back(
+        Box2d({100.0 * std::sin(path_heading) - l * std::sin(path_heading),
+               100.0 * (1 - std::cos(path_heading)) +
+                   l * std::cos(path_heading)},
+              heading(rng), 4.5, 1.9));
+  }
+  return boxes;
+}
+
+template <typename Func>
+double Measure(int rounds, int& result, Func func) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < rounds; ++i) {
+    result = func();
+  }
+  std::chrono::duration<double, std::micro> cost =
+      std::chrono::steady_clock::now() - start;
+  return cost.count() / rounds;
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937 rng(3);
+  const int kRounds = 200;
+  std::printf("%6s %10s %8s %16s %16s\n", "boxes", "obstacles", "hit",
+              "pairwise(us)", "batch(us)");
+  for (int box_num : {100, 300, 1000}) {
+    for (int obstacle_num : {10, 40, 100}) {
+      const auto trajectory = MakeTrajectory(box_num);
+      const double length = box_num * 0.2;
+      // near misses only, the whole trajectory has to be checked
+      auto obstacles = MakeObstacles(rng, obstacle_num, length, 3.5);
+      // and one blocking obstacle at 90% of the path
+      auto blocked = obstacles;
+      blocked.push_back(trajectory[box_num * 9 / 10]);
+      for (const auto* scene : {&obstacles, &blocked}) {
+        const Box2dBatch trajectory_batch(trajectory);
+        const Box2dBatch obstacle_batch(*scene);
+        int pairwise_hit = 0;
+        int batch_hit = 0;
+        const double pairwise = Measure(kRounds, pairwise_hit, [&]() {
+          return PairwiseFirstOverlap(trajectory, *scene);
+        });
+        const double batch = Measure(kRounds, batch_hit, [&]() {
+          return trajectory_batch.FirstOverlap(obstacle_batch);
+        });
+        std::printf("%6d %10zu %8d %16.2f %16.2f%s\n", box_num, scene->size(),
+                    batch_hit, pairwise, batch,
+                    pairwise_hit == batch_hit ? "" : "  MISMATCH");
+      }
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,141 @@
+// Customizable contraction hierarchy on a grid city: preprocessing once per
+// map against customizing new lane weights with one and several threads,
+// and the shortest route query against the Dijkstra search of the
+// alternative router on the same weights.
+#include <opendrive-engine/algo/route/alternative_router.h>
+#include <opendrive-engine/algo/route/customizable_router.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using opendrive::engine::geometry::Vec2d;
+using opendrive::engine::route::AlternativeRouter;
+using opendrive::engine::route::CustomizableRouteParam;
+using opendrive::engine::route::CustomizableRouter;
+using opendrive::engine::route::LaneGraph;
+using opendrive::engine::route::LaneGraphLane;
+using opendrive::engine::route::LaneGraphLanes;
+using opendrive::engine::route::LaneGraphParam;
+using opendrive::engine::route::Route;
+using opendrive::engine::route::Routes;
+
+namespace {
+
+template <typename Func>
+double Run(int rounds, Func func) {
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) func();
+  std::chrono::duration<double, std::micro> cost =
+      std::chrono::steady_clock::now() - start;
+  return cost.count() / rounds;
+}
+
+// streets between neighbouring crossings, two lanes each way
+LaneGraphLanes GridLanes(int size, double block) {
+  LaneGraphLanes lanes;
+  int section = 0;
+  auto add = [&](const std::string& id, int index, const Vec2d& a,
+                 const Vec2d& b) {
+    LaneGraphLane lane;
+    lane.id = id + "_" + std::to_string(index);
+    lane.section_id = id;
+    lane.index = index;
+    lane.length = a.DistanceTo(b);
+    lane.entry = a;
+    lane.exit = b;
+    lane.entry_heading = lane.exit_heading =
+        std::atan2(b.y() - a.y(), b.x() - a.x());
+    lanes.emplace_back(lane);
+  };
+  for (int i = 0; i < size; ++i) {
+    for (int j = 0; j < size; ++j) {
+      const Vec2d node(i * block, j * block);
+      if (i + 1 < size) {
+        const Vec2d next((i + 1) * block, j * block);
+        const std::string id = std::to_string(section++);
+        add(id, -1, node, next);
+        add(id, -2, node, next);
+        add(id, 1, next, node);
+        add(id, 2, next, node);
+      }
+      if (j + 1 < size) {
+        const Vec2d next(i * block, (j + 1) * block);
+        const std::string id = std::to_string(section++);
+        add(id, -1, node, next);
+        add(id, -2, node, next);
+        add(id, 1, next, node);
+        add(id, 2, next, node);
+      }
+    }
+  }
+  return lanes;
+}
+
+}  // namespace
+
+int main() {
+  std::printf("%6s %8s %10s %12s %12s %12s %10s %12s\n", "grid", "lanes",
+              "shortcuts", "init(ms)", "custom1(ms)", "custom4(ms)",
+              "cch(us)", "dijkstra(us)");
+  for (int size : {20, 40, 80}) {
+    LaneGraphParam graph_param;
+    graph_param.connect_heading = 2.0;
+    auto graph = std::make_shared<LaneGraph>();
+    graph->Init(GridLanes(size, 100.0), graph_param);
+    std::mt19937 rng(31);
+    std::uniform_real_distribution<double> factor(0.8, 1.5);
+    std::vector<std::vector<double>> metrics(4);
+    for (auto& weights : metrics) {
+      weights.resize(graph->num_lanes());
+      for (size_t i = 0; i < weights.size(); ++i) {
+        weights[i] =
+            graph->lane(static_cast<uint32_t>(i)).length * factor(rng);
+      }
+    }
+
+    CustomizableRouter router;
+    const double init = Run(1, [&]() { router.Init(graph); });
+    double customize[2];
+    const size_t threads[] = {1, 4};
+    for (int t = 0; t < 2; ++t) {
+      CustomizableRouteParam param;
+      param.max_threads = threads[t];
+      router.Init(graph, param);
+      size_t index = 0;
+      customize[t] = Run(static_cast<int>(metrics.size()), [&]() {
+        router.Customize(metrics[index++]);
+      });
+    }
+    AlternativeRouter dijkstra;
+    dijkstra.Init(graph);
+
+    std::uniform_int_distribution<uint32_t> lane(
+        0, static_cast<uint32_t>(graph->num_lanes() - 1));
+    std::vector<std::pair<uint32_t, uint32_t>> queries(200);
+    for (auto& query : queries) query = {lane(rng), lane(rng)};
+    const auto metric = router.metric();
+    size_t index = 0;
+    Route route;
+    const double cch = Run(static_cast<int>(queries.size()), [&]() {
+      const auto& query = queries[index++ % queries.size()];
+      router.Search(query.first, 0, query.second, 0, &route);
+    });
+    index = 0;
+    Routes routes;
+    const double plain = Run(static_cast<int>(queries.size()), [&]() {
+      const auto& query = queries[index++ % queries.size()];
+      dijkstra.Search(query.first, 0, query.second, 0, 1, metric->weights,
+                      &routes);
+    });
+
+    std::printf("%6d %8zu %10zu %12.1f %12.1f %12.1f %10.1f %12.1f\n", size,
+                graph->num_lanes(), router.num_shortcuts(), init / 1000,
+                customize[0] / 1000, customize[1] / 1000, cch, plain);
+  }
+  return 0;
+}
@@ -0,0 +1,137 @@
+// Distance to the nearest road edge at trajectory sample points, as a
+// trajectory optimizer asks for it every iteration: a SegmentBVH query with
+// an exact distance to every candidate edge, against DistanceField lookups
+// on cached tiles. The first pass of the field also builds its tiles.
+#include <opendrive-engine/algo/raster/distance_field.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using opendrive::engine::bvh::SegmentBVH;
+using opendrive::engine::bvh::SegmentIds;
+using opendrive::engine::bvh::SegmentIndices;
+using opendrive::engine::bvh::Segments;
+using opendrive::engine::geometry::AABox2d;
+using opendrive::engine::geometry::Vec2d;
+using opendrive::engine::raster::DistanceField;
+using opendrive::engine::raster::Polygon;
+using opendrive::engine::raster::Polygons;
+
+namespace {
+
+constexpr double kMaxDistance = 10.0;
+
+double BVHDistance(const SegmentBVH& bvh, const Vec2d& point,
+                   SegmentIndices* const candidates) {
+  bvh.Query(AABox2d(point, 2 * kMaxDistance, 2 * kMaxDistance), candidates);
+  double distance = kMaxDistance;
+  for (size_t index : *candidates) {
+    distance = std::min(distance, bvh.segment(index).DistanceTo(point));
+  }
+  return distance;
+}
+
+template <typename Func>
+double Run(int rounds, Func func) {
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) func();
+  std::chrono::duration<double, std::micro> cost =
+      std::chrono::steady_clock::now() - start;
+  return cost.count() / rounds;
+}
+
+}  // namespace
+
+int main() {
+  // a grid of straight 14 m wide roads, edges sampled at 0.5 m
+  const int roads = 16;
+  const double spacing = 40.0;
+  const double extent = spacing * roads / 2;
+  Segments segments;
+  SegmentIds ids;
+  Polygons areas;
+  for (int road = 0; road < roads; ++road) {
+    const bool vertical = road % 2;
+    const double at = spacing * (road / 2);
+    auto point = [&](double s, double offset) {
+      return vertical ? Vec2d(at + offset, s) : Vec2d(s, at + offset);
+    };
+    for (double offset : {0.0, 14.0}) {
+      for (double s = 0; s < extent; s += 0.5) {
+        segments.emplace_back(point(s, offset), point(s + 0.5, offset));
+        ids.emplace_back(std::to_string(road));
+      }
+    }
+    areas.push_back(Polygon{point(0, 0), point(extent, 0), point(extent, 14),
+                            point(0, 14)});
+  }
+  auto bvh = std::make_shared<SegmentBVH>();
+  bvh->Init(segments, ids);
+
+  // trajectories of 100 samples 0.5 m apart along random roads
+  std::mt19937 rng(17);
+  std::uniform_int_distribution<int> pick(0, roads - 1);
+  std::uniform_real_distribution<double> along(0, extent - 60);
+  std::uniform_real_distribution<double> across(1, 13);
+  std::vector<double> xs;
+  std::vector<double> ys;
+  for (int t = 0; t < 100; ++t) {
+    const int road = pick(rng);
+    const double s0 = along(rng);
+    const double offset = across(rng);
+    const double at = spacing * (road / 2);
+    for (int i = 0; i < 100; ++i) {
+      const double s = s0 + 0.5 * i;
+      xs.emplace_back(road % 2 ? at + offset : s);
+      ys.emplace_back(road % 2 ? s : at + offset);
+    }
+  }
+  const size_t size = xs.size();
+  std::vector<double> distance(size);
+  std::vector<double> gradient_x(size);
+  std::vector<double> gradient_y(size);
+
+  std::printf("%zu edge segments, %zu sample points\n", segments.size(),
+              size);
+  std::printf("%10s %14s %14s %14s %14s\n", "resolution", "bvh(ns/pt)",
+              "build(ns/pt)", "field(ns/pt)", "max error");
+  SegmentIndices candidates;
+  double bvh_sum = 0;
+  const double exact = Run(5, [&]() {
+    for (size_t i = 0; i < size; ++i) {
+      bvh_sum += BVHDistance(*bvh, {xs[i], ys[i]}, &candidates);
+    }
+  });
+  for (double resolution : {0.5, 0.2, 0.1}) {
+    opendrive::engine::raster::DistanceFieldParam param;
+    param.resolution = resolution;
+    param.max_distance = kMaxDistance;
+    DistanceField field;
+    field.Init(bvh, areas, param);
+    const double build = Run(1, [&]() {
+      field.Evaluate(xs.data(), ys.data(), size, distance.data(),
+                     gradient_x.data(), gradient_y.data());
+    });
+    const double lookup = Run(200, [&]() {
+      field.Evaluate(xs.data(), ys.data(), size, distance.data(),
+                     gradient_x.data(), gradient_y.data());
+    });
+    double error = 0;
+    for (size_t i = 0; i < size; ++i) {
+      error = std::max(error, std::abs(distance[i] - BVHDistance(
+                                                         *bvh, {xs[i], ys[i]},
+                                                         &candidates)));
+    }
+    std::printf("%10.1f %14.1f %14.1f %14.1f %14.3f\n", resolution,
+                1e3 * exact / size, 1e3 * build / size, 1e3 * lookup / size,
+                error);
+  }
+  std::printf("checksum %.3f\n", bvh_sum);
+  return 0;
+}
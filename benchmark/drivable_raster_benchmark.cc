@@ -0,0 +1,104 @@
+// Drivable-area occupancy grid around a moving vehicle: rasterizing the
+// whole window on every cycle, against a DrivableRaster whose tile cache
+// only rasterizes the tiles newly exposed as the window rolls forward.
+#include <opendrive-engine/algo/raster/drivable_raster.h>
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using opendrive::engine::geometry::AABox2d;
+using opendrive::engine::geometry::Vec2d;
+using opendrive::engine::raster::DrivableGrid;
+using opendrive::engine::raster::DrivableRaster;
+using opendrive::engine::raster::DrivableRasterParam;
+using opendrive::engine::raster::Polygon;
+using opendrive::engine::raster::Polygons;
+
+namespace {
+
+constexpr double kWindow = 100.0;  // window side length in meters
+constexpr double kStep = 1.0;      // vehicle motion per cycle
+constexpr int kCycles = 200;
+
+// a grid of straight roads, four 3.5 m lanes each, split into 20 m pieces
+// with a slight curvature so edges are not axis aligned
+Polygons RoadGrid(int roads, double spacing, double extent) {
+  Polygons polygons;
+  for (int road = 0; road < roads; ++road) {
+    const bool vertical = road % 2;
+    const double at = spacing * (road / 2);
+    for (int lane = 0; lane < 4; ++lane) {
+      const double left = at + 3.5 * lane;
+      const double right = left + 3.5;
+      for (double s = 0; s < extent; s += 20.0) {
+        Polygon polygon;
+        for (double t = s; t <= s + 20.0; t += 2.0) {
+          const double bend = 0.01 * (t - s) * (s + 20.0 - t) / 20.0;
+          polygon.emplace_back(t, left + bend);
+        }
+        for (double t = s + 20.0; t >= s; t -= 2.0) {
+          const double bend = 0.01 * (t - s) * (s + 20.0 - t) / 20.0;
+          polygon.emplace_back(t, right + bend);
+        }
+        if (vertical) {
+          for (auto& point : polygon) point = Vec2d(point.y(), point.x());
+        }
+        polygons.emplace_back(polygon);
+      }
+    }
+  }
+  return polygons;
+}
+
+template <typename Func>
+double Run(double resolution, size_t& checksum, Func func) {
+  DrivableGrid grid;
+  auto start = std::chrono::steady_clock::now();
+  for (int cycle = 0; cycle < kCycles; ++cycle) {
+    const double x = 50.0 + cycle * kStep;
+    const double y = 30.0 + cycle * kStep * 0.5;
+    func(AABox2d({x, y}, {x + kWindow, y + kWindow}), resolution, &grid);
+    for (uint8_t cell : grid.cells) checksum += cell;
+  }
+  std::chrono::duration<double, std::micro> cost =
+      std::chrono::steady_clock::now() - start;
+  return cost.count() / kCycles;
+}
+
+}  // namespace
+
+int main() {
+  const Polygons polygons = RoadGrid(16, 40.0, 400.0);
+  std::printf("%zu lane polygons, %.0f m window moving %.1f m per cycle\n",
+              polygons.size(), kWindow, kStep);
+  std::printf("%10s %16s %16s %16s\n", "resolution", "fresh(us/cycle)",
+              "cached(us/cycle)", "checksum diff");
+  for (double resolution : {0.5, 0.2, 0.1}) {
+    size_t fresh_sum = 0;
+    size_t cached_sum = 0;
+    DrivableRasterParam param;
+    param.max_threads = 1;
+    // without a cache every cycle rasterizes all tiles of the window
+    param.max_cached_tiles = 0;
+    DrivableRaster uncached;
+    uncached.Init(polygons, param);
+    const double fresh =
+        Run(resolution, fresh_sum,
+            [&](const AABox2d& window, double res, DrivableGrid* grid) {
+              uncached.Rasterize(window, res, grid);
+            });
+    param.max_cached_tiles = DrivableRasterParam().max_cached_tiles;
+    DrivableRaster rolling;
+    rolling.Init(polygons, param);
+    const double cached =
+        Run(resolution, cached_sum,
+            [&](const AABox2d& window, double res, DrivableGrid* grid) {
+              rolling.Rasterize(window, res, grid);
+            });
+    std::printf("%10.1f %16.1f %16.1f %16zu\n", resolution, fresh, cached,
+                fresh_sum > cached_sum ? fresh_sum - cached_sum
+                                       : cached_sum - fresh_sum);
+  }
+  return 0;
+}
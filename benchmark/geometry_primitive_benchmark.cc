@@ -0,0 +1,110 @@
+// Loops over the geometry primitives from user code: polyline projection
+// through LineSegment2d, polygon to point distance and plain Vec2d math.
+#include <opendrive-engine/geometry/line_segment2d.h>
+#include <opendrive-engine/geometry/polygon2d.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <vector>
+
+using opendrive::engine::geometry::LineSegment2d;
+using opendrive::engine::geometry::Polygon2d;
+using opendrive::engine::geometry::Vec2d;
+
+namespace {
+
+template <typename Func>
+double Run(int rounds, size_t items, Func func) {
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) func();
+  std::chrono::duration<double, std::nano> cost =
+      std::chrono::steady_clock::now() - start;
+  return cost.count() / (rounds * items);
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937 rng(5);
+  std::uniform_real_distribution<double> jitter(-0.2, 0.2);
+  std::uniform_real_distribution<double> position(-50, 50);
+
+  // a wavy 1 km polyline sampled every 0.5 m
+  std::vector<LineSegment2d> polyline;
+  Vec2d last(0, 0);
+  for (int i = 1; i <= 2000; ++i) {
+    const Vec2d next(0.5 * i, 10.0 * std::sin(0.01 * i) + jitter(rng));
+    polyline.emplace_back(last, next);
+    last = next;
+  }
+  std::vector<Vec2d> points;
+  for (int i = 0; i < 1000; ++i) {
+    points.emplace_back(500 + 10 * position(rng), position(rng));
+  }
+  double checksum = 0;
+
+  const double projection = Run(5, points.size() * polyline.size(), [&] {
+    for (const auto& point : points) {
+      double best = std::numeric_limits<double>::max();
+      for (const auto& segment : polyline) {
+        const double sqr = segment.DistanceSquareTo(point);
+        best = sqr < best ? sqr : best;
+      }
+      checksum += best;
+    }
+  });
+
+  // segment-major through the __restrict batch kernel
+  std::vector<double> xs;
+  std::vector<double> ys;
+  for (const auto& point : points) {
+    xs.push_back(point.x());
+    ys.push_back(point.y());
+  }
+  std::vector<double> best(points.size());
+  std::vector<double> sqr(points.size());
+  const double batch_projection = Run(5, points.size() * polyline.size(), [&] {
+    std::fill(best.begin(), best.end(), std::numeric_limits<double>::max());
+    for (const auto& segment : polyline) {
+      segment.DistanceSquareTo(xs.data(), ys.data(), xs.size(), sqr.data());
+      for (size_t i = 0; i < best.size(); ++i) {
+        best[i] = sqr[i] < best[i] ? sqr[i] : best[i];
+      }
+    }
+    for (double value : best) checksum += value;
+  });
+
+  std::vector<Vec2d> ring;
+  for (int i = 0; i < 32; ++i) {
+    ring.emplace_back(20 * std::cos(2 * M_PI * i / 32),
+                      20 * std::sin(2 * M_PI * i / 32));
+  }
+  const Polygon2d polygon(ring);
+  const double polygon_distance = Run(20, points.size() * 32, [&] {
+    for (const auto& point : points) {
+      checksum += polygon.DistanceTo(point - Vec2d(500, 0));
+    }
+  });
+
+  const double vec2d = Run(2000, points.size(), [&] {
+    Vec2d sum(0, 0);
+    for (const auto& point : points) {
+      sum += (point - Vec2d(500, 0)) * 0.5;
+      checksum += sum.CrossProd(point) + point.DistanceSquareTo(sum);
+    }
+  });
+
+  std::printf("%-40s %10.2f ns\n", "projection, per point and segment",
+              projection);
+  std::printf("%-40s %10.2f ns\n", "batch projection, per point and segment",
+              batch_projection);
+  std::printf("%-40s %10.2f ns\n", "polygon distance, per point and edge",
+              polygon_distance);
+  std::printf("%-40s %10.2f ns\n", "vec2d arithmetic, per point", vec2d);
+  std::printf("checksum %.3f\n", checksum);
+  return 0;
+}
@@ -0,0 +1,148 @@
+// KDTree build and nearest sample queries with one index over all samples
+// against spatial shards built on several threads and queried as a forest,
+// then recall and latency of approximate queries for a few eps and cutoffs,
+// and 10k point batches searched one by one against the morton sorted batch.
+#include <opendrive-engine/algo/kdtree/kdtree.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+using opendrive::engine::kdtree::KDTree;
+using opendrive::engine::kdtree::KDTreeParam;
+using opendrive::engine::kdtree::SamplePoint;
+using opendrive::engine::kdtree::SamplePoints;
+using opendrive::engine::kdtree::SearchParam;
+using opendrive::engine::kdtree::SearchResults;
+
+namespace {
+
+template <typename Func>
+double Run(int rounds, Func func) {
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) func();
+  std::chrono::duration<double, std::micro> cost =
+      std::chrono::steady_clock::now() - start;
+  return cost.count() / rounds;
+}
+
+// samples along random straight lanes, 0.5 m apart like the convertor's
+SamplePoints MakeSamples(int size, std::mt19937* const rng) {
+  std::uniform_real_distribution<double> position(0, 5000);
+  std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+  SamplePoints samples;
+  while (static_cast<int>(samples.size()) < size) {
+    double x = position(*rng);
+    double y = position(*rng);
+    const double heading = angle(*rng);
+    for (int i = 0; i < 200 && static_cast<int>(samples.size()) < size; ++i) {
+      SamplePoint point(x, y);
+      point.mutable_id() = std::to_string(samples.size());
+      samples.emplace_back(point);
+      x += 0.5 * std::cos(heading);
+      y += 0.5 * std::sin(heading);
+    }
+  }
+  return samples;
+}
+
+}  // namespace
+
+int main() {
+  std::printf("%10s %12s %8s %12s %12s\n", "samples", "shard_size", "shards",
+              "build(ms)", "query(us)");
+  std::mt19937 rng(5);
+  std::uniform_real_distribution<double> position(0, 5000);
+  std::vector<std::pair<double, double>> queries;
+  for (int i = 0; i < 10000; ++i) {
+    queries.emplace_back(position(rng), position(rng));
+  }
+  for (int size : {100000, 1000000}) {
+    const SamplePoints samples = MakeSamples(size, &rng);
+    for (size_t shard_size : {size_t(size), size_t(1) << 16, size_t(1) << 14}) {
+      KDTreeParam param;
+      param.max_shard_size = shard_size;
+      param.max_threads = 4;
+      KDTree kdtree;
+      const double build = Run(3, [&]() { kdtree.Init(samples, param); });
+      const double query = Run(1, [&]() {
+                             for (const auto& q : queries) {
+                               kdtree.Query(q.first, q.second, 5);
+                             }
+                           }) /
+                           queries.size();
+      std::printf("%10d %12zu %8zu %12.2f %12.3f\n", size, shard_size,
+                  kdtree.num_shards(), build / 1e3, query);
+    }
+  }
+
+  // recall@k: the share of the exact k nearest samples also returned
+  const size_t k = 10;
+  const SamplePoints samples = MakeSamples(1000000, &rng);
+  KDTree kdtree;
+  kdtree.Init(samples);
+  std::vector<SearchResults> exact;
+  const double exact_time = Run(1, [&]() {
+                              exact.clear();
+                              for (const auto& q : queries) {
+                                exact.emplace_back(
+                                    kdtree.Query(q.first, q.second, k));
+                              }
+                            }) /
+                            queries.size();
+  std::printf("\n%8s %14s %12s %10s\n", "eps", "max_distance", "query(us)",
+              "recall");
+  std::printf("%8.2f %14s %12.3f %10.4f\n", 0.0, "inf", exact_time, 1.0);
+  for (double max_distance : {std::numeric_limits<double>::infinity(), 20.0}) {
+    for (double eps : {0.1, 0.5, 1.0, 2.0}) {
+      SearchParam param;
+      param.eps = eps;
+      param.max_distance = max_distance;
+      std::vector<SearchResults> approximate;
+      const double time = Run(1, [&]() {
+                            for (const auto& q : queries) {
+                              approximate.emplace_back(
+                                  kdtree.Query(q.first, q.second, k, param));
+                            }
+                          }) /
+                          queries.size();
+      size_t hits = 0;
+      size_t total = 0;
+      for (size_t i = 0; i < queries.size(); ++i) {
+        std::set<std::string> ids;
+        for (const auto& result : approximate[i]) ids.insert(result.id);
+        for (const auto& result : exact[i]) {
+          // the cutoff drops samples on purpose, they do not count
+          if (result.dist > max_distance) continue;
+          ++total;
+          hits += ids.count(result.id);
+        }
+      }
+      std::printf("%8.2f %14.1f %12.3f %10.4f\n", eps, max_distance, time,
+                  total ? static_cast<double>(hits) / total : 1.0);
+    }
+  }
+
+  // the points arrive in arbitrary order, like objects sorted by id
+  std::printf("\n%10s %14s %14s\n", "batch", "single(us)", "sorted(us)");
+  std::vector<SamplePoint> batch;
+  for (int i = 0; i < 10000; ++i) {
+    batch.emplace_back(position(rng), position(rng));
+  }
+  const double single = Run(5, [&]() {
+                          for (const auto& point : batch) {
+                            kdtree.Query(point, k);
+                          }
+                        }) /
+                        batch.size();
+  const double sorted =
+      Run(5, [&]() { kdtree.Query(batch, k); }) / batch.size();
+  std::printf("%10zu %14.3f %14.3f\n", batch.size(), single, sorted);
+  return 0;
+}
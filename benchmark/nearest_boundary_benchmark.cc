@@ -0,0 +1,111 @@
+// Nearest lane boundary along trajectories: a linear scan over every
+// boundary segment, SegmentBVH::Nearest without a bound, and Nearest bounded
+// by the distance to the previous sample's answer as the engine's batched
+// GetNearestBoundary does.
+#include <opendrive-engine/algo/bvh/segment_bvh.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using opendrive::engine::bvh::SegmentBVH;
+using opendrive::engine::bvh::SegmentIds;
+using opendrive::engine::bvh::Segments;
+using opendrive::engine::geometry::Vec2d;
+
+namespace {
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+template <typename Func>
+double Run(const std::vector<Vec2d>& points, int rounds, double& checksum,
+           Func func) {
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    int previous = -1;
+    for (const auto& point : points) checksum += func(point, &previous);
+  }
+  std::chrono::duration<double, std::nano> cost =
+      std::chrono::steady_clock::now() - start;
+  return cost.count() / (rounds * points.size());
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937 rng(7);
+  std::printf("%10s %14s %14s %14s %14s\n", "segments", "scan(ns/pt)",
+              "bvh(ns/pt)", "bounded(ns/pt)", "checksum diff");
+  for (int roads : {4, 8, 16, 32}) {
+    // a grid of straight roads, four lanes each, boundaries sampled at 0.5 m
+    const double spacing = 40.0;
+    const double extent = spacing * roads / 4;
+    Segments segments;
+    SegmentIds ids;
+    for (int road = 0; road < roads; ++road) {
+      const bool vertical = road % 2;
+      const double at = spacing * (road / 2);
+      for (int boundary = 0; boundary <= 4; ++boundary) {
+        const double offset = at + 3.5 * boundary;
+        for (double s = 0; s < extent; s += 0.5) {
+          const Vec2d start = vertical ? Vec2d(offset, s) : Vec2d(s, offset);
+          const Vec2d end =
+              vertical ? Vec2d(offset, s + 0.5) : Vec2d(s + 0.5, offset);
+          segments.emplace_back(start, end);
+          ids.emplace_back(std::to_string(road));
+        }
+      }
+    }
+    SegmentBVH bvh;
+    bvh.Init(segments, ids);
+    // trajectories sampled every 0.2 m with a slight lateral drift
+    std::uniform_real_distribution<double> position(0, extent);
+    std::vector<Vec2d> points;
+    for (int t = 0; t < 10; ++t) {
+      Vec2d point(position(rng), position(rng));
+      for (int i = 0; i < 200; ++i) {
+        points.emplace_back(point);
+        point += Vec2d(0.2, 0.01);
+      }
+    }
+    const int rounds = std::max(1, 200000 / static_cast<int>(segments.size()));
+    double scan_sum = 0;
+    double bvh_sum = 0;
+    double bounded_sum = 0;
+    const double scan = Run(points, rounds, scan_sum,
+                            [&](const Vec2d& point, int* const) {
+                              double distance = kInfinity;
+                              for (const auto& segment : segments) {
+                                distance = std::min(
+                                    distance, segment.DistanceTo(point));
+                              }
+                              return distance;
+                            });
+    const double tree = Run(points, rounds, bvh_sum,
+                            [&](const Vec2d& point, int* const) {
+                              double distance = 0;
+                              bvh.Nearest(point, kInfinity, &distance);
+                              return distance;
+                            });
+    const double bounded =
+        Run(points, rounds, bounded_sum,
+            [&](const Vec2d& point, int* const previous) {
+              const double bound =
+                  *previous < 0 ? kInfinity
+                                : std::sqrt(bvh.segment(*previous)
+                                                .DistanceSquareTo(point));
+              double distance = 0;
+              *previous = bvh.Nearest(point, bound, &distance);
+              return distance;
+            });
+    const double diff =
+        std::abs(scan_sum - bvh_sum) + std::abs(scan_sum - bounded_sum);
+    std::printf("%10zu %14.1f %14.1f %14.1f %14.2e\n", segments.size(), scan,
+                tree, bounded, diff);
+  }
+  return 0;
+}
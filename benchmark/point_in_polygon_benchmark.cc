@@ -0,0 +1,95 @@
+// Many points against one road-sized polygon: per-point IsPointIn /
+// DistanceTo against the batched Vec2dBatch kernels.
+#include <opendrive-engine/geometry/polygon2d.h>
+#include <opendrive-engine/geometry/vec2d_batch.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using opendrive::engine::geometry::Polygon2d;
+using opendrive::engine::geometry::Vec2d;
+using opendrive::engine::geometry::Vec2dBatch;
+
+namespace {
+
+// a curved road corridor, 3.5 m wide, sampled every 0.5 m on both sides
+Polygon2d MakeRoad(int samples) {
+  std::vector<Vec2d> left;
+  std::vector<Vec2d> right;
+  for (int i = 0; i < samples; ++i) {
+    const double s = i * 0.5;
+    const double heading = 0.01 * s;
+    const Vec2d center(50.0 * std::sin(heading),
+                       50.0 * (1 - std::cos(heading)));
+    const Vec2d normal(-std::sin(heading), std::cos(heading));
+    left.emplace_back(center + normal * 1.75);
+    right.emplace_back(center - normal * 1.75);
+  }
+  left.insert(left.end(), right.rbegin(), right.rend());
+  return Polygon2d(left);
+}
+
+double Elapsed(std::chrono::steady_clock::time_point start) {
+  std::chrono::duration<double, std::milli> cost =
+      std::chrono::steady_clock::now() - start;
+  return cost.count();
+}
+
+}  // namespace
+
+int main() {
+  const size_t kPointNum = 100000;
+  std::mt19937 rng(11);
+  std::uniform_real_distribution<double> x_dist(-5, 60);
+  std::uniform_real_distribution<double> y_dist(-5, 20);
+  std::printf("%8s %14s %14s %14s %14s\n", "edges", "point in(ms)",
+              "batch in(ms)", "point dist(ms)", "batch dist(ms)");
+  for (int samples : {8, 32, 128}) {
+    const Polygon2d road = MakeRoad(samples);
+    std::vector<Vec2d> points;
+    Vec2dBatch batch;
+    for (size_t i = 0; i < kPointNum; ++i) {
+      points.emplace_back(x_dist(rng), y_dist(rng));
+      batch.push_back(points.back());
+    }
+    size_t inside_count = 0;
+    double distance_sum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& point : points) {
+      inside_count += road.IsPointIn(point);
+    }
+    const double point_in = Elapsed(start);
+
+    std::vector<uint8_t> inside;
+    start = std::chrono::steady_clock::now();
+    road.IsPointIn(batch, &inside);
+    const double batch_in = Elapsed(start);
+    for (auto flag : inside) {
+      inside_count -= flag;
+    }
+
+    start = std::chrono::steady_clock::now();
+    for (const auto& point : points) {
+      distance_sum += road.DistanceTo(point);
+    }
+    const double point_dist = Elapsed(start);
+
+    std::vector<double> distances;
+    start = std::chrono::steady_clock::now();
+    road.DistanceTo(batch, &distances);
+    const double batch_dist = Elapsed(start);
+    for (double distance : distances) {
+      distance_sum -= distance;
+    }
+
+    std::printf("%8d %14.2f %14.2f %14.2f %14.2f  (diff %zu %.3g)\n",
+                road.num_points(), point_in, batch_in, point_dist, batch_dist,
+                inside_count, distance_sum);
+  }
+  return 0;
+}
@@ -0,0 +1,91 @@
+// Polygon2d distance / overlap between convex polygons: GJK against the
+// per-edge loop that is still used for non-convex polygons.
+#include <opendrive-engine/geometry/polygon2d.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+using opendrive::engine::geometry::Polygon2d;
+using opendrive::engine::geometry::Vec2d;
+
+namespace {
+
+double EdgeDistance(const Polygon2d& lhs, const Polygon2d& rhs) {
+  if (lhs.IsPointIn(rhs.points()[0]) || rhs.IsPointIn(lhs.points()[0])) {
+    return 0.0;
+  }
+  double distance = std::numeric_limits<double>::infinity();
+  for (const auto& segment : lhs.line_segments()) {
+    distance = std::min(distance, rhs.DistanceTo(segment));
+  }
+  return distance;
+}
+
+double GjkDistance(const Polygon2d& lhs, const Polygon2d& rhs) {
+  return lhs.DistanceTo(rhs);
+}
+
+double EdgeOverlap(const Polygon2d& lhs, const Polygon2d& rhs) {
+  return EdgeDistance(lhs, rhs) <= 1e-10 ? 1.0 : 0.0;
+}
+
+double GjkOverlap(const Polygon2d& lhs, const Polygon2d& rhs) {
+  return lhs.HasOverlap(rhs) ? 1.0 : 0.0;
+}
+
+// regular polygon with jittered radius, convex by construction
+Polygon2d MakeConvex(std::mt19937& rng, int n, double cx, double cy) {
+  std::uniform_real_distribution<double> jitter(0.0, 0.5 / n);
+  std::vector<Vec2d> points;
+  for (int i = 0; i < n; ++i) {
+    const double angle = 2.0 * M_PI * (i + jitter(rng)) / n;
+    points.emplace_back(cx + 2.0 * std::cos(angle),
+                        cy + 2.0 * std::sin(angle));
+  }
+  return Polygon2d(points);
+}
+
+template <typename Func>
+double Run(const std::vector<std::pair<Polygon2d, Polygon2d>>& pairs,
+           int rounds, double& checksum, Func func) {
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    for (const auto& pair : pairs) {
+      checksum += func(pair.first, pair.second);
+    }
+  }
+  std::chrono::duration<double, std::nano> cost =
+      std::chrono::steady_clock::now() - start;
+  return cost.count() / (rounds * pairs.size());
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<double> offset(-6, 6);
+  std::printf("%8s %14s %14s %14s %14s\n", "points", "edge dist(ns)",
+              "gjk dist(ns)", "edge ovl(ns)", "gjk ovl(ns)");
+  for (int n : {4, 8, 16, 32, 64, 128}) {
+    std::vector<std::pair<Polygon2d, Polygon2d>> pairs;
+    for (int i = 0; i < 1000; ++i) {
+      pairs.emplace_back(MakeConvex(rng, n, 0, 0),
+                         MakeConvex(rng, n, offset(rng), offset(rng)));
+    }
+    const int rounds = std::max(1, 2048 / n);
+    double checksum = 0;
+    const double edge_dist = Run(pairs, rounds, checksum, EdgeDistance);
+    const double gjk_dist = Run(pairs, rounds, checksum, GjkDistance);
+    const double edge_overlap = Run(pairs, rounds, checksum, EdgeOverlap);
+    const double gjk_overlap = Run(pairs, rounds, checksum, GjkOverlap);
+    std::printf("%8d %14.1f %14.1f %14.1f %14.1f  (checksum %.3f)\n", n,
+                edge_dist, gjk_dist, edge_overlap, gjk_overlap, checksum);
+  }
+  return 0;
+}
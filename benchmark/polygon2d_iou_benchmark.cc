@@ -0,0 +1,107 @@
+// Polygon2d::ComputeIoU between convex polygons against clipping through a
+// std::vector per edge and building the overlap Polygon2d, as it used to.
+#include <opendrive-engine/geometry/polygon2d.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+using opendrive::engine::geometry::Polygon2d;
+using opendrive::engine::geometry::Vec2d;
+
+namespace {
+
+bool VectorClip(const Vec2d& start, const Vec2d& end,
+                std::vector<Vec2d>* const points) {
+  const size_t n = points->size();
+  std::vector<double> prod(n);
+  std::vector<int> side(n);
+  for (size_t i = 0; i < n; ++i) {
+    prod[i] = Vec2d::CrossProd(start, end, (*points)[i]);
+    side[i] = std::abs(prod[i]) <= 1e-10 ? 0 : (prod[i] < 0 ? -1 : 1);
+  }
+  std::vector<Vec2d> new_points;
+  for (size_t i = 0; i < n; ++i) {
+    if (side[i] >= 0) new_points.push_back((*points)[i]);
+    const size_t j = i == n - 1 ? 0 : i + 1;
+    if (side[i] * side[j] < 0) {
+      const double ratio = prod[j] / (prod[j] - prod[i]);
+      new_points.emplace_back(
+          (*points)[i].x() * ratio + (*points)[j].x() * (1.0 - ratio),
+          (*points)[i].y() * ratio + (*points)[j].y() * (1.0 - ratio));
+    }
+  }
+  points->swap(new_points);
+  return points->size() >= 3;
+}
+
+double VectorIoU(const Polygon2d& lhs, const Polygon2d& rhs) {
+  std::vector<Vec2d> points = rhs.points();
+  for (const auto& segment : lhs.line_segments()) {
+    if (!VectorClip(segment.start(), segment.end(), &points)) return 0.0;
+  }
+  Polygon2d overlap;
+  if (!Polygon2d::ComputeConvexHull(points, &overlap)) return 0.0;
+  return overlap.area() / (lhs.area() + rhs.area() - overlap.area());
+}
+
+double StackIoU(const Polygon2d& lhs, const Polygon2d& rhs) {
+  return lhs.ComputeIoU(rhs);
+}
+
+// regular polygon with jittered radius, convex by construction
+Polygon2d MakeConvex(std::mt19937& rng, int n, double cx, double cy) {
+  std::uniform_real_distribution<double> jitter(0.0, 0.5 / n);
+  std::uniform_real_distribution<double> phase(0.0, 2.0 * M_PI);
+  const double start = phase(rng);
+  std::vector<Vec2d> points;
+  for (int i = 0; i < n; ++i) {
+    const double angle = start + 2.0 * M_PI * (i + jitter(rng)) / n;
+    points.emplace_back(cx + 2.0 * std::cos(angle),
+                        cy + 2.0 * std::sin(angle));
+  }
+  return Polygon2d(points);
+}
+
+template <typename Func>
+double Run(const std::vector<std::pair<Polygon2d, Polygon2d>>& pairs,
+           int rounds, double& checksum, Func func) {
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    for (const auto& pair : pairs) {
+      checksum += func(pair.first, pair.second);
+    }
+  }
+  std::chrono::duration<double, std::nano> cost =
+      std::chrono::steady_clock::now() - start;
+  return cost.count() / (rounds * pairs.size());
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937 rng(7);
+  // detection / track pairs: mostly overlapping, some far apart
+  std::uniform_real_distribution<double> offset(-3, 3);
+  std::printf("%8s %14s %14s %14s\n", "points", "vector(ns)", "stack(ns)",
+              "checksum diff");
+  for (int n : {4, 8, 16, 32}) {
+    std::vector<std::pair<Polygon2d, Polygon2d>> pairs;
+    for (int i = 0; i < 1000; ++i) {
+      pairs.emplace_back(MakeConvex(rng, n, 0, 0),
+                         MakeConvex(rng, n, offset(rng), offset(rng)));
+    }
+    const int rounds = std::max(1, 1024 / n);
+    double vector_sum = 0;
+    double stack_sum = 0;
+    const double vector_cost = Run(pairs, rounds, vector_sum, VectorIoU);
+    const double stack_cost = Run(pairs, rounds, stack_sum, StackIoU);
+    std::printf("%8d %14.1f %14.1f %14.2e\n", n, vector_cost, stack_cost,
+                std::abs(vector_sum - stack_sum));
+  }
+  return 0;
+}
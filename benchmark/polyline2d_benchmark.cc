@@ -0,0 +1,88 @@
+// Point projection onto a lane-like polyline: linear scan over the segments,
+// as common::ProjectOntoCurve did, against the Polyline2d box hierarchy.
+#include <opendrive-engine/geometry/line_segment2d.h>
+#include <opendrive-engine/geometry/polyline2d.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <vector>
+
+using opendrive::engine::geometry::LineSegment2d;
+using opendrive::engine::geometry::Polyline2d;
+using opendrive::engine::geometry::Vec2d;
+
+namespace {
+
+double ScanProjection(const std::vector<LineSegment2d>& segments,
+                      const Vec2d& point) {
+  double min_dist_sqr = std::numeric_limits<double>::max();
+  double accumulate_s = 0;
+  double s = 0;
+  for (const auto& segment : segments) {
+    const double dist_sqr = segment.DistanceSquareTo(point);
+    if (dist_sqr < min_dist_sqr) {
+      min_dist_sqr = dist_sqr;
+      const double proj = segment.ProjectOntoUnit(point);
+      s = accumulate_s + std::max(0.0, std::min(segment.length(), proj));
+    }
+    accumulate_s += segment.length();
+  }
+  return s;
+}
+
+template <typename Func>
+double Run(const std::vector<Vec2d>& points, int rounds, double& checksum,
+           Func func) {
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    for (const auto& point : points) checksum += func(point);
+  }
+  std::chrono::duration<double, std::nano> cost =
+      std::chrono::steady_clock::now() - start;
+  return cost.count() / (rounds * points.size());
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937 rng(3);
+  std::printf("%10s %14s %14s %14s\n", "segments", "scan(ns)", "polyline(ns)",
+              "checksum diff");
+  for (int n : {50, 200, 1000, 5000, 20000}) {
+    // 0.5 m sampling as the convertor does, points within a few lanes
+    std::vector<Vec2d> vertices;
+    for (int i = 0; i <= n; ++i) {
+      vertices.emplace_back(0.5 * i, 30.0 * std::sin(0.002 * i));
+    }
+    std::vector<LineSegment2d> segments;
+    for (int i = 0; i < n; ++i) {
+      segments.emplace_back(vertices[i], vertices[i + 1]);
+    }
+    const Polyline2d polyline(vertices);
+    std::uniform_real_distribution<double> s(0, 0.5 * n);
+    std::uniform_real_distribution<double> l(-8, 8);
+    std::vector<Vec2d> points;
+    for (int i = 0; i < 1000; ++i) {
+      const double at = s(rng);
+      points.emplace_back(at, 30.0 * std::sin(0.004 * at) + l(rng));
+    }
+    const int rounds = std::max(1, 20000 / n);
+    double scan_sum = 0;
+    double polyline_sum = 0;
+    const double scan = Run(points, rounds, scan_sum, [&](const Vec2d& p) {
+      return ScanProjection(segments, p);
+    });
+    const double tree = Run(points, rounds, polyline_sum, [&](const Vec2d& p) {
+      double accumulate_s = 0;
+      double lateral = 0;
+      polyline.GetProjection(p, &accumulate_s, &lateral);
+      return accumulate_s;
+    });
+    std::printf("%10d %14.1f %14.1f %14.2e\n", n, scan, tree,
+                std::abs(scan_sum - polyline_sum) / rounds);
+  }
+  return 0;
+}
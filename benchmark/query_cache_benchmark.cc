@@ -0,0 +1,106 @@
+// Repeated nearest sample queries from a few parked positions: KDTree
+// search every time against a QueryCache hit, plus the cost of a miss.
+#include <opendrive-engine/algo/kdtree/kdtree.h>
+#include <opendrive-engine/common/query_cache.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using opendrive::engine::common::QueryCache;
+using opendrive::engine::common::QueryCacheKey;
+using opendrive::engine::kdtree::KDTree;
+using opendrive::engine::kdtree::SamplePoint;
+using opendrive::engine::kdtree::SamplePoints;
+
+namespace {
+
+template <typename Func>
+double Run(int rounds, Func func) {
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) func();
+  std::chrono::duration<double, std::micro> cost =
+      std::chrono::steady_clock::now() - start;
+  return cost.count() / rounds;
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<double> position(0, 3000);
+  SamplePoints samples;
+  for (int i = 0; i < 200000; ++i) {
+    SamplePoint point(position(rng), position(rng));
+    point.mutable_id() = std::to_string(i);
+    samples.emplace_back(point);
+  }
+  KDTree kdtree;
+  kdtree.Init(samples);
+  // 64 parked agents jittering by a few centimeters around their spot
+  std::vector<std::pair<double, double>> agents;
+  for (int i = 0; i < 64; ++i) {
+    agents.emplace_back(position(rng), position(rng));
+  }
+  std::normal_distribution<double> jitter(0, 0.02);
+  std::vector<std::pair<double, double>> queries;
+  for (int i = 0; i < 20000; ++i) {
+    const auto& agent = agents[i % agents.size()];
+    queries.emplace_back(agent.first + jitter(rng), agent.second + jitter(rng));
+  }
+
+  const double resolution = 0.5;
+  auto key_of = [resolution](double x, double y) {
+    QueryCacheKey key;
+    key.x = static_cast<int64_t>(std::floor(x / resolution));
+    key.y = static_cast<int64_t>(std::floor(y / resolution));
+    key.k = 5;
+    key.eps = 0;
+    key.max_distance = 0;
+    return key;
+  };
+  QueryCache cache;
+  cache.Init(1 << 14);
+  uint32_t values[QueryCache::kMaxValues];
+  size_t count = 0;
+  size_t hits = 0;
+  const double search = Run(1, [&]() {
+                          for (const auto& q : queries) {
+                            kdtree.Query(q.first, q.second, 5);
+                          }
+                        }) /
+                        queries.size();
+  const double cached = Run(1, [&]() {
+                          for (const auto& q : queries) {
+                            const QueryCacheKey key = key_of(q.first, q.second);
+                            if (cache.Lookup(key, 1, values, &count)) {
+                              ++hits;
+                              continue;
+                            }
+                            auto results = kdtree.Query(q.first, q.second, 5);
+                            for (size_t i = 0; i < results.size(); ++i) {
+                              values[i] = static_cast<uint32_t>(
+                                  std::stoul(results[i].id));
+                            }
+                            cache.Insert(key, 1, values, results.size());
+                          }
+                        }) /
+                        queries.size();
+  const double miss = Run(1, [&]() {
+                        for (const auto& q : queries) {
+                          cache.Lookup(key_of(q.first, q.second), 2, values,
+                                       &count);
+                        }
+                      }) /
+                      queries.size();
+  std::printf("%14s %14s %14s %10s\n", "search(us)", "cached(us)",
+              "miss(us)", "hit_rate");
+  std::printf("%14.3f %14.3f %14.4f %10.4f\n", search, cached, miss,
+              static_cast<double>(hits) / queries.size());
+  return 0;
+}
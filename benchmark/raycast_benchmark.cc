@@ -0,0 +1,109 @@
+// Lidar style ray casting against lane boundaries: intersecting every
+// segment with LineSegment2d::GetIntersect, against SegmentBVH::Raycast.
+#include <opendrive-engine/algo/bvh/segment_bvh.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using opendrive::engine::bvh::SegmentBVH;
+using opendrive::engine::bvh::SegmentIds;
+using opendrive::engine::bvh::Segments;
+using opendrive::engine::geometry::LineSegment2d;
+using opendrive::engine::geometry::Vec2d;
+
+namespace {
+
+constexpr double kMaxRange = 100.0;
+constexpr int kBeams = 360;
+
+double ScanRaycast(const Segments& segments, const Vec2d& origin,
+                   const Vec2d& direction) {
+  const LineSegment2d ray(origin, origin + kMaxRange * direction);
+  double distance = kMaxRange;
+  Vec2d point;
+  for (const auto& segment : segments) {
+    if (segment.GetIntersect(ray, &point)) {
+      distance = std::min(distance, origin.DistanceTo(point));
+    }
+  }
+  return distance;
+}
+
+double BVHRaycast(const SegmentBVH& bvh, const Vec2d& origin,
+                  const Vec2d& direction) {
+  double distance = kMaxRange;
+  bvh.Raycast(origin, direction, kMaxRange, &distance);
+  return distance;
+}
+
+template <typename Func>
+double Run(const std::vector<Vec2d>& origins, int rounds, double& checksum,
+           Func func) {
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    for (const auto& origin : origins) {
+      for (int beam = 0; beam < kBeams; ++beam) {
+        const double heading = 2.0 * M_PI * beam / kBeams;
+        checksum += func(origin, Vec2d::CreateUnitVec2d(heading));
+      }
+    }
+  }
+  std::chrono::duration<double, std::micro> cost =
+      std::chrono::steady_clock::now() - start;
+  return cost.count() / (rounds * origins.size());
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937 rng(5);
+  std::printf("%10s %14s %14s %14s\n", "segments", "scan(us/scan)",
+              "bvh(us/scan)", "checksum diff");
+  for (int roads : {4, 8, 16, 32}) {
+    // a grid of straight roads, four lanes each, boundaries sampled at 0.5 m
+    const double spacing = 40.0;
+    const double extent = spacing * roads / 4;
+    Segments segments;
+    SegmentIds ids;
+    for (int road = 0; road < roads; ++road) {
+      const bool vertical = road % 2;
+      const double at = spacing * (road / 2);
+      for (int boundary = 0; boundary <= 4; ++boundary) {
+        const double offset = at + 3.5 * boundary;
+        for (double s = 0; s < extent; s += 0.5) {
+          const Vec2d start = vertical ? Vec2d(offset, s) : Vec2d(s, offset);
+          const Vec2d end =
+              vertical ? Vec2d(offset, s + 0.5) : Vec2d(s + 0.5, offset);
+          segments.emplace_back(start, end);
+          ids.emplace_back(std::to_string(road));
+        }
+      }
+    }
+    SegmentBVH bvh;
+    bvh.Init(segments, ids);
+    std::uniform_real_distribution<double> position(0, extent);
+    std::vector<Vec2d> origins;
+    for (int i = 0; i < 5; ++i) {
+      origins.emplace_back(position(rng), position(rng));
+    }
+    const int rounds = std::max(1, 20000 / static_cast<int>(segments.size()));
+    double scan_sum = 0;
+    double bvh_sum = 0;
+    const double scan =
+        Run(origins, rounds, scan_sum, [&](const Vec2d& o, const Vec2d& d) {
+          return ScanRaycast(segments, o, d);
+        });
+    const double tree =
+        Run(origins, rounds, bvh_sum, [&](const Vec2d& o, const Vec2d& d) {
+          return BVHRaycast(bvh, o, d);
+        });
+    std::printf("%10zu %14.1f %14.1f %14.2e\n", segments.size(), scan, tree,
+                std::abs(scan_sum - bvh_sum) / rounds);
+  }
+  return 0;
+}
@@ -0,0 +1,129 @@
+// Nearest road, section and lane queries: projecting the point onto every
+// lane curve, against one RoadIndex traversal per query. Also times the
+// index build with one and several threads.
+#include <opendrive-engine/algo/bvh/road_index.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using opendrive::engine::bvh::RoadIndex;
+using opendrive::engine::bvh::RoadIndexLanes;
+using opendrive::engine::bvh::RoadIndexLevel;
+using opendrive::engine::bvh::RoadIndexParam;
+using opendrive::engine::bvh::RoadIndexResults;
+using opendrive::engine::geometry::Polyline2d;
+using opendrive::engine::geometry::Vec2d;
+
+namespace {
+
+template <typename Func>
+double Run(int rounds, Func func) {
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) func();
+  std::chrono::duration<double, std::micro> cost =
+      std::chrono::steady_clock::now() - start;
+  return cost.count() / rounds;
+}
+
+}  // namespace
+
+int main() {
+  std::printf("%8s %8s %12s %12s %12s %12s %12s %12s\n", "roads", "lanes",
+              "scan(us)", "road(us)", "section(us)", "lane(us)",
+              "build1(ms)", "build4(ms)");
+  for (int roads : {100, 400, 1600}) {
+    // roads of three sections with four lanes, 0.5 m curve samples
+    std::mt19937 rng(23);
+    const double extent = 40.0 * std::sqrt(roads);
+    std::uniform_real_distribution<double> position(0, extent);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::vector<Polyline2d> curves;
+    std::vector<std::string> road_ids;
+    std::vector<std::string> section_ids;
+    for (int road = 0; road < roads; ++road) {
+      Vec2d start(position(rng), position(rng));
+      double heading = angle(rng);
+      for (int section = 0; section < 3; ++section) {
+        const double turn = 0.005 * angle(rng);
+        for (int lane = 0; lane < 4; ++lane) {
+          std::vector<Vec2d> points;
+          Vec2d point = start + Vec2d::CreateUnitVec2d(heading - M_PI / 2) *
+                                    (3.5 * lane);
+          double h = heading;
+          for (int i = 0; i < 100; ++i) {
+            points.emplace_back(point);
+            point += Vec2d::CreateUnitVec2d(h) * 0.5;
+            h += turn;
+          }
+          curves.emplace_back(points);
+          road_ids.emplace_back(std::to_string(road));
+          section_ids.emplace_back(std::to_string(road) + "_" +
+                                   std::to_string(section));
+        }
+        for (int i = 0; i < 100; ++i) {
+          start += Vec2d::CreateUnitVec2d(heading) * 0.5;
+          heading += turn;
+        }
+      }
+    }
+    RoadIndexLanes lanes;
+    for (size_t i = 0; i < curves.size(); ++i) {
+      lanes.push_back({road_ids[i], section_ids[i], std::to_string(i),
+                       &curves[i]});
+    }
+    RoadIndex index;
+    RoadIndexParam param;
+    param.max_threads = 1;
+    const double build1 = Run(3, [&]() { index.Init(lanes, param); }) / 1e3;
+    param.max_threads = 4;
+    const double build4 = Run(3, [&]() { index.Init(lanes, param); }) / 1e3;
+
+    std::vector<Vec2d> points;
+    for (int i = 0; i < 200; ++i) {
+      points.emplace_back(position(rng), position(rng));
+    }
+    // the five nearest roads by projecting onto every lane
+    const double scan = Run(1, [&]() {
+      for (const auto& point : points) {
+        std::unordered_map<std::string, double> nearest;
+        for (size_t i = 0; i < curves.size(); ++i) {
+          double s = 0;
+          double lateral = 0;
+          double distance = 0;
+          curves[i].GetProjection(point, &s, &lateral, &distance);
+          auto it = nearest.find(road_ids[i]);
+          if (it == nearest.end()) {
+            nearest.emplace(road_ids[i], distance);
+          } else {
+            it->second = std::min(it->second, distance);
+          }
+        }
+        std::vector<double> sorted;
+        for (const auto& item : nearest) sorted.push_back(item.second);
+        std::partial_sort(sorted.begin(), sorted.begin() + 5, sorted.end());
+      }
+    }) / points.size();
+    RoadIndexResults results;
+    double time[3];
+    for (int level = 0; level < 3; ++level) {
+      time[level] = Run(20, [&]() {
+                      for (const auto& point : points) {
+                        index.Search(point,
+                                     static_cast<RoadIndexLevel>(level), 5,
+                                     &results);
+                      }
+                    }) /
+                    points.size();
+    }
+    std::printf("%8d %8zu %12.1f %12.2f %12.2f %12.2f %12.2f %12.2f\n", roads,
+                curves.size(), scan, time[0], time[1], time[2], build1,
+                build4);
+  }
+  return 0;
+}
@@ -0,0 +1,90 @@
+// Vehicle to map frame transform of a point cloud: rotating every point by
+// the pose quaternion, against the batched Transform3d / Transform2d kernels.
+#include <opendrive-engine/geometry/transform.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using opendrive::engine::geometry::EulerAnglesZXY;
+using opendrive::engine::geometry::Point3D;
+using opendrive::engine::geometry::Quaternion;
+using opendrive::engine::geometry::Transform2d;
+using opendrive::engine::geometry::Transform3d;
+
+namespace {
+
+// v' = q v q^-1 + t, evaluated per point as scalar code would
+Point3D RotateByQuaternion(const Quaternion& q, const Point3D& t,
+                           const Point3D& v) {
+  // u = 2 * (q.xyz x v), v' = v + w * u + q.xyz x u
+  const double ux = 2.0 * (q.y() * v.z() - q.z() * v.y());
+  const double uy = 2.0 * (q.z() * v.x() - q.x() * v.z());
+  const double uz = 2.0 * (q.x() * v.y() - q.y() * v.x());
+  return Point3D(v.x() + q.w() * ux + q.y() * uz - q.z() * uy + t.x(),
+                 v.y() + q.w() * uy + q.z() * ux - q.x() * uz + t.y(),
+                 v.z() + q.w() * uz + q.x() * uy - q.y() * ux + t.z());
+}
+
+template <typename Func>
+double Run(size_t size, int rounds, Func func) {
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) func();
+  std::chrono::duration<double, std::nano> cost =
+      std::chrono::steady_clock::now() - start;
+  return cost.count() / (rounds * size);
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937 rng(13);
+  std::uniform_real_distribution<double> position(-80, 80);
+  const EulerAnglesZXY euler(0.02, -0.01, 1.2);
+  const Point3D translation(4500.0, -1200.0, 12.0);
+  const Quaternion q = euler.ToQuaternion();
+  const Transform3d transform(euler, translation);
+  const Transform2d planar(translation.x(), translation.y(), euler.yaw());
+  std::printf("%10s %16s %16s %16s %14s\n", "points", "quaternion(ns)",
+              "batch3d(ns)", "batch2d(ns)", "max diff");
+  for (size_t n : {1000, 10000, 100000}) {
+    std::vector<Point3D> points;
+    std::vector<double> x(n);
+    std::vector<double> y(n);
+    std::vector<double> z(n);
+    for (size_t i = 0; i < n; ++i) {
+      x[i] = position(rng);
+      y[i] = position(rng);
+      z[i] = 0.1 * position(rng);
+      points.emplace_back(x[i], y[i], z[i]);
+    }
+    std::vector<Point3D> scalar_out(n);
+    std::vector<double> out_x(n);
+    std::vector<double> out_y(n);
+    std::vector<double> out_z(n);
+    const int rounds = static_cast<int>(2000000 / n);
+    const double scalar = Run(n, rounds, [&]() {
+      for (size_t i = 0; i < n; ++i) {
+        scalar_out[i] = RotateByQuaternion(q, translation, points[i]);
+      }
+    });
+    const double batch3d = Run(n, rounds, [&]() {
+      transform.Apply(x.data(), y.data(), z.data(), n, out_x.data(),
+                      out_y.data(), out_z.data());
+    });
+    double max_diff = 0;
+    for (size_t i = 0; i < n; ++i) {
+      max_diff = std::max(max_diff, std::abs(scalar_out[i].x() - out_x[i]));
+      max_diff = std::max(max_diff, std::abs(scalar_out[i].y() - out_y[i]));
+      max_diff = std::max(max_diff, std::abs(scalar_out[i].z() - out_z[i]));
+    }
+    const double batch2d = Run(n, rounds, [&]() {
+      planar.Apply(x.data(), y.data(), n, out_x.data(), out_y.data());
+    });
+    std::printf("%10zu %16.2f %16.2f %16.2f %14.2e\n", n, scalar, batch3d,
+                batch2d, max_diff);
+  }
+  return 0;
+}
@@ -0,0 +1,118 @@
+// WGS84 to map conversion of GPS fixes: the Krueger series summed term by
+// term, as a straightforward port would, against TransverseMercator with
+// Clenshaw summation and the batch interface.
+#include <opendrive-engine/geometry/transverse_mercator.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using opendrive::engine::geometry::TransverseMercator;
+
+namespace {
+
+constexpr double kDegToRad = M_PI / 180.0;
+
+// WGS84 forward projection centered at (lat0 = 0, lon0), one sin/cos and
+// sinh/cosh per series term
+class DirectSeries {
+ public:
+  explicit DirectSeries(double lon0) : lon0_(lon0) {
+    const double f = 1.0 / 298.257223563;
+    const double n = f / (2.0 - f);
+    const double n2 = n * n;
+    const double n3 = n2 * n;
+    e_ = std::sqrt(f * (2.0 - f));
+    a1_ = 6378137.0 / (1.0 + n) * (1.0 + n2 / 4.0);
+    alpha_[0] = n / 2.0 - 2.0 * n2 / 3.0 + 5.0 * n3 / 16.0;
+    alpha_[1] = 13.0 * n2 / 48.0 - 3.0 * n3 / 5.0;
+    alpha_[2] = 61.0 * n3 / 240.0;
+  }
+
+  void Forward(double lat, double lon, double* x, double* y) const {
+    const double lam = (lon - lon0_) * kDegToRad;
+    const double tau = std::tan(lat * kDegToRad);
+    const double tau1 = std::hypot(1.0, tau);
+    const double sig = std::sinh(e_ * std::atanh(e_ * tau / tau1));
+    const double taup = std::hypot(1.0, sig) * tau - sig * tau1;
+    const double xip = std::atan2(taup, std::cos(lam));
+    const double etap =
+        std::asinh(std::sin(lam) / std::hypot(taup, std::cos(lam)));
+    double xi = xip;
+    double eta = etap;
+    for (int j = 1; j <= 3; ++j) {
+      xi += alpha_[j - 1] * std::sin(2 * j * xip) * std::cosh(2 * j * etap);
+      eta += alpha_[j - 1] * std::cos(2 * j * xip) * std::sinh(2 * j * etap);
+    }
+    *x = a1_ * eta;
+    *y = a1_ * xi;
+  }
+
+ private:
+  double lon0_;
+  double e_;
+  double a1_;
+  double alpha_[3];
+};
+
+template <typename Func>
+double Run(size_t size, int rounds, Func func) {
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) func();
+  std::chrono::duration<double, std::nano> cost =
+      std::chrono::steady_clock::now() - start;
+  return cost.count() / (rounds * size);
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937 rng(19);
+  // fixes within a city sized map
+  std::uniform_real_distribution<double> lat(48.9, 49.1);
+  std::uniform_real_distribution<double> lon(7.9, 8.1);
+  const size_t size = 100000;
+  std::vector<double> lats(size);
+  std::vector<double> lons(size);
+  for (size_t i = 0; i < size; ++i) {
+    lats[i] = lat(rng);
+    lons[i] = lon(rng);
+  }
+  std::vector<double> x(size);
+  std::vector<double> y(size);
+  std::vector<double> back_lat(size);
+  std::vector<double> back_lon(size);
+  TransverseMercator projection;
+  projection.Init("+proj=tmerc +lat_0=0 +lon_0=8 +datum=WGS84");
+  const DirectSeries direct(8.0);
+  const int rounds = 20;
+  double checksum = 0;
+  const double direct_ns = Run(size, rounds, [&]() {
+    for (size_t i = 0; i < size; ++i) {
+      direct.Forward(lats[i], lons[i], &x[i], &y[i]);
+    }
+    checksum += x[size / 2];
+  });
+  const double forward_ns = Run(size, rounds, [&]() {
+    projection.Forward(lats.data(), lons.data(), size, x.data(), y.data());
+    checksum += x[size / 2];
+  });
+  const double inverse_ns = Run(size, rounds, [&]() {
+    projection.Inverse(x.data(), y.data(), size, back_lat.data(),
+                       back_lon.data());
+    checksum += back_lat[size / 2];
+  });
+  double max_error = 0;
+  for (size_t i = 0; i < size; ++i) {
+    max_error = std::max(max_error, std::abs(back_lat[i] - lats[i]));
+    max_error = std::max(max_error, std::abs(back_lon[i] - lons[i]));
+  }
+  std::printf("%24s %10.1f ns/point\n", "direct series forward", direct_ns);
+  std::printf("%24s %10.1f ns/point\n", "batch forward", forward_ns);
+  std::printf("%24s %10.1f ns/point\n", "batch inverse", inverse_ns);
+  std::printf("%24s %10.2e deg (checksum %.3f)\n", "round trip error",
+              max_error, checksum);
+  return 0;
+}
@@ -0,0 +1,125 @@
+#ifndef OPENDRIVE_ENGINE_ALGO_ROAD_INDEX_H_
+#define OPENDRIVE_ENGINE_ALGO_ROAD_INDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "opendrive-engine/core/id.h"
+#include "opendrive-engine/geometry/polyline2d.h"
+#include "opendrive-engine/geometry/vec2d.h"
+
+namespace opendrive {
+namespace engine {
+namespace bvh {
+
+struct RoadIndexLane {
+  core::Id road_id;
+  core::Id section_id;
+  core::Id lane_id;
+  const geometry::Polyline2d* curve;  // e.g. the central curve, not owned
+};
+typedef std::vector<RoadIndexLane> RoadIndexLanes;
+
+enum class RoadIndexLevel : int { ROAD = 0, SECTION = 1, LANE = 2 };
+
+struct RoadIndexResult {
+  RoadIndexResult() : distance(0), s(0), lateral(0), heading(0) {}
+  core::Id id;       // of the road, section or lane found
+  core::Id lane_id;  // the nearest lane within it
+  double distance;   // from the query point to that lane's curve
+  double s;          // projection onto that lane's curve
+  double lateral;    // left of the curve is positive
+  double heading;    // of the curve at s
+};
+typedef std::vector<RoadIndexResult> RoadIndexResults;
+
+struct RoadIndexParam {
+  RoadIndexParam() : leaf_max_size(4), max_threads(4) {}
+  size_t leaf_max_size;  // roads per leaf of the top level hierarchy
+  size_t max_threads;    // for computing lane bounds
+};
+
+/**
+ * @class RoadIndex
+ * @brief Multi-level spatial index over the lanes of a map: a hierarchy of
+ *        road boxes on top, section and lane boxes below every road and
+ *        the lane curves, with their own segment hierarchy, as leaves. A
+ *        best-first traversal answers nearest road, section and lane
+ *        queries alike, a road or section is as far as its nearest lane.
+ */
+class RoadIndex {
+ public:
+  typedef std::shared_ptr<RoadIndex> Ptr;
+  typedef std::shared_ptr<RoadIndex const> ConstPtr;
+  RoadIndex() = default;
+
+  /**
+   * @brief Build the index, any previous content is dropped.
+   * @param lanes The lanes to index, in any order. The curves must outlive
+   *        the index, lanes whose curve has no segment are skipped.
+   * @param param Build parameters.
+   */
+  void Init(const RoadIndexLanes& lanes,
+            const RoadIndexParam& param = RoadIndexParam());
+
+  /**
+   * @brief Find the nearest roads, sections or lanes to a point.
+   * @param point The query point.
+   * @param level What to search for.
+   * @param num_closest The number of results wanted.
+   * @param results Output, nearest first.
+   * @param max_distance Lanes farther than this are ignored.
+   */
+  void Search(const geometry::Vec2d& point, RoadIndexLevel level,
+              size_t num_closest, RoadIndexResults* const results,
+              double max_distance =
+                  std::numeric_limits<double>::infinity()) const;
+
+  size_t num_roads() const { return roads_.size(); }
+  size_t num_sections() const { return sections_.size(); }
+  size_t num_lanes() const { return lanes_.size(); }
+
+ private:
+  struct Box {
+    double min_x;
+    double min_y;
+    double max_x;
+    double max_y;
+  };
+  // a road over a range of sections, or a section over a range of lanes
+  struct Group {
+    Box box;
+    uint32_t begin;
+    uint32_t end;
+    uint32_t parent;  // the road of a section
+  };
+  struct Lane {
+    Box box;
+    const geometry::Polyline2d* curve;
+    uint32_t section;
+  };
+  struct Node {
+    Box box;
+    uint32_t begin;  // leaf: first road, inner: index of the right child
+    uint32_t count;  // roads in a leaf, 0 for inner nodes
+  };
+  uint32_t Build(uint32_t begin, uint32_t end, std::vector<uint32_t>* order);
+
+  RoadIndexParam param_;
+  std::vector<Group> roads_;
+  std::vector<Group> sections_;
+  std::vector<Lane> lanes_;
+  std::vector<core::Id> road_ids_;
+  std::vector<core::Id> section_ids_;
+  std::vector<core::Id> lane_ids_;
+  std::vector<Node> nodes_;
+};
+
+}  // namespace bvh
+}  // namespace engine
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_ENGINE_ALGO_ROAD_INDEX_H_
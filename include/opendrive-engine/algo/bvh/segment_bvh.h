@@ -0,0 +1,123 @@
+#ifndef OPENDRIVE_ENGINE_ALGO_SEGMENT_BVH_H_
+#define OPENDRIVE_ENGINE_ALGO_SEGMENT_BVH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "opendrive-engine/core/id.h"
+#include "opendrive-engine/geometry/aabox2d.h"
+#include "opendrive-engine/geometry/line_segment2d.h"
+
+namespace opendrive {
+namespace engine {
+namespace bvh {
+
+typedef std::vector<geometry::LineSegment2d> Segments;
+typedef std::vector<size_t> SegmentIndices;
+typedef std::vector<core::Id> SegmentIds;
+typedef std::vector<uint32_t> SegmentTags;
+
+struct SegmentBVHParam {
+  SegmentBVHParam() : leaf_max_size(4) {}
+  size_t leaf_max_size;
+};
+
+/**
+ * @class SegmentBVH
+ * @brief Bounding volume hierarchy over 2-D line segments, e.g. sampled lane
+ *        boundaries. Nodes are stored depth first in one array: the left
+ *        child of an inner node directly follows it, so a traversal mostly
+ *        walks forward in memory.
+ */
+class SegmentBVH {
+ public:
+  typedef std::shared_ptr<SegmentBVH> Ptr;
+  typedef std::shared_ptr<SegmentBVH const> ConstPtr;
+  SegmentBVH() = default;
+
+  /**
+   * @brief Build the hierarchy, any previous content is dropped.
+   * @param segments The segments to index.
+   * @param ids One id per segment, e.g. the lane the segment belongs to.
+   */
+  void Init(const Segments& segments, const SegmentIds& ids,
+            const SegmentBVHParam& param = SegmentBVHParam());
+
+  /**
+   * @brief Build the hierarchy with a caller defined tag per segment, e.g.
+   *        which boundary of the lane the segment lies on.
+   * @param segments The segments to index.
+   * @param ids One id per segment.
+   * @param tags One tag per segment.
+   */
+  void Init(const Segments& segments, const SegmentIds& ids,
+            const SegmentTags& tags,
+            const SegmentBVHParam& param = SegmentBVHParam());
+
+  /**
+   * @brief Collect the segments whose bounding box overlaps the given box.
+   * @param box The query box.
+   * @param indices Output, cleared first. The order is unspecified.
+   */
+  void Query(const geometry::AABox2d& box, SegmentIndices* const indices) const;
+
+  /**
+   * @brief Find the first segment hit by a ray. Of the segments hit at the
+   *        same distance, one crossed from its left to its right side wins,
+   *        so the orientation of the segments can mark an inner side.
+   * @param origin The origin of the ray.
+   * @param direction The unit direction of the ray.
+   * @param max_range Hits farther than this are ignored.
+   * @param distance Output, the distance from the origin to the hit.
+   * @return The index of the hit segment, -1 if there is none.
+   */
+  int Raycast(const geometry::Vec2d& origin, const geometry::Vec2d& direction,
+              double max_range, double* const distance) const;
+
+  /**
+   * @brief Find the segment nearest to a point, the lowest index on ties.
+   * @param point The query point.
+   * @param max_distance Segments farther than this are ignored, a good
+   *        upper bound such as the distance to a segment known to be close
+   *        prunes most of the hierarchy.
+   * @param distance Output, the distance from the point to the segment.
+   * @return The index of the nearest segment, -1 if none is within
+   *         max_distance.
+   */
+  int Nearest(const geometry::Vec2d& point, double max_distance,
+              double* const distance) const;
+
+  size_t size() const { return segments_.size(); }
+  bool empty() const { return segments_.empty(); }
+  const geometry::LineSegment2d& segment(size_t index) const {
+    return segments_[index];
+  }
+  const core::Id& id(size_t index) const { return ids_[index]; }
+  uint32_t tag(size_t index) const {
+    return tags_.empty() ? 0 : tags_[index];
+  }
+
+ private:
+  struct Node {
+    double min_x;
+    double min_y;
+    double max_x;
+    double max_y;
+    uint32_t begin;  // leaf: first segment, inner: index of the right child
+    uint32_t count;  // segments in a leaf, 0 for inner nodes
+  };
+  uint32_t Build(uint32_t begin, uint32_t end, std::vector<uint32_t>* order);
+  SegmentBVHParam param_;
+  Segments segments_;  // reordered so that every leaf is a contiguous range
+  SegmentIds ids_;
+  SegmentTags tags_;  // empty if none were given
+  std::vector<Node> nodes_;
+};
+
+}  // namespace bvh
+}  // namespace engine
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_ENGINE_ALGO_SEGMENT_BVH_H_
@@ -3,10 +3,13 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <nanoflann.hpp>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cactus/rw_lock.h"
@@ -28,9 +31,22 @@ typedef std::vector<double> KDTreeDists;
 struct KDTreeParam {
   KDTreeParam()
       : leaf_max_size(10),
-        flags(nanoflann::KDTreeSingleIndexAdaptorFlags::None) {}
+        flags(nanoflann::KDTreeSingleIndexAdaptorFlags::None),
+        max_shard_size(1 << 16),
+        max_threads(4) {}
   size_t leaf_max_size;
   nanoflann::KDTreeSingleIndexAdaptorFlags flags;
+  size_t max_shard_size;  // samples are split into spatial shards of at most
+                          // this many, each with its own index
+  size_t max_threads;     // shards are built concurrently
+};
+
+struct SearchParam {
+  SearchParam()
+      : eps(0), max_distance(std::numeric_limits<double>::infinity()) {}
+  double eps;           // the i-th result is at most (1 + eps) times farther
+                        // than the true i-th nearest sample, 0 is exact
+  double max_distance;  // samples farther than this are not returned
 };
 
 struct SearchResult {
@@ -53,11 +69,13 @@ class KDTreeAdaptor {
   size_t kdtree_get_point_count() const;
   double kdtree_get_pt(size_t idx, size_t dim) const;
   void Init(const SamplePoints& samples);
-  const KDTreeNodes& matrix() const;
+  void Init(const SamplePoints& samples, const KDTreeIndices& indices);
+  const std::vector<double>& points() const;  // x and y interleaved
   const KDTreeIds& ids() const;
 
  private:
-  KDTreeNodes matrix_;
+  // contiguous rather than one allocation per sample, leaf scans stream
+  std::vector<double> points_;
   KDTreeIds ids_;
 };
 
@@ -72,29 +90,73 @@ class KDTree {
   KDTree();
   void Init(const SamplePoints& samples,
             const KDTreeParam& param = KDTreeParam());
+  size_t num_shards();
 
   template <typename PointType>
-  SearchResults Query(const PointType& query_point, size_t num_closest) {
+  SearchResults Query(const PointType& query_point, size_t num_closest,
+                      const SearchParam& param = SearchParam()) {
     cactus::ReadLockGuard<cactus::AtomicRWLock> guard(rw_lock_);
     SearchResults result;
-    Search(query_point.x(), query_point.y(), num_closest, result);
+    Search(query_point.x(), query_point.y(), num_closest, param, result);
     return result;
   }
 
   template <typename T>
-  SearchResults Query(T x, T y, size_t num_closest) {
+  SearchResults Query(T x, T y, size_t num_closest,
+                      const SearchParam& param = SearchParam()) {
     cactus::ReadLockGuard<cactus::AtomicRWLock> guard(rw_lock_);
     SearchResults result;
-    Search(static_cast<double>(x), static_cast<double>(y), num_closest, result);
+    Search(static_cast<double>(x), static_cast<double>(y), num_closest, param,
+           result);
     return result;
   }
 
+  // the points are searched in morton order and the results scattered back,
+  // so consecutive searches touch the same part of the forest
+  template <typename PointType>
+  std::vector<SearchResults> Query(const std::vector<PointType>& query_points,
+                                   size_t num_closest,
+                                   const SearchParam& param = SearchParam()) {
+    std::vector<double> xs;
+    std::vector<double> ys;
+    xs.reserve(query_points.size());
+    ys.reserve(query_points.size());
+    for (const auto& query_point : query_points) {
+      xs.emplace_back(query_point.x());
+      ys.emplace_back(query_point.y());
+    }
+    cactus::ReadLockGuard<cactus::AtomicRWLock> guard(rw_lock_);
+    std::vector<SearchResults> results(query_points.size());
+    SearchBatch(xs.data(), ys.data(), xs.size(), num_closest, param, &results);
+    return results;
+  }
+
  private:
-  int Search(double x, double y, size_t num_closest, SearchResults& result);
+  // one spatial region of the samples, the shards together form a forest
+  struct Shard {
+    KDTreeAdaptor adaptor;
+    std::shared_ptr<KDTreeIndex> index;
+    double min_x;
+    double min_y;
+    double max_x;
+    double max_y;
+    double scale_x;               // box to 16 bit morton grid
+    double scale_y;
+    std::vector<uint32_t> codes;  // of the samples, which are in this order
+  };
+  void Split(const SamplePoints& samples, size_t begin, size_t end,
+             KDTreeIndices* const order,
+             std::vector<std::pair<size_t, size_t>>* const ranges) const;
+  int Search(double x, double y, size_t num_closest, const SearchParam& param,
+             SearchResults& result);
+  void SearchBatch(const double* x, const double* y, size_t size,
+                   size_t num_closest, const SearchParam& param,
+                   std::vector<SearchResults>* const results);
+  void Prefetch(double x, double y) const;
   cactus::AtomicRWLock rw_lock_;  // read and write lock
   KDTreeParam param_;
-  KDTreeAdaptor adaptor_;
-  std::shared_ptr<KDTreeIndex> index_;
+  size_t sample_num_;
+  std::vector<std::unique_ptr<Shard>> shards_;
 };
 
 }  // namespace kdtree
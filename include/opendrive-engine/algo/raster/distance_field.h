@@ -0,0 +1,121 @@
+#ifndef OPENDRIVE_ENGINE_ALGO_DISTANCE_FIELD_H_
+#define OPENDRIVE_ENGINE_ALGO_DISTANCE_FIELD_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "opendrive-engine/algo/bvh/segment_bvh.h"
+#include "opendrive-engine/algo/raster/drivable_raster.h"
+#include "opendrive-engine/geometry/vec2d.h"
+
+namespace opendrive {
+namespace engine {
+namespace raster {
+
+struct DistanceFieldParam {
+  DistanceFieldParam()
+      : resolution(0.2), max_distance(10.0), max_cached_tiles(1024) {}
+  double resolution;        // node spacing in meters
+  double max_distance;      // distances are clamped to +/- this
+  size_t max_cached_tiles;  // least recently used tiles are dropped
+};
+
+/**
+ * @class DistanceField
+ * @brief Signed distance to a set of edges, sampled on a regular lattice and
+ *        interpolated bilinearly. The distance is positive inside the areas
+ *        and negative outside. Nodes are computed lazily in square tiles
+ *        on first use and kept in an LRU cache, so memory stays bounded
+ *        however much of the map is queried.
+ */
+class DistanceField {
+ public:
+  typedef std::shared_ptr<DistanceField> Ptr;
+  typedef std::shared_ptr<DistanceField const> ConstPtr;
+  static constexpr int kTileCells = 64;  // tile side length in cells
+
+  DistanceField() = default;
+
+  /**
+   * @brief Set the edges and areas, drops all cached tiles.
+   * @param edges The edges distances are measured to, must outlive the
+   *        field.
+   * @param areas Simple polygons whose union is the positive side.
+   * @param param Lattice, clamping and cache limits.
+   */
+  void Init(const bvh::SegmentBVH::ConstPtr& edges, const Polygons& areas,
+            const DistanceFieldParam& param = DistanceFieldParam());
+
+  /**
+   * @brief Evaluate the field at a point.
+   * @param point The query point.
+   * @param distance Output, the interpolated signed distance.
+   * @param gradient Output, the gradient of the interpolated distance, may
+   *        be nullptr.
+   * @return False if the field has no edges.
+   */
+  bool Evaluate(const geometry::Vec2d& point, double* const distance,
+                geometry::Vec2d* const gradient);
+
+  /**
+   * @brief Evaluate the field at points stored as structure of arrays.
+   *        Consecutive points in the same tile share one cache lookup.
+   * @param x The x coordinates.
+   * @param y The y coordinates.
+   * @param size The number of points.
+   * @param distance Output, one signed distance per point.
+   * @param gradient_x Output, may be nullptr together with gradient_y.
+   * @param gradient_y Output, may be nullptr together with gradient_x.
+   * @return False if the field has no edges.
+   */
+  bool Evaluate(const double* x, const double* y, size_t size,
+                double* const distance, double* const gradient_x,
+                double* const gradient_y);
+
+  const DistanceFieldParam& param() const { return param_; }
+  size_t cached_tiles() const;
+  size_t built_tiles() const;  // tiles computed since Init
+
+ private:
+  static constexpr int kTileNodes = kTileCells + 1;
+  // nodes shared by neighbouring tiles are stored in both, so a cell never
+  // reaches outside its tile
+  typedef std::vector<float> Tile;
+  typedef std::shared_ptr<const Tile> TilePtr;
+  struct TileKey {
+    int64_t x;
+    int64_t y;
+    bool operator==(const TileKey& other) const {
+      return x == other.x && y == other.y;
+    }
+  };
+  struct TileKeyHash {
+    size_t operator()(const TileKey& key) const;
+  };
+  struct CacheEntry {
+    TilePtr tile;
+    std::list<TileKey>::iterator lru;
+  };
+
+  TilePtr GetTile(const TileKey& key);
+  void BuildTile(const TileKey& key, Tile* const tile);
+
+  DistanceFieldParam param_;
+  bvh::SegmentBVH::ConstPtr edges_;
+  DrivableRaster areas_;  // inside / outside at the nodes
+  mutable std::mutex cache_mutex_;
+  std::unordered_map<TileKey, CacheEntry, TileKeyHash> cache_;
+  std::list<TileKey> lru_;  // most recently used first
+  size_t built_tiles_ = 0;
+};
+
+}  // namespace raster
+}  // namespace engine
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_ENGINE_ALGO_DISTANCE_FIELD_H_
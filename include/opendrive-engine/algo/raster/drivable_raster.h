@@ -0,0 +1,126 @@
+#ifndef OPENDRIVE_ENGINE_ALGO_DRIVABLE_RASTER_H_
+#define OPENDRIVE_ENGINE_ALGO_DRIVABLE_RASTER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "opendrive-engine/geometry/aabox2d.h"
+#include "opendrive-engine/geometry/vec2d.h"
+
+namespace opendrive {
+namespace engine {
+namespace raster {
+
+typedef std::vector<geometry::Vec2d> Polygon;
+typedef std::vector<Polygon> Polygons;
+
+struct DrivableGrid {
+  DrivableGrid() : min_x(0), min_y(0), resolution(0), width(0), height(0) {}
+  double min_x;       // lower left corner of cell (0, 0)
+  double min_y;
+  double resolution;  // cell size in meters
+  size_t width;       // cells along x
+  size_t height;      // cells along y
+  std::vector<uint8_t> cells;  // row major from min_y, 1 if drivable
+  uint8_t at(size_t col, size_t row) const { return cells[row * width + col]; }
+};
+
+struct DrivableRasterParam {
+  DrivableRasterParam()
+      : max_cached_tiles(4096), max_threads(4), max_cells(1 << 26) {}
+  size_t max_cached_tiles;  // least recently used tiles are dropped
+  size_t max_threads;       // for rasterizing missing tiles
+  size_t max_cells;         // largest grid a window may produce
+};
+
+/**
+ * @class DrivableRaster
+ * @brief Scan-converts drivable lane polygons into occupancy grids. Cells
+ *        are aligned to a global lattice at each resolution and rasterized
+ *        in square tiles which are cached, so a window moving with the
+ *        vehicle only rasterizes the tiles it newly touches. A cell is
+ *        drivable if its center lies inside any polygon.
+ */
+class DrivableRaster {
+ public:
+  typedef std::shared_ptr<DrivableRaster> Ptr;
+  typedef std::shared_ptr<DrivableRaster const> ConstPtr;
+  static constexpr int kTileCells = 64;  // tile side length in cells
+
+  DrivableRaster() = default;
+
+  /**
+   * @brief Set the polygons, drops all cached tiles.
+   * @param polygons Simple polygons, e.g. one per lane.
+   * @param param Cache and threading limits.
+   */
+  void Init(const Polygons& polygons,
+            const DrivableRasterParam& param = DrivableRasterParam());
+
+  /**
+   * @brief Rasterize a window. The grid covers every lattice cell the
+   *        window touches, so it may be slightly larger than the window.
+   *        The cell buffer keeps its capacity between calls.
+   * @param window The region to rasterize.
+   * @param resolution The cell size in meters.
+   * @param grid Output, the occupancy grid.
+   * @return False if the resolution is not positive or the grid would be
+   *         larger than max_cells.
+   */
+  bool Rasterize(const geometry::AABox2d& window, double resolution,
+                 DrivableGrid* const grid);
+
+  /**
+   * @brief Test a single point exactly, without going through the tiles.
+   * @param point The point to test.
+   * @return True if the point lies inside any polygon.
+   */
+  bool Contains(const geometry::Vec2d& point) const;
+
+  size_t num_polygons() const { return polygons_.size(); }
+  size_t cached_tiles() const;
+  size_t rasterized_tiles() const;  // tiles computed since Init
+
+ private:
+  typedef std::vector<uint8_t> Tile;
+  struct TileKey {
+    int64_t x;
+    int64_t y;
+    double resolution;
+    bool operator==(const TileKey& other) const {
+      return x == other.x && y == other.y && resolution == other.resolution;
+    }
+  };
+  struct TileKeyHash {
+    size_t operator()(const TileKey& key) const;
+  };
+  struct CacheEntry {
+    std::shared_ptr<const Tile> tile;
+    std::list<TileKey>::iterator lru;
+  };
+
+  void RasterizeTile(const TileKey& key, Tile* const tile) const;
+  void CandidatePolygons(const geometry::AABox2d& box,
+                         std::vector<uint32_t>* const indices) const;
+
+  DrivableRasterParam param_;
+  Polygons polygons_;
+  std::vector<geometry::AABox2d> bounds_;
+  // polygons by coarse buckets of kBucketSize meters
+  std::unordered_map<int64_t, std::vector<uint32_t>> buckets_;
+  mutable std::mutex cache_mutex_;
+  std::unordered_map<TileKey, CacheEntry, TileKeyHash> cache_;
+  std::list<TileKey> lru_;  // most recently used first
+  size_t rasterized_tiles_ = 0;
+};
+
+}  // namespace raster
+}  // namespace engine
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_ENGINE_ALGO_DRIVABLE_RASTER_H_
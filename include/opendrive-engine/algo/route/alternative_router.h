@@ -0,0 +1,80 @@
+#ifndef OPENDRIVE_ENGINE_ALGO_ALTERNATIVE_ROUTER_H_
+#define OPENDRIVE_ENGINE_ALGO_ALTERNATIVE_ROUTER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "opendrive-engine/algo/route/lane_graph.h"
+
+namespace opendrive {
+namespace engine {
+namespace route {
+
+struct AlternativeRouteParam {
+  AlternativeRouteParam() : max_stretch(1.4), max_sharing(0.75) {}
+  double max_stretch;  // an alternative costs at most this times the best
+  double max_sharing;  // share of the best cost it may have in common with
+                       // any route found before
+};
+
+struct Route {
+  Route() : cost(0), length(0) {}
+  std::vector<uint32_t> lanes;  // graph indices, start lane first
+  double cost;
+  double length;  // driven meters, lane changes add none
+};
+typedef std::vector<Route> Routes;
+
+/**
+ * @class AlternativeRouter
+ * @brief Shortest route and alternatives between two lane positions, by the
+ *        via-node method: one forward search from the start and one backward
+ *        search from the goal, both bounded by the stretch, give the best
+ *        route through every lane that both reached. Those candidates are
+ *        taken cheapest first and kept unless they share too much with a
+ *        route already taken, so k routes cost two searches, not k.
+ *
+ *        Search state lives in per-thread workspaces reset by generation
+ *        stamps, queries allocate nothing once a thread has warmed up.
+ */
+class AlternativeRouter {
+ public:
+  typedef std::shared_ptr<AlternativeRouter> Ptr;
+  typedef std::shared_ptr<AlternativeRouter const> ConstPtr;
+  AlternativeRouter() = default;
+
+  void Init(const LaneGraph::ConstPtr& graph,
+            const AlternativeRouteParam& param = AlternativeRouteParam());
+
+  /**
+   * @brief Find up to num_routes routes, cheapest first.
+   * @param from The start lane.
+   * @param from_s Meters driven on the start lane.
+   * @param to The goal lane.
+   * @param to_s Meters driven on the goal lane.
+   * @param num_routes The number of routes wanted, 1 gives the shortest.
+   * @param routes Output.
+   * @return False if a lane is not in the graph or the goal is unreachable.
+   */
+  bool Search(uint32_t from, double from_s, uint32_t to, double to_s,
+              size_t num_routes, Routes* const routes) const;
+
+  // the same under other lane weights, one per graph lane
+  bool Search(uint32_t from, double from_s, uint32_t to, double to_s,
+              size_t num_routes, const std::vector<double>& weights,
+              Routes* const routes) const;
+
+  const LaneGraph::ConstPtr& graph() const { return graph_; }
+
+ private:
+  LaneGraph::ConstPtr graph_;
+  AlternativeRouteParam param_;
+};
+
+}  // namespace route
+}  // namespace engine
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_ENGINE_ALGO_ALTERNATIVE_ROUTER_H_
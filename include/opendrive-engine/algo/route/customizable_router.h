@@ -0,0 +1,144 @@
+#ifndef OPENDRIVE_ENGINE_ALGO_CUSTOMIZABLE_ROUTER_H_
+#define OPENDRIVE_ENGINE_ALGO_CUSTOMIZABLE_ROUTER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "opendrive-engine/algo/route/alternative_router.h"
+#include "opendrive-engine/algo/route/lane_graph.h"
+
+namespace opendrive {
+namespace engine {
+namespace route {
+
+struct CustomizableRouteParam {
+  CustomizableRouteParam() : cell_size(16), max_threads(4) {}
+  size_t cell_size;    // nested dissection stops at cells this small
+  size_t max_threads;  // for customization
+};
+
+/**
+ * @class CustomizableRouter
+ * @brief Shortest routes by a customizable contraction hierarchy. Init only
+ *        looks at the topology of the lane graph: lanes are ordered by
+ *        nested dissection of their positions and contracted in that order,
+ *        which fixes the shortcuts once. Customize then computes the cost of
+ *        every shortcut for a set of lane weights, level by level of the
+ *        elimination tree and in parallel within a level, in a fraction of
+ *        the time a new contraction would take.
+ *
+ *        Every customization builds a new metric and swaps it in at once;
+ *        a query works on the metric current when it started, so queries
+ *        run on undisturbed while the next metric is computed.
+ */
+class CustomizableRouter {
+ public:
+  typedef std::shared_ptr<CustomizableRouter> Ptr;
+  typedef std::shared_ptr<CustomizableRouter const> ConstPtr;
+
+  // lane weights with the shortcut costs derived from them
+  struct Metric {
+    std::vector<double> weights;  // per graph lane
+    std::vector<double> up;       // per shortcut, from lower to higher rank
+    std::vector<double> down;     // per shortcut, from higher to lower rank
+  };
+  typedef std::shared_ptr<const Metric> MetricPtr;
+
+  CustomizableRouter() = default;
+
+  /**
+   * @brief Order and contract the graph, then customize with its weights.
+   * @param graph The lane graph, its topology must not change afterwards.
+   * @param param Preprocessing and customization parameters.
+   */
+  void Init(const LaneGraph::ConstPtr& graph,
+            const CustomizableRouteParam& param = CustomizableRouteParam());
+
+  /**
+   * @brief Replace all lane weights.
+   * @param weights One weight per graph lane, not negative.
+   * @return False if the weights do not fit the graph.
+   */
+  bool Customize(const std::vector<double>& weights);
+
+  /**
+   * @brief Change some lane weights, the others keep theirs.
+   * @param changes Graph lane index and new weight.
+   * @return False if a lane or weight is invalid, nothing changes then.
+   */
+  bool Customize(const std::vector<std::pair<uint32_t, double>>& changes);
+
+  /**
+   * @brief Find the shortest route, lane positions as in AlternativeRouter.
+   * @param from The start lane.
+   * @param from_s Meters driven on the start lane.
+   * @param to The goal lane.
+   * @param to_s Meters driven on the goal lane.
+   * @param route Output.
+   * @return False if a lane is not in the graph or the goal is unreachable.
+   */
+  bool Search(uint32_t from, double from_s, uint32_t to, double to_s,
+              Route* const route) const;
+
+  // the current metric, stays valid for the caller across customizations
+  MetricPtr metric() const;
+  const LaneGraph::ConstPtr& graph() const { return graph_; }
+  size_t num_shortcuts() const { return heads_.size(); }
+  size_t num_levels() const { return level_offsets_.size() - 1; }
+
+ private:
+  // an edge of the lane graph, as the shortcut it sets the initial cost of
+  struct Input {
+    uint32_t shortcut;
+    uint32_t tail;  // graph lane the edge leaves
+    bool up;        // from lower to higher rank
+    LaneEdgeType type;
+  };
+  // a lower neighbour and the shortcut to it
+  struct Down {
+    uint32_t rank;
+    uint32_t shortcut;
+  };
+
+  void Order(const std::vector<std::vector<uint32_t>>& neighbours,
+             std::vector<uint32_t>* const lanes, uint32_t* const next_rank,
+             std::vector<uint8_t>* const marks);
+  void Contract(const std::vector<std::vector<uint32_t>>& neighbours);
+  // expects the lock held and valid weights
+  void Apply(std::vector<double>&& weights);
+  // shortcuts of rank through its lower triangles
+  void Relax(uint32_t rank, Metric* const metric,
+             std::vector<uint32_t>* const marker) const;
+  // lanes along a shortcut in one direction, the first one excluded
+  void Unpack(const Metric& metric, uint32_t shortcut, bool up,
+              std::vector<uint32_t>* const lanes) const;
+
+  LaneGraph::ConstPtr graph_;
+  CustomizableRouteParam param_;
+  std::vector<uint32_t> rank_;  // of every graph lane
+  std::vector<uint32_t> lane_;  // of every rank
+  // upward shortcuts by rank in compressed rows, heads ascending; the first
+  // head of a row is the parent in the elimination tree
+  std::vector<uint32_t> up_offsets_;
+  std::vector<uint32_t> heads_;
+  std::vector<uint32_t> tails_;  // of every shortcut
+  std::vector<uint32_t> down_offsets_;
+  std::vector<Down> downs_;  // lower neighbours ascending
+  std::vector<uint32_t> input_offsets_;
+  std::vector<Input> inputs_;  // by shortcut
+  // ranks grouped by level, a level only depends on the ones below
+  std::vector<uint32_t> level_offsets_;
+  std::vector<uint32_t> levels_;
+  std::mutex customize_mutex_;  // one customization at a time
+  MetricPtr metric_;            // atomically swapped
+};
+
+}  // namespace route
+}  // namespace engine
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_ENGINE_ALGO_CUSTOMIZABLE_ROUTER_H_
@@ -0,0 +1,124 @@
+#ifndef OPENDRIVE_ENGINE_ALGO_LANE_GRAPH_H_
+#define OPENDRIVE_ENGINE_ALGO_LANE_GRAPH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "opendrive-engine/core/id.h"
+#include "opendrive-engine/geometry/vec2d.h"
+
+namespace opendrive {
+namespace engine {
+namespace route {
+
+// a lane as seen in its driving direction
+struct LaneGraphLane {
+  LaneGraphLane()
+      : index(0),
+        length(0),
+        entry_heading(0),
+        exit_heading(0),
+        reversed(false) {}
+  core::Id id;
+  core::Id section_id;
+  int index;  // the OpenDRIVE lane number within the section
+  double length;
+  geometry::Vec2d entry;
+  geometry::Vec2d exit;
+  double entry_heading;
+  double exit_heading;
+  bool reversed;  // driven against the direction of its central curve
+};
+typedef std::vector<LaneGraphLane> LaneGraphLanes;
+
+struct LaneGraphParam {
+  LaneGraphParam()
+      : connect_distance(0.5), connect_heading(0.5), lane_change_cost(20) {}
+  double connect_distance;  // an exit this close to an entry continues there
+  double connect_heading;   // at most this heading change, in radians
+  double lane_change_cost;  // added for every change to a neighbouring lane
+};
+
+enum class LaneEdgeType : uint8_t { SUCCESSOR = 0, LANE_CHANGE = 1 };
+
+struct LaneEdge {
+  uint32_t lane;  // the other end
+  LaneEdgeType type;
+};
+
+/**
+ * @class LaneGraph
+ * @brief Directed graph over the lanes of a map. A lane continues into every
+ *        lane whose entry meets its exit, and may change into the adjacent
+ *        lanes of its section that run the same way. Edges are stored in
+ *        compressed rows both ways, so forward and backward searches walk
+ *        contiguous memory.
+ *
+ *        Costs are per lane: leaving a lane through its exit costs the lane's
+ *        weight; a lane change costs the fixed lane_change_cost. The graph's
+ *        own weights are the lane lengths and never change after Init, so
+ *        it can be shared between threads; other weights are passed to the
+ *        routers, or held by a CustomizableRouter metric.
+ */
+class LaneGraph {
+ public:
+  typedef std::shared_ptr<LaneGraph> Ptr;
+  typedef std::shared_ptr<LaneGraph const> ConstPtr;
+  LaneGraph() = default;
+
+  /**
+   * @brief Build the graph, any previous content is dropped.
+   * @param lanes The lanes, their position in here is their graph index.
+   * @param param Connection tolerances and the lane change cost.
+   */
+  void Init(const LaneGraphLanes& lanes,
+            const LaneGraphParam& param = LaneGraphParam());
+
+  // -1 if the lane is not part of the graph
+  int FindLane(const core::Id& id) const;
+
+  size_t num_lanes() const { return lanes_.size(); }
+  size_t num_edges() const { return out_edges_.size(); }
+  const LaneGraphLane& lane(uint32_t index) const { return lanes_[index]; }
+  double weight(uint32_t index) const { return weights_[index]; }
+  const std::vector<double>& weights() const { return weights_; }
+  const LaneGraphParam& param() const { return param_; }
+
+  const LaneEdge* out_begin(uint32_t index) const {
+    return out_edges_.data() + out_offsets_[index];
+  }
+  const LaneEdge* out_end(uint32_t index) const {
+    return out_edges_.data() + out_offsets_[index + 1];
+  }
+  const LaneEdge* in_begin(uint32_t index) const {
+    return in_edges_.data() + in_offsets_[index];
+  }
+  const LaneEdge* in_end(uint32_t index) const {
+    return in_edges_.data() + in_offsets_[index + 1];
+  }
+
+  // the cost of leaving lane from through edge
+  double cost(uint32_t from, LaneEdgeType type) const {
+    return LaneEdgeType::SUCCESSOR == type ? weights_[from]
+                                           : param_.lane_change_cost;
+  }
+
+ private:
+  LaneGraphParam param_;
+  LaneGraphLanes lanes_;
+  std::vector<double> weights_;
+  std::unordered_map<core::Id, uint32_t> index_;
+  std::vector<uint32_t> out_offsets_;
+  std::vector<LaneEdge> out_edges_;
+  std::vector<uint32_t> in_offsets_;
+  std::vector<LaneEdge> in_edges_;  // lane is the tail of the edge
+};
+
+}  // namespace route
+}  // namespace engine
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_ENGINE_ALGO_LANE_GRAPH_H_
@@ -6,6 +6,7 @@
 #include "cactus/cactus.h"
 #include "opendrive-engine/core/id.h"
 #include "opendrive-engine/core/lane.h"
+#include "opendrive-engine/core/projection.h"
 
 namespace opendrive {
 namespace engine {
@@ -15,6 +16,9 @@ core::Id GetLaneIdById(const core::Id& point_id);
 
 bool IsLineGeometry(core::Lane::ConstPtr lane);
 
+bool ProjectOntoCurve(const core::Curve& curve, double x, double y,
+                      core::LaneProjection& projection);
+
 }  // namespace common
 }  // namespace engine
 }  // namespace opendrive
@@ -0,0 +1,96 @@
+#ifndef OPENDRIVE_ENGINE_COMMON_COUNTER_H_
+#define OPENDRIVE_ENGINE_COMMON_COUNTER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace opendrive {
+namespace engine {
+namespace common {
+
+/**
+ * @class Counter
+ * @brief Monotonic counter split into per-thread cells. Writers only touch
+ *        their own cache line with a relaxed add, readers sum all cells, so
+ *        reading never blocks or slows down the writers.
+ */
+class Counter {
+ public:
+  Counter() = default;
+  Counter(const Counter&) = delete;
+  Counter& operator=(const Counter&) = delete;
+  void Add(uint64_t value = 1) {
+    cells_[Shard()].value.fetch_add(value, std::memory_order_relaxed);
+  }
+  uint64_t Value() const {
+    uint64_t sum = 0;
+    for (const auto& cell : cells_) {
+      sum += cell.value.load(std::memory_order_relaxed);
+    }
+    return sum;
+  }
+
+ private:
+  static constexpr size_t kShardNum = 16;
+  // padded rather than alignas(64): over-aligned new needs c++17
+  struct Cell {
+    std::atomic<uint64_t> value{0};
+    char padding[64 - sizeof(std::atomic<uint64_t>)];
+  };
+  static size_t Shard() {
+    static std::atomic<size_t> next_shard{0};
+    thread_local size_t shard =
+        next_shard.fetch_add(1, std::memory_order_relaxed) % kShardNum;
+    return shard;
+  }
+  Cell cells_[kShardNum];
+};
+
+/**
+ * @class LatencyCounter
+ * @brief Call count and accumulated latency of one kind of query.
+ */
+class LatencyCounter {
+ public:
+  // count queries that took nanoseconds together, e.g. a batch
+  void Record(uint64_t nanoseconds, uint64_t count = 1) {
+    count_.Add(count);
+    nanoseconds_.Add(nanoseconds);
+  }
+  uint64_t count() const { return count_.Value(); }
+  double seconds() const { return nanoseconds_.Value() * 1e-9; }
+
+ private:
+  Counter count_;
+  Counter nanoseconds_;
+};
+
+/**
+ * @class ScopedLatency
+ * @brief Records the lifetime of the scope into a LatencyCounter.
+ */
+class ScopedLatency {
+ public:
+  explicit ScopedLatency(LatencyCounter* counter)
+      : counter_(counter), start_(std::chrono::steady_clock::now()) {}
+  // record into another counter, nullptr records nothing
+  void set_counter(LatencyCounter* counter) { counter_ = counter; }
+  ~ScopedLatency() {
+    if (!counter_) return;
+    counter_->Record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::steady_clock::now() - start_)
+                         .count());
+  }
+
+ private:
+  LatencyCounter* counter_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace common
+}  // namespace engine
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_ENGINE_COMMON_COUNTER_H_
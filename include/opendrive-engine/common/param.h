@@ -1,6 +1,7 @@
 #ifndef OPENDRIVE_ENGINE_PARAM_H_
 #define OPENDRIVE_ENGINE_PARAM_H_
 
+#include <cstddef>
 #include <memory>
 #include <string>
 
@@ -11,9 +12,17 @@ namespace common {
 struct Param {
   typedef std::shared_ptr<Param> Ptr;
   typedef std::shared_ptr<Param const> ConstPtr;
-  Param() : map_file(""), step(0.5) {}
+  Param()
+      : map_file(""),
+        step(0.5),
+        query_cache_resolution(0),
+        query_cache_size(1 << 14) {}
   std::string map_file;
   float step;
+  // nearest lane queries within the same cell of this size share results,
+  // 0 disables the cache
+  double query_cache_resolution;
+  size_t query_cache_size;  // cache slots
 };
 
 }  // namespace common
@@ -0,0 +1,69 @@
+#ifndef OPENDRIVE_ENGINE_COMMON_QUERY_CACHE_H_
+#define OPENDRIVE_ENGINE_COMMON_QUERY_CACHE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace opendrive {
+namespace engine {
+namespace common {
+
+struct QueryCacheKey {
+  int64_t x;              // quantized position
+  int64_t y;
+  uint32_t k;             // number of results asked for
+  uint64_t eps;           // bit patterns of the search parameters, so
+  uint64_t max_distance;  // that only identical ones match
+};
+
+/**
+ * @class QueryCache
+ * @brief Fixed size, direct mapped cache of small query results. Every slot
+ *        is guarded by its own sequence lock: readers never block or
+ *        retry, a torn read is simply a miss, and a writer finding the slot
+ *        busy drops its entry instead of waiting. Entries carry the
+ *        version they were computed for and stop matching once it changes.
+ */
+class QueryCache {
+ public:
+  static constexpr size_t kMaxValues = 8;  // larger results are not cached
+
+  QueryCache() = default;
+  QueryCache(const QueryCache&) = delete;
+  QueryCache& operator=(const QueryCache&) = delete;
+
+  // not thread safe, slots are rounded up to a power of two, 0 disables;
+  // the entries survive if the slot count stays the same
+  void Init(size_t capacity);
+  size_t capacity() const { return capacity_; }
+
+  bool Lookup(const QueryCacheKey& key, uint64_t version,
+              uint32_t* const values, size_t* const count) const;
+  void Insert(const QueryCacheKey& key, uint64_t version,
+              const uint32_t* values, size_t count);
+
+ private:
+  struct Slot {
+    std::atomic<uint64_t> sequence{0};  // odd while being written
+    std::atomic<uint64_t> version{0};   // 0 never matches
+    std::atomic<int64_t> x{0};
+    std::atomic<int64_t> y{0};
+    std::atomic<uint64_t> eps{0};
+    std::atomic<uint64_t> max_distance{0};
+    std::atomic<uint32_t> k{0};
+    std::atomic<uint32_t> count{0};
+    std::atomic<uint32_t> values[kMaxValues];
+  };
+  size_t SlotIndex(const QueryCacheKey& key) const;
+
+  std::unique_ptr<Slot[]> slots_;
+  size_t capacity_ = 0;
+};
+
+}  // namespace common
+}  // namespace engine
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_ENGINE_COMMON_QUERY_CACHE_H_
@@ -0,0 +1,41 @@
+#ifndef OPENDRIVE_ENGINE_STATS_H_
+#define OPENDRIVE_ENGINE_STATS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace opendrive {
+namespace engine {
+namespace common {
+
+struct QueryStats {
+  QueryStats() : count(0), seconds(0) {}
+  uint64_t count;
+  double seconds;  // accumulated latency
+};
+
+struct Stats {
+  Stats()
+      : road_num(0),
+        section_num(0),
+        lane_num(0),
+        sample_num(0),
+        memory_bytes(0),
+        nearest_lanes_cache_misses(0) {}
+  size_t road_num;
+  size_t section_num;
+  size_t lane_num;
+  size_t sample_num;    // kdtree samples
+  size_t memory_bytes;  // estimated map storage
+  QueryStats nearest_points;
+  QueryStats nearest_lanes;
+  QueryStats nearest_lanes_cached;      // answered by the query cache
+  uint64_t nearest_lanes_cache_misses;  // looked up but not cached
+  QueryStats projection;
+};
+
+}  // namespace common
+}  // namespace engine
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_ENGINE_STATS_H_
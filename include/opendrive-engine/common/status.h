@@ -18,6 +18,7 @@ enum class ErrorCode {
   CONVERTOR_ERROR = 2000,
   CONVERTOR_XMLPARSE_ERROR,
   CONVERTOR_CENTERLANE_ERROR,
+  CONVERTOR_KDTREE_ERROR,
 };
 
 struct Status {
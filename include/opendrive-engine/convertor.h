@@ -3,14 +3,21 @@
 
 #include <cactus/cactus.h>
 
+#include <future>
 #include <memory>
 #include <string>
 
 #include "opendrive-cpp/geometry/element.h"
+#include "opendrive-engine/algo/bvh/road_index.h"
+#include "opendrive-engine/algo/bvh/segment_bvh.h"
 #include "opendrive-engine/algo/kdtree/kdtree.h"
+#include "opendrive-engine/algo/raster/distance_field.h"
+#include "opendrive-engine/algo/raster/drivable_raster.h"
+#include "opendrive-engine/algo/route/lane_graph.h"
 #include "opendrive-engine/common/log.h"
 #include "opendrive-engine/common/param.h"
 #include "opendrive-engine/common/status.h"
+#include "opendrive-engine/core/collision.h"
 #include "opendrive-engine/core/define.h"
 #include "opendrive-engine/core/lane.h"
 
@@ -27,6 +34,7 @@ class Convertor {
   inline bool Continue() const;
   void End();
   Convertor& ConvertHeader(element::Map::Ptr ele_map);
+  std::string ReadGeoReference(const std::string& map_file);
   Convertor& ConvertJunction(element::Map::Ptr ele_map);
   Convertor& ConvertJunctionAttr(const element::Junction& ele_junction,
                                  core::Junction::Ptr junction);
@@ -35,7 +43,21 @@ class Convertor {
                              core::Road::Ptr road);
   Convertor& ConvertSection(const element::Road& ele_road,
                             core::Road::Ptr road);
+  Convertor& BuildPolylines();
+  Convertor& BuildRoadIndex();
+  Convertor& BuildLaneGraph();
   Convertor& BuildKDTree();
+  Convertor& BuildEdgeBVH();
+  Convertor& BuildBoundaryBVH();
+  Convertor& BuildDrivableRaster();
+  Convertor& BuildDistanceField();
+  void AppendBoundarySegments(const core::Lane& lane, core::BoundarySide side,
+                              bool road_edge, bvh::Segments* const segments,
+                              bvh::SegmentIds* const ids,
+                              bvh::SegmentTags* const tags);
+  void AppendEdgeSegments(const core::Lane& lane, const core::Curve& edge,
+                          bvh::Segments* const segments,
+                          bvh::SegmentIds* const ids);
   void AppendKDTreeSample(const core::Curve::Point& point);
   void CenterLaneSampling(const element::Geometry::ConstPtrs& geometrys,
                           const element::LaneOffsets& lane_offsets,
@@ -51,6 +73,7 @@ class Convertor {
   common::Param::ConstPtr param_;
   core::Data::Ptr data_;
   core::Curve::Points center_line_pts_;
+  std::future<void> kdtree_build_;
 };
 
 }  // namespace engine
@@ -0,0 +1,88 @@
+#ifndef OPENDRIVE_ENGINE_CORE_COLLISION_H_
+#define OPENDRIVE_ENGINE_CORE_COLLISION_H_
+
+#include <opendrive-cpp/geometry/enums.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "id.h"
+
+namespace opendrive {
+namespace engine {
+namespace core {
+
+// road edges farther than this from a footprint are not searched for
+constexpr double kMaxTrajectoryMargin = 5.0;
+
+struct TrajectoryCollision {
+  TrajectoryCollision() : index(-1), margin(0), boundary_id("") {}
+  int index;       // first pose whose footprint leaves the driving lanes or
+                   // crosses a road edge, or that is reached from the
+                   // previous pose across either; -1 if none
+  double margin;   // smallest footprint to road edge distance up to index,
+                   // kMaxTrajectoryMargin if no edge is nearer
+  Id boundary_id;  // lane of the closest (or crossed) road edge, empty if
+                   // none is within kMaxTrajectoryMargin
+};
+
+// a lane's boundaries as sampled, counted from the road reference line:
+// INNER is Lane::left_boundary() and OUTER is Lane::right_boundary() on
+// either side of the road, so on left lanes (positive ids) INNER is the
+// right hand edge in the driving direction
+enum class BoundarySide : int { INNER = 0, OUTER = 1 };
+// tag bits of the segments in the boundary index
+constexpr uint32_t kBoundarySideTag = 1;  // the BoundarySide
+constexpr uint32_t kRoadEdgeTag = 2;      // on the outer edge of the road
+
+struct RaycastHit {
+  RaycastHit()
+      : hit(false),
+        distance(0),
+        x(0),
+        y(0),
+        lane_id(""),
+        side(BoundarySide::INNER) {}
+  bool hit;           // false if nothing is within range
+  double distance;    // from the ray origin to the hit point
+  double x;           // hit point
+  double y;
+  Id lane_id;         // lane owning the boundary that was hit
+  BoundarySide side;  // which boundary of that lane
+};
+typedef std::vector<RaycastHit> RaycastHits;
+
+struct NearestBoundary {
+  NearestBoundary()
+      : found(false),
+        distance(0),
+        x(0),
+        y(0),
+        lane_id(""),
+        side(BoundarySide::INNER),
+        type(RoadMarkType::NONE),
+        road_edge(false) {}
+  bool found;         // false if the map has no lane boundary
+  double distance;    // from the query point to the boundary
+  double x;           // nearest point on the boundary
+  double y;
+  Id lane_id;         // lane owning the boundary
+  BoundarySide side;  // which boundary of that lane
+  RoadMarkType type;  // road mark at the nearest point, NONE if unknown
+  bool road_edge;     // the boundary is an outer edge of its section
+};
+typedef std::vector<NearestBoundary> NearestBoundaries;
+
+struct EdgeDistance {
+  EdgeDistance() : distance(0), gradient_x(0), gradient_y(0) {}
+  double distance;    // to the nearest road edge, negative off the road
+  double gradient_x;  // of distance, points away from the edge on the road
+  double gradient_y;
+};
+typedef std::vector<EdgeDistance> EdgeDistances;
+
+}  // namespace core
+}  // namespace engine
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_ENGINE_CORE_COLLISION_H_
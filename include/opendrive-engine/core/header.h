@@ -19,6 +19,7 @@ class Header {
         version_(""),
         date_(""),
         vendor_(""),
+        geo_reference_(""),
         north_(0),
         south_(0),
         west_(0),
@@ -33,12 +34,14 @@ class Header {
   void set_west(double d) { west_ = d; }
   void set_east(double d) { east_ = d; }
   void set_vendor(const std::string& s) { vendor_ = s; }
+  void set_geo_reference(const std::string& s) { geo_reference_ = s; }
   std::string& mutable_rev_major() { return rev_major_; }
   std::string& mutable_rev_minor() { return rev_minor_; }
   std::string& mutable_version() { return version_; }
   std::string& mutable_name() { return name_; }
   std::string& mutable_date() { return date_; }
   std::string& mutable_vendor() { return vendor_; }
+  std::string& mutable_geo_reference() { return geo_reference_; }
   double& mutable_north() { return north_; }
   double& mutable_south() { return south_; }
   double& mutable_west() { return west_; }
@@ -49,6 +52,7 @@ class Header {
   const std::string& version() const { return version_; }
   const std::string& date() const { return date_; }
   const std::string& vendor() const { return vendor_; }
+  const std::string& geo_reference() const { return geo_reference_; }
   double north() const { return north_; }
   double south() const { return south_; }
   double west() const { return west_; }
@@ -61,6 +65,7 @@ class Header {
   std::string version_;
   std::string date_;
   std::string vendor_;
+  std::string geo_reference_;  // PROJ.4 string, empty if not given
   double north_;
   double south_;
   double west_;
@@ -9,6 +9,7 @@
 
 #include "id.h"
 #include "opendrive-engine/geometry/geometry.h"
+#include "opendrive-engine/geometry/polyline2d.h"
 
 namespace opendrive {
 namespace engine {
@@ -53,10 +54,19 @@ class Curve {
   double& mutable_length() { return length_; }
   const Line& pts() const { return pts_; }
   double length() const { return length_; }
+  // projection accelerator, stale until rebuilt after pts change
+  void BuildPolyline() {
+    std::vector<geometry::Vec2d> points;
+    points.reserve(pts_.size());
+    for (const auto& pt : pts_) points.emplace_back(pt.x(), pt.y());
+    polyline_ = geometry::Polyline2d(points);
+  }
+  const geometry::Polyline2d& polyline() const { return polyline_; }
 
  private:
   Line pts_;
   double length_ = 0;
+  geometry::Polyline2d polyline_;
 };
 
 class LaneBoundaryAttr {
@@ -135,9 +145,11 @@ class Lane {
   typedef std::shared_ptr<Lane const> ConstPtr;
   typedef std::vector<Ptr> Ptrs;
   typedef std::vector<ConstPtr> ConstPtrs;
-  Lane() : id_(""), parent_id_("") {}
+  typedef opendrive::LaneType Type;
+  Lane() : id_(""), parent_id_(""), type_(Type::NONE) {}
   void set_id(const Id& s) { id_ = s; }
   void set_parent_id(const Id& s) { parent_id_ = s; }
+  void set_type(Type t) { type_ = t; }
   void set_predecessor_ids(const Ids& v) { predecessor_ids_ = v; }
   void set_successor_ids(const Ids& v) { successor_ids_ = v; }
   void set_left_neighbor_lane_ids(const Ids& v) { left_neighbor_lane_ids_ = v; }
@@ -151,6 +163,7 @@ class Lane {
   void set_geometrys(const Geomotrys& v) { geometrys_ = v; }
   Id& mutable_id() { return id_; }
   Id& mutable_parent_id() { return parent_id_; }
+  Type& mutable_type() { return type_; }
   Ids& mutable_predecessor_ids() { return predecessor_ids_; }
   Ids& mutable_successor_ids() { return successor_ids_; }
   Curve& mutable_central_curve() { return central_curve_; }
@@ -160,6 +173,7 @@ class Lane {
   Geomotrys& mutable_geometrys() { return geometrys_; }
   const Id& id() const { return id_; }
   const Id& parent_id() const { return parent_id_; }
+  Type type() const { return type_; }
   const Ids& predecessor_ids() const { return predecessor_ids_; }
   const Ids& successor_ids() const { return successor_ids_; }
   const Ids& left_neighbor_lane_ids() const { return left_neighbor_lane_ids_; }
@@ -175,6 +189,7 @@ class Lane {
  private:
   Id id_;
   Id parent_id_;  // section id
+  Type type_;
   Ids predecessor_ids_;
   Ids successor_ids_;
   Ids left_neighbor_lane_ids_;
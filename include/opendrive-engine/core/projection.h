@@ -0,0 +1,26 @@
+#ifndef OPENDRIVE_ENGINE_CORE_PROJECTION_H_
+#define OPENDRIVE_ENGINE_CORE_PROJECTION_H_
+
+#include <vector>
+
+#include "id.h"
+
+namespace opendrive {
+namespace engine {
+namespace core {
+
+struct LaneProjection {
+  LaneProjection() : lane_id(""), s(0), l(0), heading(0), dist(0) {}
+  Id lane_id;
+  double s;        // arc length along the central curve
+  double l;        // lateral offset, left of the central curve is positive
+  double heading;  // heading of the central curve at s
+  double dist;     // not sqr
+};
+typedef std::vector<LaneProjection> LaneProjections;
+
+}  // namespace core
+}  // namespace engine
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_ENGINE_CORE_PROJECTION_H_
@@ -0,0 +1,24 @@
+#ifndef OPENDRIVE_ENGINE_CORE_ROUTING_H_
+#define OPENDRIVE_ENGINE_CORE_ROUTING_H_
+
+#include <vector>
+
+#include "id.h"
+
+namespace opendrive {
+namespace engine {
+namespace core {
+
+struct RoutingPath {
+  RoutingPath() : cost(0), length(0) {}
+  Path path;      // lane ids in driving order, start lane first
+  double cost;    // under the routing weights
+  double length;  // driven meters, lane changes add none
+};
+typedef std::vector<RoutingPath> RoutingPaths;
+
+}  // namespace core
+}  // namespace engine
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_ENGINE_CORE_ROUTING_H_
@@ -3,12 +3,18 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "opendrive-engine/common/param.h"
+#include "opendrive-engine/common/stats.h"
 #include "opendrive-engine/common/status.h"
+#include "opendrive-engine/core/collision.h"
 #include "opendrive-engine/core/id.h"
 #include "opendrive-engine/core/lane.h"
+#include "opendrive-engine/core/projection.h"
 #include "opendrive-engine/core/road.h"
+#include "opendrive-engine/core/routing.h"
 #include "opendrive-engine/core/section.h"
 #include "opendrive-engine/engine_impl.h"
 
@@ -32,6 +38,7 @@ class Engine {
   core::Section::ConstPtrs GetSections();
   core::Road::ConstPtrs GetRoads();
   core::Header::ConstPtr GetHeader();
+  common::Stats GetStats();
   template <typename T>
   kdtree::SearchResults GetNearestPoints(T x, T y, size_t num_closest) {
     return impl_->GetNearestPoints(static_cast<double>(x),
@@ -54,6 +61,112 @@ class Engine {
     return impl_->GetNearestLanes(query_point.x(), query_point.y(),
                                   num_closest);
   }
+  template <typename T>
+  std::vector<core::Lane::ConstPtrs> GetNearestLanes(
+      const std::vector<T>& query_points, size_t num_closest) {
+    std::vector<geometry::Point2D> points;
+    points.reserve(query_points.size());
+    for (const auto& query_point : query_points) {
+      points.emplace_back(query_point.x(), query_point.y());
+    }
+    return impl_->GetNearestLanes(points, num_closest);
+  }
+  // approximate and distance limited, for coarse candidate retrieval
+  template <typename T>
+  kdtree::SearchResults GetNearestPoints(T x, T y, size_t num_closest,
+                                         const kdtree::SearchParam& param) {
+    return impl_->GetNearestPoints(static_cast<double>(x),
+                                   static_cast<double>(y), num_closest, param);
+  }
+  template <typename T>
+  kdtree::SearchResults GetNearestPoints(const T& query_point,
+                                         size_t num_closest,
+                                         const kdtree::SearchParam& param) {
+    return impl_->GetNearestPoints(query_point.x(), query_point.y(),
+                                   num_closest, param);
+  }
+  template <typename T>
+  core::Lane::ConstPtrs GetNearestLanes(T x, T y, size_t num_closest,
+                                        const kdtree::SearchParam& param) {
+    return impl_->GetNearestLanes(static_cast<double>(x),
+                                  static_cast<double>(y), num_closest, param);
+  }
+  template <typename T>
+  core::Lane::ConstPtrs GetNearestLanes(const T& query_point,
+                                        size_t num_closest,
+                                        const kdtree::SearchParam& param) {
+    return impl_->GetNearestLanes(query_point.x(), query_point.y(),
+                                  num_closest, param);
+  }
+  template <typename T>
+  std::vector<core::Lane::ConstPtrs> GetNearestLanes(
+      const std::vector<T>& query_points, size_t num_closest,
+      const kdtree::SearchParam& param) {
+    std::vector<geometry::Point2D> points;
+    points.reserve(query_points.size());
+    for (const auto& query_point : query_points) {
+      points.emplace_back(query_point.x(), query_point.y());
+    }
+    return impl_->GetNearestLanes(points, num_closest, param);
+  }
+  // points in the frame of a vehicle at pose, e.g. a perception point cloud
+  std::vector<core::Lane::ConstPtrs> GetNearestLanes(
+      const geometry::Point4D& pose,
+      const std::vector<geometry::Point2D>& vehicle_points,
+      size_t num_closest);
+  // geodetic input needs a supported geoReference in the map header
+  std::vector<core::Lane::ConstPtrs> GetNearestLanes(
+      const std::vector<geometry::GeoPoint>& geo_points, size_t num_closest);
+  // nearest by distance to the lane central curves, a road or section is as
+  // near as its nearest lane
+  core::Road::ConstPtrs GetNearestRoads(double x, double y,
+                                        size_t num_closest);
+  core::Section::ConstPtrs GetNearestSections(double x, double y,
+                                              size_t num_closest);
+  core::LaneProjections GetNearestProjections(double x, double y,
+                                              size_t num_closest);
+  bool GetProjection(const core::Id& lane_id, double x, double y,
+                     core::LaneProjection& projection);
+  bool GetProjection(const core::Id& lane_id, const geometry::GeoPoint& geo,
+                     core::LaneProjection& projection);
+  bool GeodeticToMap(const std::vector<geometry::GeoPoint>& geo_points,
+                     std::vector<geometry::Point2D>& points);
+  bool MapToGeodetic(const std::vector<geometry::Point2D>& points,
+                     std::vector<geometry::GeoPoint>& geo_points);
+  bool CheckTrajectory(const std::vector<geometry::Point4D>& poses,
+                       double length, double width,
+                       core::TrajectoryCollision& collision);
+  bool Raycast(const geometry::Point2D& origin,
+               const geometry::Point2D& direction, double max_range,
+               core::RaycastHit& hit);
+  // one ray per heading, e.g. the beams of a 2-D lidar scan
+  bool Raycast(const geometry::Point2D& origin,
+               const std::vector<double>& headings, double max_range,
+               core::RaycastHits& hits);
+  // nearest lane boundary, batched for trajectories
+  bool GetNearestBoundary(double x, double y, core::NearestBoundary& boundary);
+  bool GetNearestBoundary(const std::vector<geometry::Point2D>& points,
+                          core::NearestBoundaries& boundaries);
+  // drivable lanes scan-converted into a grid covering window
+  bool RasterizeDrivable(const geometry::AABox2d& window, double resolution,
+                         raster::DrivableGrid& grid);
+  // signed distance to the road edges and its gradient, from a lazily
+  // tiled distance field
+  bool GetEdgeDistance(const std::vector<geometry::Point2D>& points,
+                       core::EdgeDistances& distances);
+  // the shortest route between two lane positions and up to num_routes - 1
+  // alternatives, s along the lane central curves; lanes connect where
+  // they meet geometrically
+  bool GetRoutes(const core::Id& from_lane, double from_s,
+                 const core::Id& to_lane, double to_s, size_t num_routes,
+                 core::RoutingPaths& paths);
+  // the shortest route only, from a customizable contraction hierarchy
+  bool GetRoute(const core::Id& from_lane, double from_s,
+                const core::Id& to_lane, double to_s, core::RoutingPath& path);
+  // new routing weights for some lanes, e.g. travel times from live traffic;
+  // routing queries keep answering on the previous weights until these are
+  // in place
+  bool SetLaneWeights(const std::unordered_map<core::Id, double>& weights);
 
  private:
   EngineImpl::Ptr impl_;
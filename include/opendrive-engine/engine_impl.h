@@ -4,17 +4,35 @@
 #include <cactus/cactus.h>
 #include <cactus/factory.h>
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "opendrive-cpp/common/status.h"
+#include "opendrive-engine/algo/bvh/road_index.h"
+#include "opendrive-engine/algo/bvh/segment_bvh.h"
 #include "opendrive-engine/algo/kdtree/kdtree.h"
+#include "opendrive-engine/algo/raster/distance_field.h"
+#include "opendrive-engine/algo/raster/drivable_raster.h"
+#include "opendrive-engine/algo/route/alternative_router.h"
+#include "opendrive-engine/algo/route/customizable_router.h"
+#include "opendrive-engine/algo/route/lane_graph.h"
 #include "opendrive-engine/common/common.h"
+#include "opendrive-engine/common/counter.h"
 #include "opendrive-engine/common/param.h"
+#include "opendrive-engine/common/query_cache.h"
+#include "opendrive-engine/common/stats.h"
 #include "opendrive-engine/convertor.h"
+#include "opendrive-engine/core/collision.h"
 #include "opendrive-engine/core/define.h"
 #include "opendrive-engine/core/header.h"
 #include "opendrive-engine/core/lane.h"
+#include "opendrive-engine/core/projection.h"
+#include "opendrive-engine/core/routing.h"
+#include "opendrive-engine/geometry/geometry.h"
+#include "opendrive-engine/geometry/transverse_mercator.h"
 
 namespace opendrive {
 namespace engine {
@@ -33,14 +51,107 @@ class EngineImpl {
   core::Section::ConstPtrs GetSections() const;
   core::Road::ConstPtrs GetRoads() const;
   core::Header::ConstPtr GetHeader() const;
-  kdtree::SearchResults GetNearestPoints(double x, double y,
-                                         size_t num_closest);
-  core::Lane::ConstPtrs GetNearestLanes(double x, double y, size_t num_closest);
+  kdtree::SearchResults GetNearestPoints(
+      double x, double y, size_t num_closest,
+      const kdtree::SearchParam& param = kdtree::SearchParam());
+  core::Lane::ConstPtrs GetNearestLanes(
+      double x, double y, size_t num_closest,
+      const kdtree::SearchParam& param = kdtree::SearchParam());
+  std::vector<core::Lane::ConstPtrs> GetNearestLanes(
+      const std::vector<geometry::Point2D>& points, size_t num_closest,
+      const kdtree::SearchParam& param = kdtree::SearchParam());
+  std::vector<core::Lane::ConstPtrs> GetNearestLanes(
+      const geometry::Point4D& pose,
+      const std::vector<geometry::Point2D>& vehicle_points,
+      size_t num_closest);
+  std::vector<core::Lane::ConstPtrs> GetNearestLanes(
+      const std::vector<geometry::GeoPoint>& geo_points, size_t num_closest);
+  core::Road::ConstPtrs GetNearestRoads(double x, double y,
+                                        size_t num_closest) const;
+  core::Section::ConstPtrs GetNearestSections(double x, double y,
+                                              size_t num_closest) const;
+  core::LaneProjections GetNearestProjections(double x, double y,
+                                              size_t num_closest) const;
+  bool GetProjection(const core::Id& lane_id, double x, double y,
+                     core::LaneProjection& projection) const;
+  bool GetProjection(const core::Id& lane_id, const geometry::GeoPoint& geo,
+                     core::LaneProjection& projection) const;
+  bool GeodeticToMap(const std::vector<geometry::GeoPoint>& geo_points,
+                     std::vector<geometry::Point2D>& points) const;
+  bool MapToGeodetic(const std::vector<geometry::Point2D>& points,
+                     std::vector<geometry::GeoPoint>& geo_points) const;
+  bool CheckTrajectory(const std::vector<geometry::Point4D>& poses,
+                       double length, double width,
+                       core::TrajectoryCollision& collision) const;
+  bool Raycast(const geometry::Point2D& origin,
+               const geometry::Point2D& direction, double max_range,
+               core::RaycastHit& hit) const;
+  bool Raycast(const geometry::Point2D& origin,
+               const std::vector<double>& headings, double max_range,
+               core::RaycastHits& hits) const;
+  bool GetNearestBoundary(double x, double y,
+                          core::NearestBoundary& boundary) const;
+  bool GetNearestBoundary(const std::vector<geometry::Point2D>& points,
+                          core::NearestBoundaries& boundaries) const;
+  bool RasterizeDrivable(const geometry::AABox2d& window, double resolution,
+                         raster::DrivableGrid& grid);
+  bool GetEdgeDistance(const std::vector<geometry::Point2D>& points,
+                       core::EdgeDistances& distances);
+  bool GetRoutes(const core::Id& from_lane, double from_s,
+                 const core::Id& to_lane, double to_s, size_t num_routes,
+                 core::RoutingPaths& paths) const;
+  bool GetRoute(const core::Id& from_lane, double from_s,
+                const core::Id& to_lane, double to_s,
+                core::RoutingPath& path) const;
+  bool SetLaneWeights(const std::unordered_map<core::Id, double>& weights);
+  common::Stats GetStats() const;
 
  private:
+  void CollectStats();
+  void BuildLaneTable();
+  bool NearestLanesKey(double x, double y, size_t num_closest,
+                       const kdtree::SearchParam& param,
+                       common::QueryCacheKey* const key) const;
+  bool LookupNearestLanes(const common::QueryCacheKey& key,
+                          core::Lane::ConstPtrs* const lanes) const;
+  void InsertNearestLanes(const common::QueryCacheKey& key,
+                          const core::Lane::ConstPtrs& lanes);
+  void LanesOf(const kdtree::SearchResults& results,
+               core::Lane::ConstPtrs* const lanes) const;
+  // the way between the centers of two poses crosses a road edge or leaves
+  // the driving lanes, sampled every step meters
+  bool LeavesDrivable(const geometry::Vec2d& from, const geometry::Vec2d& to,
+                      double step) const;
+  double DrivenS(int index, double s) const;
+  void ToRoutingPath(const route::Route& route,
+                     core::RoutingPath* const path) const;
+  void FillNearestBoundary(int index, const geometry::Vec2d& point,
+                           double distance,
+                           core::NearestBoundary* const boundary) const;
   core::Data::Ptr data_;
   common::Param::ConstPtr param_;
   kdtree::KDTree::Ptr kdtree_;
+  bvh::RoadIndex::Ptr road_index_;     // roads, sections and lane curves
+  route::LaneGraph::Ptr lane_graph_;   // driving lanes and their links
+  route::AlternativeRouter alternative_router_;
+  route::CustomizableRouter customizable_router_;  // holds the lane weights
+  bvh::SegmentBVH::Ptr edge_bvh_;      // road edges outside junctions
+  bvh::SegmentBVH::Ptr boundary_bvh_;  // both boundaries of every lane
+  raster::DrivableRaster::Ptr drivable_raster_;
+  raster::DistanceField::Ptr edge_distance_field_;  // built lazily per tile
+  geometry::TransverseMercator geo_projection_;
+  bool geo_referenced_;
+  common::Stats map_stats_;
+  uint64_t map_version_;  // bumped on every load, stale cache entries miss
+  // cached nearest lane results refer to lanes by their index in here
+  std::vector<core::Lane::ConstPtr> lane_table_;
+  std::unordered_map<const core::Lane*, uint32_t> lane_index_;
+  common::QueryCache nearest_lanes_cache_;
+  mutable common::Counter nearest_lanes_cache_misses_;
+  mutable common::LatencyCounter nearest_lanes_cached_latency_;
+  mutable common::LatencyCounter nearest_points_latency_;
+  mutable common::LatencyCounter nearest_lanes_latency_;
+  mutable common::LatencyCounter projection_latency_;
 };
 
 }  // namespace engine
@@ -0,0 +1,82 @@
+#ifndef OPENDRIVE_ENGINE_GEOMETRY_BOX2D_BATCH_H_
+#define OPENDRIVE_ENGINE_GEOMETRY_BOX2D_BATCH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "opendrive-engine/geometry/box2d.h"
+
+namespace opendrive {
+namespace engine {
+namespace geometry {
+
+/**
+ * @class Box2dBatch
+ * @brief A group of oriented boxes stored as one array per field (structure
+ *        of arrays) for batched collision checks, e.g. the footprints along a
+ *        candidate trajectory against the obstacles around it.
+ */
+class Box2dBatch {
+ public:
+  Box2dBatch() = default;
+
+  /**
+   * @brief Constructor which copies a vector of boxes.
+   * @param boxes The boxes to store.
+   */
+  explicit Box2dBatch(const std::vector<Box2d>& boxes);
+
+  void reserve(size_t size);
+  void clear();
+  void push_back(const Box2d& box);
+  size_t size() const { return center_x_.size(); }
+  bool empty() const { return center_x_.empty(); }
+  const double* center_x() const { return center_x_.data(); }
+  const double* center_y() const { return center_y_.data(); }
+  const double* cos_heading() const { return cos_heading_.data(); }
+  const double* sin_heading() const { return sin_heading_.data(); }
+  const double* half_length() const { return half_length_.data(); }
+  const double* half_width() const { return half_width_.data(); }
+  const double* min_x() const { return min_x_.data(); }
+  const double* max_x() const { return max_x_.data(); }
+  const double* min_y() const { return min_y_.data(); }
+  const double* max_y() const { return max_y_.data(); }
+
+  /**
+   * @brief Check every box of the batch against one box, with the same
+   *        result as Box2d::HasOverlap.
+   * @param box The box to check against.
+   * @param overlaps Output, 1 for the boxes overlapping the given box.
+   */
+  void HasOverlap(const Box2d& box, std::vector<uint8_t>* const overlaps) const;
+
+  /**
+   * @brief Find the first box of this batch that overlaps any box of others.
+   *        Boxes are checked in blocks in order, so the check stops at the
+   *        block of the first collision. Every block first runs an aabb test
+   *        against each other box and only runs the separating axis test for
+   *        the pairs whose aabbs overlap.
+   * @param others The boxes to check against, e.g. obstacles.
+   * @return The index of the first overlapping box, -1 if there is none.
+   */
+  int FirstOverlap(const Box2dBatch& others) const;
+
+ private:
+  std::vector<double> center_x_;
+  std::vector<double> center_y_;
+  std::vector<double> cos_heading_;
+  std::vector<double> sin_heading_;
+  std::vector<double> half_length_;
+  std::vector<double> half_width_;
+  std::vector<double> min_x_;
+  std::vector<double> max_x_;
+  std::vector<double> min_y_;
+  std::vector<double> max_y_;
+};
+
+}  // namespace geometry
+}  // namespace engine
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_ENGINE_GEOMETRY_BOX2D_BATCH_H_
@@ -52,6 +52,22 @@ class Point4D : public Point3D {
   double heading_;
 };
 
+class GeoPoint {
+ public:
+  GeoPoint() : lat_(0), lon_(0) {}
+  GeoPoint(double lat, double lon) : lat_(lat), lon_(lon) {}
+  void set_lat(double d) { lat_ = d; }
+  void set_lon(double d) { lon_ = d; }
+  double& mutable_lat() { return lat_; }
+  double& mutable_lon() { return lon_; }
+  double lat() const { return lat_; }
+  double lon() const { return lon_; }
+
+ private:
+  double lat_;  // degrees
+  double lon_;  // degrees
+};
+
 class Quaternion {
  public:
   Quaternion() : w_(0), x_(0), y_(0), z_(0) {}
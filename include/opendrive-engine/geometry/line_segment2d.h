@@ -1,6 +1,10 @@
 #ifndef OPENDRIVE_ENGINE_GEOMETRY_LINE_SEGMENT2D_H_
 #define OPENDRIVE_ENGINE_GEOMETRY_LINE_SEGMENT2D_H_
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
 #include "opendrive-engine/geometry/vec2d.h"
 #include "opendrive-engine/math/math.h"
 
@@ -185,6 +189,19 @@ class LineSegment2d {
   double GetPerpendicularFoot(const geometry::Vec2d& point,
                               geometry::Vec2d* const foot_point) const;
 
+  /**
+   * @brief Compute the squared distances from many points to the line
+   *        segment. The loop has no branches and is defined in this header,
+   *        so it vectorizes where it is called.
+   * @param x The x coordinates of the points.
+   * @param y The y coordinates of the points.
+   * @param size The number of points.
+   * @param distance_sqr Output, one squared distance per point. Must not
+   *        alias x or y.
+   */
+  void DistanceSquareTo(const double* __restrict x, const double* __restrict y,
+                        size_t size, double* __restrict distance_sqr) const;
+
  private:
   geometry::Vec2d start_;
   geometry::Vec2d end_;
@@ -193,6 +210,110 @@ class LineSegment2d {
   double length_;
 };
 
+// The distance kernels are defined here rather than in line_segment2d.cc so
+// they can be inlined into loops over many segments or points.
+
+inline LineSegment2d::LineSegment2d()
+    : unit_direction_(1, 0), heading_(0), length_(0) {}
+
+inline LineSegment2d::LineSegment2d(const geometry::Vec2d& start,
+                                    const geometry::Vec2d& end)
+    : start_(start), end_(end) {
+  const double dx = end_.x() - start_.x();
+  const double dy = end_.y() - start_.y();
+  length_ = std::hypot(dx, dy);
+  unit_direction_ =
+      (length_ <= 1e-10 ? geometry::Vec2d(0, 0)
+                        : geometry::Vec2d(dx / length_, dy / length_));
+  heading_ = unit_direction_.Angle();
+}
+
+inline double LineSegment2d::length() const { return length_; }
+
+inline double LineSegment2d::length_sqr() const { return length_ * length_; }
+
+inline double LineSegment2d::DistanceTo(const geometry::Vec2d& point) const {
+  if (length_ <= 1e-10) {
+    return point.DistanceTo(start_);
+  }
+  const double x0 = point.x() - start_.x();
+  const double y0 = point.y() - start_.y();
+  const double proj = x0 * unit_direction_.x() + y0 * unit_direction_.y();
+  if (proj <= 0.0) {
+    return std::hypot(x0, y0);
+  }
+  if (proj >= length_) {
+    return point.DistanceTo(end_);
+  }
+  return std::abs(x0 * unit_direction_.y() - y0 * unit_direction_.x());
+}
+
+inline double LineSegment2d::DistanceSquareTo(
+    const geometry::Vec2d& point) const {
+  if (length_ <= 1e-10) {
+    return point.DistanceSquareTo(start_);
+  }
+  const double x0 = point.x() - start_.x();
+  const double y0 = point.y() - start_.y();
+  const double proj = x0 * unit_direction_.x() + y0 * unit_direction_.y();
+  if (proj <= 0.0) {
+    return math::Square(x0) + math::Square(y0);
+  }
+  if (proj >= length_) {
+    return point.DistanceSquareTo(end_);
+  }
+  return math::Square(x0 * unit_direction_.y() - y0 * unit_direction_.x());
+}
+
+inline double LineSegment2d::ProjectOntoUnit(
+    const geometry::Vec2d& point) const {
+  return unit_direction_.InnerProd(point - start_);
+}
+
+inline double LineSegment2d::ProductOntoUnit(
+    const geometry::Vec2d& point) const {
+  return unit_direction_.CrossProd(point - start_);
+}
+
+namespace internal {
+
+inline void SegmentDistanceSquare(const double start_x, const double start_y,
+                                  const double unit_x, const double unit_y,
+                                  const double length,
+                                  const double* __restrict x,
+                                  const double* __restrict y, size_t size,
+                                  double* __restrict distance_sqr) {
+  for (size_t i = 0; i < size; ++i) {
+    const double x0 = x[i] - start_x;
+    const double y0 = y[i] - start_y;
+    // a degenerate segment has a zero unit direction, so t is 0 there
+    const double t =
+        std::max(0.0, std::min(length, x0 * unit_x + y0 * unit_y));
+    const double dx = x0 - t * unit_x;
+    const double dy = y0 - t * unit_y;
+    distance_sqr[i] = dx * dx + dy * dy;
+  }
+}
+
+}  // namespace internal
+
+inline void LineSegment2d::DistanceSquareTo(
+    const double* __restrict x, const double* __restrict y, size_t size,
+    double* __restrict distance_sqr) const {
+  // gcc only vectorizes loops with a constant trip count at -O2, so full
+  // blocks run first and the tail is handled on its own
+  constexpr size_t kBlock = 8;
+  size_t i = 0;
+  for (; i + kBlock <= size; i += kBlock) {
+    internal::SegmentDistanceSquare(start_.x(), start_.y(), unit_direction_.x(),
+                                    unit_direction_.y(), length_, x + i, y + i,
+                                    kBlock, distance_sqr + i);
+  }
+  internal::SegmentDistanceSquare(start_.x(), start_.y(), unit_direction_.x(),
+                                  unit_direction_.y(), length_, x + i, y + i,
+                                  size - i, distance_sqr + i);
+}
+
 }  // namespace geometry
 }  // namespace engine
 }  // namespace opendrive
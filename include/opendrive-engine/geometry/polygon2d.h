@@ -1,8 +1,13 @@
 #ifndef OPENDRIVE_ENGINE_GEOMETRY_POLYGON2D_H_
 #define OPENDRIVE_ENGINE_GEOMETRY_POLYGON2D_H_
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
 #include "opendrive-engine/geometry/box2d.h"
 #include "opendrive-engine/geometry/vec2d.h"
+#include "opendrive-engine/geometry/vec2d_batch.h"
 #include "opendrive-engine/math/math.h"
 
 namespace opendrive {
@@ -112,7 +117,8 @@ class Polygon2d {
    with
    *        this polygon, return 0. Otherwise, this distance is
    *        the minimal distance among the distances from the edges
-   *        of the other polygon to this polygon.
+   *        of the other polygon to this polygon. When both polygons are
+   *        convex it is computed with GJK instead of the edge loop.
    * @param polygon The polygon to compute whose distance to this polygon.
    * @return The distance from the other polygon to this polygon.
    */
@@ -136,6 +142,26 @@ class Polygon2d {
    */
   bool IsPointIn(const geometry::Vec2d& point) const;
 
+  /**
+   * @brief Check if many points are within the polygon. Points are handled
+   *        in blocks against one edge at a time, without branches, which is
+   *        much faster than calling IsPointIn for each point.
+   * @param points The target points.
+   * @param inside Output, 1 for the points within the polygon (boundary
+   *        included), 0 otherwise.
+   */
+  void IsPointIn(const Vec2dBatch& points,
+                 std::vector<uint8_t>* const inside) const;
+
+  /**
+   * @brief Compute the distance from many points to the polygon, the batched
+   *        version of DistanceTo(const Vec2d&).
+   * @param points The target points.
+   * @param distances Output, 0 for the points within the polygon.
+   */
+  void DistanceTo(const Vec2dBatch& points,
+                  std::vector<double>* const distances) const;
+
   /**
    * @brief Check if a point is on the boundary of the polygon.
    * @param point The target point. To check if it is on the boundary
@@ -308,6 +334,15 @@ class Polygon2d {
   int Prev(int at) const;
   static bool ClipConvexHull(const LineSegment2d& line_segment,
                              std::vector<geometry::Vec2d>* const points);
+  /**
+   * @brief GJK distance between two convex polygons, 0 when they overlap.
+   * @param polygon The other convex polygon.
+   * @param stop_distance Returns as soon as the distance is known to be
+   *        larger, the result is then only a lower bound.
+   * @return The distance between the polygons.
+   */
+  double ConvexDistanceTo(const Polygon2d& polygon,
+                          const double stop_distance) const;
   std::vector<LineSegment2d> line_segments_;
   std::vector<geometry::Vec2d> points_;
   int num_points_;
@@ -0,0 +1,150 @@
+#ifndef OPENDRIVE_ENGINE_GEOMETRY_POLYLINE2D_H_
+#define OPENDRIVE_ENGINE_GEOMETRY_POLYLINE2D_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "opendrive-engine/geometry/vec2d.h"
+
+namespace opendrive {
+namespace engine {
+namespace geometry {
+
+/**
+ * @class Polyline2d
+ * @brief An open polyline in 2-D, e.g. a sampled lane center or boundary.
+ *        Segments are stored as structure of arrays together with the arc
+ *        length at every point, and covered by a small hierarchy of
+ *        axis-aligned boxes over consecutive segment ranges, so that
+ *        projection and s lookup take O(log n).
+ */
+class Polyline2d {
+ public:
+  /**
+   * @brief Empty constructor.
+   */
+  Polyline2d() = default;
+
+  /**
+   * @brief Constructor which takes the points of the polyline in order.
+   * @param points The points of the polyline.
+   */
+  explicit Polyline2d(const std::vector<Vec2d>& points);
+
+  /**
+   * @brief Get the number of points.
+   * @return The number of points.
+   */
+  size_t num_points() const { return x_.size(); }
+
+  /**
+   * @brief Get the number of segments, one less than the points.
+   * @return The number of segments.
+   */
+  size_t num_segments() const { return length_.size(); }
+
+  /**
+   * @brief Get the total arc length.
+   * @return The length of the polyline.
+   */
+  double length() const { return s_.empty() ? 0.0 : s_.back(); }
+
+  /**
+   * @brief Get a point of the polyline.
+   * @param index The index of the point.
+   * @return The point.
+   */
+  Vec2d point(size_t index) const { return Vec2d(x_[index], y_[index]); }
+
+  /**
+   * @brief Get the arc length at a point of the polyline.
+   * @param index The index of the point.
+   * @return The arc length from the first point.
+   */
+  double s(size_t index) const { return s_[index]; }
+
+  /**
+   * @brief Project a point onto the polyline. The segment nearest to the
+   *        point is used, the first one on ties.
+   * @param point The point to project.
+   * @param accumulate_s Output, the arc length of the projection, clamped
+   *        to [0, length()].
+   * @param lateral Output, the signed distance to the line through the
+   *        nearest segment, left is positive.
+   * @param distance Output if not nullptr, the distance to the polyline.
+   * @return The index of the nearest segment, -1 if the polyline has less
+   *         than two points or none is found, e.g. for a NaN point.
+   */
+  int GetProjection(const Vec2d& point, double* const accumulate_s,
+                    double* const lateral,
+                    double* const distance = nullptr) const;
+
+  /**
+   * @brief Compute the shortest distance from a point to the polyline.
+   * @param point The point to compute the distance to.
+   * @param nearest_pt Output if not nullptr, the nearest point on the
+   *        polyline.
+   * @return The distance, infinity if the polyline has no point or no
+   *         nearest segment is found, e.g. for a NaN point.
+   */
+  double DistanceTo(const Vec2d& point,
+                    Vec2d* const nearest_pt = nullptr) const;
+
+  /**
+   * @brief Get the index of the segment containing an arc length.
+   * @param s The arc length, clamped to [0, length()].
+   * @return The index of the segment, -1 if there is no segment.
+   */
+  int GetSegmentIndex(double s) const;
+
+  /**
+   * @brief Get the point at an arc length by linear interpolation.
+   * @param s The arc length, clamped to [0, length()].
+   * @return The point at s.
+   */
+  Vec2d GetPoint(double s) const;
+
+  /**
+   * @brief Get the heading of the segment at an arc length.
+   * @param s The arc length, clamped to [0, length()].
+   * @return The heading of the segment containing s.
+   */
+  double GetHeading(double s) const;
+
+  /**
+   * @brief Get the lateral offset of a point, see GetProjection.
+   * @param point The point.
+   * @return The signed lateral offset, left is positive.
+   */
+  double GetLateral(const Vec2d& point) const;
+
+ private:
+  struct Node {
+    double min_x;
+    double min_y;
+    double max_x;
+    double max_y;
+    uint32_t begin;  // leaf: first segment, inner: index of the right child
+    uint32_t end;    // leaf: one past the last segment, 0 for inner nodes
+  };
+  uint32_t Build(uint32_t begin, uint32_t end);
+  void NearestSegment(const Vec2d& point, int* const index,
+                      double* const distance_sqr) const;
+
+  // points
+  std::vector<double> x_;
+  std::vector<double> y_;
+  std::vector<double> s_;  // arc length at each point
+  // segments
+  std::vector<double> unit_x_;  // zero for degenerate segments
+  std::vector<double> unit_y_;
+  std::vector<double> length_;
+  std::vector<Node> nodes_;  // depth first, the left child follows its parent
+};
+
+}  // namespace geometry
+}  // namespace engine
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_ENGINE_GEOMETRY_POLYLINE2D_H_
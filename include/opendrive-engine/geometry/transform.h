@@ -0,0 +1,263 @@
+#ifndef OPENDRIVE_ENGINE_GEOMETRY_TRANSFORM_H_
+#define OPENDRIVE_ENGINE_GEOMETRY_TRANSFORM_H_
+
+#include <cstddef>
+
+#include "opendrive-engine/geometry/euler_angles_zxy.h"
+#include "opendrive-engine/geometry/geometry.h"
+#include "opendrive-engine/geometry/vec2d.h"
+#include "opendrive-engine/geometry/vec2d_batch.h"
+
+namespace opendrive {
+namespace engine {
+namespace geometry {
+
+/**
+ * @class Transform2d
+ * @brief A rigid transform in the plane, a rotation by heading followed by
+ *        a translation. Built from a vehicle pose it maps points from the
+ *        vehicle frame to the map frame.
+ */
+class Transform2d {
+ public:
+  /**
+   * @brief Constructs the identity transform.
+   */
+  constexpr Transform2d() : cos_(1), sin_(0), x_(0), y_(0) {}
+
+  /**
+   * @brief Constructor which takes the translation and the rotation.
+   * @param x The x translation.
+   * @param y The y translation.
+   * @param heading The rotation angle, counter-clockwise.
+   */
+  Transform2d(double x, double y, double heading);
+
+  /**
+   * @brief Constructs the transform from a pose frame to the frame the pose
+   *        is given in.
+   * @param pose The pose, z is ignored.
+   */
+  explicit Transform2d(const Point4D& pose);
+
+  double x() const { return x_; }
+  double y() const { return y_; }
+  double cos_heading() const { return cos_; }
+  double sin_heading() const { return sin_; }
+
+  /**
+   * @brief Get the inverse transform, e.g. from map to vehicle frame.
+   * @return The inverse transform.
+   */
+  Transform2d Inverse() const;
+
+  /**
+   * @brief Compose two transforms, the right one is applied first.
+   * @param other The transform applied first.
+   * @return The composed transform.
+   */
+  Transform2d operator*(const Transform2d& other) const;
+
+  /**
+   * @brief Transform one point.
+   * @param point The point to transform.
+   * @return The transformed point.
+   */
+  Vec2d Apply(const Vec2d& point) const {
+    return Vec2d(cos_ * point.x() - sin_ * point.y() + x_,
+                 sin_ * point.x() + cos_ * point.y() + y_);
+  }
+
+  /**
+   * @brief Transform points stored as structure of arrays. The output may
+   *        be the input itself, but must not partially overlap it.
+   * @param x The x coordinates.
+   * @param y The y coordinates.
+   * @param size The number of points.
+   * @param out_x Output, the transformed x coordinates.
+   * @param out_y Output, the transformed y coordinates.
+   */
+  void Apply(const double* x, const double* y, size_t size,
+             double* __restrict out_x, double* __restrict out_y) const;
+
+  /**
+   * @brief Transform a batch of points in place.
+   * @param points The points to transform.
+   */
+  void Apply(Vec2dBatch* const points) const {
+    Apply(points->x(), points->y(), points->size(), points->mutable_x(),
+          points->mutable_y());
+  }
+
+ private:
+  double cos_;
+  double sin_;
+  double x_;
+  double y_;
+};
+
+/**
+ * @class Transform3d
+ * @brief A rigid transform in space, a rotation given by a quaternion or
+ *        EulerAnglesZXY followed by a translation. The rotation is kept as
+ *        a matrix, so transforming a point costs nine multiplications.
+ */
+class Transform3d {
+ public:
+  /**
+   * @brief Constructs the identity transform.
+   */
+  Transform3d();
+
+  /**
+   * @brief Constructor which takes the rotation as a quaternion, it does
+   *        not need to be normalized.
+   * @param rotation The rotation.
+   * @param translation The translation.
+   */
+  Transform3d(const Quaternion& rotation, const Point3D& translation);
+
+  /**
+   * @brief Constructor which takes the rotation as euler angles.
+   * @param rotation The rotation.
+   * @param translation The translation.
+   */
+  Transform3d(const EulerAnglesZXY& rotation, const Point3D& translation);
+
+  /**
+   * @brief Get an element of the rotation matrix.
+   * @param row The row, 0 to 2.
+   * @param col The column, 0 to 2.
+   * @return The element.
+   */
+  double rotation(size_t row, size_t col) const { return r_[row * 3 + col]; }
+  const Point3D& translation() const { return t_; }
+
+  /**
+   * @brief Get the inverse transform.
+   * @return The inverse transform.
+   */
+  Transform3d Inverse() const;
+
+  /**
+   * @brief Compose two transforms, the right one is applied first.
+   * @param other The transform applied first.
+   * @return The composed transform.
+   */
+  Transform3d operator*(const Transform3d& other) const;
+
+  /**
+   * @brief Transform one point.
+   * @param point The point to transform.
+   * @return The transformed point.
+   */
+  Point3D Apply(const Point3D& point) const {
+    return Point3D(
+        r_[0] * point.x() + r_[1] * point.y() + r_[2] * point.z() + t_.x(),
+        r_[3] * point.x() + r_[4] * point.y() + r_[5] * point.z() + t_.y(),
+        r_[6] * point.x() + r_[7] * point.y() + r_[8] * point.z() + t_.z());
+  }
+
+  /**
+   * @brief Transform points stored as structure of arrays. The output may
+   *        be the input itself, but must not partially overlap it.
+   * @param x The x coordinates.
+   * @param y The y coordinates.
+   * @param z The z coordinates.
+   * @param size The number of points.
+   * @param out_x Output, the transformed x coordinates.
+   * @param out_y Output, the transformed y coordinates.
+   * @param out_z Output, the transformed z coordinates.
+   */
+  void Apply(const double* x, const double* y, const double* z, size_t size,
+             double* __restrict out_x, double* __restrict out_y,
+             double* __restrict out_z) const;
+
+ private:
+  double r_[9];  // row major rotation matrix
+  Point3D t_;
+};
+
+namespace internal {
+
+// the input block is copied first, so the output may alias the input
+constexpr size_t kTransformBlock = 8;
+
+inline void TransformBlock2d(const double cos_heading, const double sin_heading,
+                             const double tx, const double ty,
+                             const double* x, const double* y, size_t size,
+                             double* __restrict out_x,
+                             double* __restrict out_y) {
+  double bx[kTransformBlock];
+  double by[kTransformBlock];
+  for (size_t i = 0; i < size; ++i) {
+    bx[i] = x[i];
+    by[i] = y[i];
+  }
+  for (size_t i = 0; i < size; ++i) {
+    out_x[i] = cos_heading * bx[i] - sin_heading * by[i] + tx;
+    out_y[i] = sin_heading * bx[i] + cos_heading * by[i] + ty;
+  }
+}
+
+inline void TransformBlock3d(const double* __restrict r, const Point3D& t,
+                             const double* x, const double* y,
+                             const double* z, size_t size,
+                             double* __restrict out_x,
+                             double* __restrict out_y,
+                             double* __restrict out_z) {
+  double bx[kTransformBlock];
+  double by[kTransformBlock];
+  double bz[kTransformBlock];
+  for (size_t i = 0; i < size; ++i) {
+    bx[i] = x[i];
+    by[i] = y[i];
+    bz[i] = z[i];
+  }
+  const double tx = t.x();
+  const double ty = t.y();
+  const double tz = t.z();
+  for (size_t i = 0; i < size; ++i) {
+    out_x[i] = r[0] * bx[i] + r[1] * by[i] + r[2] * bz[i] + tx;
+    out_y[i] = r[3] * bx[i] + r[4] * by[i] + r[5] * bz[i] + ty;
+    out_z[i] = r[6] * bx[i] + r[7] * by[i] + r[8] * bz[i] + tz;
+  }
+}
+
+}  // namespace internal
+
+inline void Transform2d::Apply(const double* x, const double* y, size_t size,
+                               double* __restrict out_x,
+                               double* __restrict out_y) const {
+  // gcc only vectorizes loops with a constant trip count at -O2, so full
+  // blocks run first and the tail is handled on its own
+  constexpr size_t kBlock = internal::kTransformBlock;
+  size_t i = 0;
+  for (; i + kBlock <= size; i += kBlock) {
+    internal::TransformBlock2d(cos_, sin_, x_, y_, x + i, y + i, kBlock,
+                               out_x + i, out_y + i);
+  }
+  internal::TransformBlock2d(cos_, sin_, x_, y_, x + i, y + i, size - i,
+                             out_x + i, out_y + i);
+}
+
+inline void Transform3d::Apply(const double* x, const double* y,
+                               const double* z, size_t size,
+                               double* __restrict out_x,
+                               double* __restrict out_y,
+                               double* __restrict out_z) const {
+  constexpr size_t kBlock = internal::kTransformBlock;
+  size_t i = 0;
+  for (; i + kBlock <= size; i += kBlock) {
+    internal::TransformBlock3d(r_, t_, x + i, y + i, z + i, kBlock, out_x + i,
+                               out_y + i, out_z + i);
+  }
+  internal::TransformBlock3d(r_, t_, x + i, y + i, z + i, size - i, out_x + i,
+                             out_y + i, out_z + i);
+}
+
+}  // namespace geometry
+}  // namespace engine
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_ENGINE_GEOMETRY_TRANSFORM_H_
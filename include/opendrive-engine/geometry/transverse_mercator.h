@@ -0,0 +1,118 @@
+#ifndef OPENDRIVE_ENGINE_GEOMETRY_TRANSVERSE_MERCATOR_H_
+#define OPENDRIVE_ENGINE_GEOMETRY_TRANSVERSE_MERCATOR_H_
+
+#include <cstddef>
+#include <string>
+
+namespace opendrive {
+namespace engine {
+namespace geometry {
+
+/**
+ * @class TransverseMercator
+ * @brief Transverse Mercator projection of an ellipsoid using Krueger's
+ *        series to sixth order in the third flattening (Karney 2011), which
+ *        is accurate to a few nanometers within 3900 km of the central
+ *        meridian. Latitudes and longitudes are in degrees.
+ */
+class TransverseMercator {
+ public:
+  /**
+   * @brief Constructs a projection of the WGS84 ellipsoid centered at
+   *        (0, 0) with unit scale.
+   */
+  TransverseMercator();
+
+  /**
+   * @brief Set up the projection from an OpenDRIVE geoReference, a PROJ.4
+   *        string. "+proj=tmerc" and "+proj=utm" are supported together
+   *        with +lat_0, +lon_0, +k/+k_0, +x_0, +y_0, +zone, +south, +a,
+   *        +rf/+f and +ellps/+datum WGS84 or GRS80. A string without +proj
+   *        is read as tmerc.
+   * @param geo_reference The PROJ.4 string.
+   * @return False if the projection is not supported, the projection is
+   *         left unchanged.
+   */
+  bool Init(const std::string& geo_reference);
+
+  /**
+   * @brief Set up the projection from its parameters.
+   * @param lat0 The latitude of origin.
+   * @param lon0 The central meridian.
+   * @param k0 The scale on the central meridian.
+   * @param false_easting Added to x.
+   * @param false_northing Added to y.
+   * @param a The equatorial radius in meters.
+   * @param f The flattening.
+   */
+  void Init(double lat0, double lon0, double k0, double false_easting,
+            double false_northing, double a, double f);
+
+  /**
+   * @brief Project a geodetic position.
+   * @param lat The latitude.
+   * @param lon The longitude.
+   * @param x Output, the easting.
+   * @param y Output, the northing.
+   */
+  void Forward(double lat, double lon, double* const x, double* const y) const;
+
+  /**
+   * @brief Project geodetic positions stored as structure of arrays.
+   * @param lat The latitudes.
+   * @param lon The longitudes.
+   * @param size The number of positions.
+   * @param x Output, the eastings.
+   * @param y Output, the northings.
+   */
+  void Forward(const double* lat, const double* lon, size_t size,
+               double* const x, double* const y) const;
+
+  /**
+   * @brief Recover the geodetic position of a projected point.
+   * @param x The easting.
+   * @param y The northing.
+   * @param lat Output, the latitude.
+   * @param lon Output, the longitude.
+   */
+  void Inverse(double x, double y, double* const lat,
+               double* const lon) const;
+
+  /**
+   * @brief Recover geodetic positions stored as structure of arrays.
+   * @param x The eastings.
+   * @param y The northings.
+   * @param size The number of points.
+   * @param lat Output, the latitudes.
+   * @param lon Output, the longitudes.
+   */
+  void Inverse(const double* x, const double* y, size_t size,
+               double* const lat, double* const lon) const;
+
+  double lat0() const { return lat0_; }
+  double lon0() const { return lon0_; }
+  double k0() const { return k0_; }
+
+ private:
+  static constexpr int kOrder = 6;
+  // the conformal latitude of a geodetic one, as tangents
+  double ConformalTau(double tau) const;
+
+  double lat0_;
+  double lon0_;
+  double k0_;
+  double false_easting_;
+  double false_northing_;
+  double e_;    // eccentricity
+  double e2m_;  // 1 - e^2
+  double a1_;   // rectifying radius scaled by k0
+  double y0_;   // scaled meridian distance of lat0 less the false northing
+  double alpha_[kOrder + 1];  // forward series, index 0 unused
+  double beta_[kOrder + 1];   // inverse series, index 0 unused
+};
+
+}  // namespace geometry
+}  // namespace engine
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_ENGINE_GEOMETRY_TRANSVERSE_MERCATOR_H_
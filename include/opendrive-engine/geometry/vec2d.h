@@ -1,104 +1,146 @@
 #ifndef OPENDRIVE_ENGINE_GEOMETRY_VEC2D_H_
 #define OPENDRIVE_ENGINE_GEOMETRY_VEC2D_H_
 
+#include <cmath>
+
 #include "opendrive-engine/math/math.h"
 
 namespace opendrive {
 namespace engine {
 namespace geometry {
 
+// Header only so that loops over points inline and vectorize at the call
+// site; everything without a libm call is constexpr.
 class Vec2d {
  public:
-  Vec2d() : x_(0), y_(0) {}
-  Vec2d(double x, double y) : x_(x), y_(y) {}
-  void set_x(double x) { x_ = x; }
-  void set_y(double y) { y_ = y; }
-  double& mutable_x() { return x_; }
-  double& mutable_y() { return y_; }
-  double x() const { return x_; }
-  double y() const { return y_; }
+  constexpr Vec2d() : x_(0), y_(0) {}
+  constexpr Vec2d(double x, double y) : x_(x), y_(y) {}
+  constexpr void set_x(double x) { x_ = x; }
+  constexpr void set_y(double y) { y_ = y; }
+  constexpr double& mutable_x() { return x_; }
+  constexpr double& mutable_y() { return y_; }
+  constexpr double x() const { return x_; }
+  constexpr double y() const { return y_; }
 
   //! Creates a unit-vector with a given angle to the positive x semi-axis
-  static Vec2d CreateUnitVec2d(double angle);
+  static Vec2d CreateUnitVec2d(double angle) {
+    return Vec2d(std::cos(angle), std::sin(angle));
+  }
 
   //! Gets the length of the vector
-  double Length() const;
+  double Length() const { return std::hypot(x_, y_); }
 
   //! Gets the squared length of the vector
-  double LengthSquare() const;
+  constexpr double LengthSquare() const { return x_ * x_ + y_ * y_; }
 
   //! Gets the angle between the vector and the positive x semi-axis
-  double Angle() const;
+  double Angle() const { return std::atan2(y_, x_); }
 
   //! Returns the unit vector that is co-linear with this vector
-  void Normalize();
+  void Normalize() {
+    const double l = Length();
+    if (l > 1e-10) {
+      x_ /= l;
+      y_ /= l;
+    }
+  }
 
   //! Returns the distance to the given vector
-  double DistanceTo(const Vec2d& other) const;
+  double DistanceTo(const Vec2d& other) const {
+    return std::hypot(x_ - other.x_, y_ - other.y_);
+  }
 
   //! Returns the squared distance to the given vector
-  double DistanceSquareTo(const Vec2d& other) const;
+  constexpr double DistanceSquareTo(const Vec2d& other) const {
+    return (x_ - other.x_) * (x_ - other.x_) +
+           (y_ - other.y_) * (y_ - other.y_);
+  }
 
   //! Returns the "cross" product between these two Vec2d (non-standard).
-  double CrossProd(const Vec2d& other) const;
-
-  /**
-   * @brief Cross product between two 2-D vectors from the common start point,
-   *        and end at two other points.
-   * @param end_point_1 The end point of the first vector.
-   * @param end_point_2 The end point of the second vector.
-   *
-   * @return The cross product result.
-   */
-  double CrossProd(const Vec2d& end_point_1, const Vec2d& end_point_2) const;
-
-  /**
-   * @brief Cross product between two 2-D vectors from the common start point,
-   *        and end at two other points.
-   * @param start_point The common start point of two vectors in 2-D.
-   * @param end_point_1 The end point of the first vector.
-   * @param end_point_2 The end point of the second vector.
-   *
-   * @return The cross product result.
-   */
-  static double CrossProd(const Vec2d& start_point, const Vec2d& end_point_1,
-                          const Vec2d& end_point_2);
+  constexpr double CrossProd(const Vec2d& other) const {
+    return x_ * other.y_ - y_ * other.x_;
+  }
+
+  constexpr double CrossProd(const Vec2d& end_point_1,
+                             const Vec2d& end_point_2) const {
+    return (end_point_1 - *this).CrossProd(end_point_2 - *this);
+  }
+
+  static constexpr double CrossProd(const Vec2d& start_point,
+                                    const Vec2d& end_point_1,
+                                    const Vec2d& end_point_2) {
+    return (end_point_1 - start_point).CrossProd(end_point_2 - start_point);
+  }
 
   //! Returns the inner product between these two Vec2d.
-  double InnerProd(const Vec2d& other) const;
+  constexpr double InnerProd(const Vec2d& other) const {
+    return x_ * other.x_ + y_ * other.y_;
+  }
 
   //! rotate the vector by angle.
-  Vec2d Rotate(double angle) const;
+  Vec2d Rotate(double angle) const {
+    const double cos_angle = std::cos(angle);
+    const double sin_angle = std::sin(angle);
+    return Vec2d(x_ * cos_angle - y_ * sin_angle,
+                 x_ * sin_angle + y_ * cos_angle);
+  }
 
   //! rotate the vector itself by angle.
-  void SelfRotate(double angle);
+  void SelfRotate(double angle) { *this = Rotate(angle); }
 
   //! Sums two Vec2d
-  Vec2d operator+(const Vec2d& other) const;
+  constexpr Vec2d operator+(const Vec2d& other) const {
+    return Vec2d(x_ + other.x_, y_ + other.y_);
+  }
 
   //! Subtracts two Vec2d
-  Vec2d operator-(const Vec2d& other) const;
+  constexpr Vec2d operator-(const Vec2d& other) const {
+    return Vec2d(x_ - other.x_, y_ - other.y_);
+  }
 
   //! Multiplies Vec2d by a scalar
-  Vec2d operator*(double ratio) const;
+  constexpr Vec2d operator*(double ratio) const {
+    return Vec2d(x_ * ratio, y_ * ratio);
+  }
 
   //! Divides Vec2d by a scalar
-  Vec2d operator/(double ratio) const;
+  constexpr Vec2d operator/(double ratio) const {
+    return Vec2d(x_ / ratio, y_ / ratio);
+  }
 
   //! Sums another Vec2d to the current one
-  Vec2d& operator+=(const Vec2d& other);
+  constexpr Vec2d& operator+=(const Vec2d& other) {
+    x_ += other.x_;
+    y_ += other.y_;
+    return *this;
+  }
 
   //! Subtracts another Vec2d to the current one
-  Vec2d& operator-=(const Vec2d& other);
+  constexpr Vec2d& operator-=(const Vec2d& other) {
+    x_ -= other.x_;
+    y_ -= other.y_;
+    return *this;
+  }
 
   //! Multiplies this Vec2d by a scalar
-  Vec2d& operator*=(double ratio);
+  constexpr Vec2d& operator*=(double ratio) {
+    x_ *= ratio;
+    y_ *= ratio;
+    return *this;
+  }
 
   //! Divides this Vec2d by a scalar
-  Vec2d& operator/=(double ratio);
+  constexpr Vec2d& operator/=(double ratio) {
+    x_ /= ratio;
+    y_ /= ratio;
+    return *this;
+  }
 
   //! Compares two Vec2d
-  bool operator==(const Vec2d& other) const;
+  constexpr bool operator==(const Vec2d& other) const {
+    return x_ - other.x_ < 1e-10 && other.x_ - x_ < 1e-10 &&
+           y_ - other.y_ < 1e-10 && other.y_ - y_ < 1e-10;
+  }
 
  protected:
   double x_;
@@ -106,7 +148,9 @@ class Vec2d {
 };
 
 //! Multiplies the given Vec2d by a given scalar
-Vec2d operator*(const double ratio, const Vec2d& vec);
+constexpr Vec2d operator*(const double ratio, const Vec2d& vec) {
+  return vec * ratio;
+}
 
 }  // namespace geometry
 }  // namespace engine
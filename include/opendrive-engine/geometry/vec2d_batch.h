@@ -0,0 +1,59 @@
+#ifndef OPENDRIVE_ENGINE_GEOMETRY_VEC2D_BATCH_H_
+#define OPENDRIVE_ENGINE_GEOMETRY_VEC2D_BATCH_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "opendrive-engine/geometry/vec2d.h"
+
+namespace opendrive {
+namespace engine {
+namespace geometry {
+
+/**
+ * @class Vec2dBatch
+ * @brief A group of 2-D points stored as separate x and y arrays
+ *        (structure of arrays), so that kernels looping over many points
+ *        read contiguous doubles and can be vectorized by the compiler.
+ */
+class Vec2dBatch {
+ public:
+  Vec2dBatch() = default;
+
+  /**
+   * @brief Constructor which copies a vector of points.
+   * @param points The points to store.
+   */
+  explicit Vec2dBatch(const std::vector<Vec2d>& points);
+
+  void reserve(size_t size) {
+    x_.reserve(size);
+    y_.reserve(size);
+  }
+  void clear() {
+    x_.clear();
+    y_.clear();
+  }
+  void emplace_back(double x, double y) {
+    x_.emplace_back(x);
+    y_.emplace_back(y);
+  }
+  void push_back(const Vec2d& point) { emplace_back(point.x(), point.y()); }
+  size_t size() const { return x_.size(); }
+  bool empty() const { return x_.empty(); }
+  Vec2d operator[](size_t i) const { return Vec2d(x_[i], y_[i]); }
+  const double* x() const { return x_.data(); }
+  const double* y() const { return y_.data(); }
+  double* mutable_x() { return x_.data(); }
+  double* mutable_y() { return y_.data(); }
+
+ private:
+  std::vector<double> x_;
+  std::vector<double> y_;
+};
+
+}  // namespace geometry
+}  // namespace engine
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_ENGINE_GEOMETRY_VEC2D_BATCH_H_
@@ -0,0 +1,284 @@
+#include "opendrive-engine/algo/bvh/road_index.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <queue>
+#include <thread>
+
+namespace opendrive {
+namespace engine {
+namespace bvh {
+
+namespace {
+
+// lanes per thread below which spawning another one does not pay off
+constexpr size_t kLanesPerThread = 256;
+
+enum class EntryKind : uint32_t { NODE, ROAD, SECTION, LANE, HIT };
+
+struct Entry {
+  double key;  // lower bound, exact for hits
+  EntryKind kind;
+  uint32_t index;  // of the node, road, section, lane or hit
+  bool operator>(const Entry& other) const { return key > other.key; }
+};
+
+}  // namespace
+
+void RoadIndex::Init(const RoadIndexLanes& lanes,
+                     const RoadIndexParam& param) {
+  param_ = param;
+  param_.leaf_max_size = std::max<size_t>(1, param_.leaf_max_size);
+  param_.max_threads = std::max<size_t>(1, param_.max_threads);
+  roads_.clear();
+  sections_.clear();
+  lanes_.clear();
+  road_ids_.clear();
+  section_ids_.clear();
+  lane_ids_.clear();
+  nodes_.clear();
+
+  // group the lanes by road, then by section
+  std::vector<uint32_t> order;
+  for (uint32_t i = 0; i < lanes.size(); ++i) {
+    if (lanes[i].curve && lanes[i].curve->num_segments()) order.push_back(i);
+  }
+  std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+    if (lanes[a].road_id != lanes[b].road_id) {
+      return lanes[a].road_id < lanes[b].road_id;
+    }
+    return lanes[a].section_id < lanes[b].section_id;
+  });
+  for (uint32_t index : order) {
+    const auto& lane = lanes[index];
+    if (roads_.empty() || road_ids_.back() != lane.road_id) {
+      const uint32_t section = static_cast<uint32_t>(sections_.size());
+      roads_.push_back({Box(), section, section, 0});
+      road_ids_.emplace_back(lane.road_id);
+    }
+    if (roads_.back().end == roads_.back().begin ||
+        section_ids_.back() != lane.section_id) {
+      const uint32_t first = static_cast<uint32_t>(lanes_.size());
+      sections_.push_back(
+          {Box(), first, first, static_cast<uint32_t>(roads_.size() - 1)});
+      section_ids_.emplace_back(lane.section_id);
+      ++roads_.back().end;
+    }
+    lanes_.push_back(
+        {Box(), lane.curve, static_cast<uint32_t>(sections_.size() - 1)});
+    lane_ids_.emplace_back(lane.lane_id);
+    ++sections_.back().end;
+  }
+
+  // lane bounds walk every curve point, the bulk of the build
+  std::atomic<size_t> next(0);
+  auto work = [&]() {
+    for (size_t i = next++; i < lanes_.size(); i = next++) {
+      const auto& curve = *lanes_[i].curve;
+      Box& box = lanes_[i].box;
+      box.min_x = box.max_x = curve.point(0).x();
+      box.min_y = box.max_y = curve.point(0).y();
+      for (size_t k = 1; k < curve.num_points(); ++k) {
+        const geometry::Vec2d point = curve.point(k);
+        box.min_x = std::min(box.min_x, point.x());
+        box.min_y = std::min(box.min_y, point.y());
+        box.max_x = std::max(box.max_x, point.x());
+        box.max_y = std::max(box.max_y, point.y());
+      }
+    }
+  };
+  const size_t num_threads = std::min(
+      param_.max_threads, std::max<size_t>(1, lanes_.size() / kLanesPerThread));
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < num_threads; ++i) workers.emplace_back(work);
+  work();
+  for (auto& worker : workers) worker.join();
+
+  auto merge = [](Box* const box, const Box& other) {
+    box->min_x = std::min(box->min_x, other.min_x);
+    box->min_y = std::min(box->min_y, other.min_y);
+    box->max_x = std::max(box->max_x, other.max_x);
+    box->max_y = std::max(box->max_y, other.max_y);
+  };
+  for (auto& section : sections_) {
+    section.box = lanes_[section.begin].box;
+    for (uint32_t i = section.begin + 1; i < section.end; ++i) {
+      merge(&section.box, lanes_[i].box);
+    }
+  }
+  for (auto& road : roads_) {
+    road.box = sections_[road.begin].box;
+    for (uint32_t i = road.begin + 1; i < road.end; ++i) {
+      merge(&road.box, sections_[i].box);
+    }
+  }
+  if (roads_.empty()) return;
+
+  std::vector<uint32_t> road_order(roads_.size());
+  for (uint32_t i = 0; i < road_order.size(); ++i) road_order[i] = i;
+  nodes_.reserve(2 * roads_.size() / param_.leaf_max_size + 1);
+  Build(0, static_cast<uint32_t>(road_order.size()), &road_order);
+  // leaves refer to ranges of road_order, store the roads in that order
+  std::vector<Group> sorted_roads;
+  std::vector<core::Id> sorted_ids;
+  sorted_roads.reserve(roads_.size());
+  sorted_ids.reserve(roads_.size());
+  for (uint32_t index : road_order) {
+    for (uint32_t i = roads_[index].begin; i < roads_[index].end; ++i) {
+      sections_[i].parent = static_cast<uint32_t>(sorted_roads.size());
+    }
+    sorted_roads.emplace_back(roads_[index]);
+    sorted_ids.emplace_back(road_ids_[index]);
+  }
+  roads_.swap(sorted_roads);
+  road_ids_.swap(sorted_ids);
+}
+
+uint32_t RoadIndex::Build(uint32_t begin, uint32_t end,
+                          std::vector<uint32_t>* order) {
+  const uint32_t node_index = static_cast<uint32_t>(nodes_.size());
+  nodes_.emplace_back();
+  Node node;
+  node.box = roads_[(*order)[begin]].box;
+  double center_min_x = std::numeric_limits<double>::max();
+  double center_min_y = std::numeric_limits<double>::max();
+  double center_max_x = std::numeric_limits<double>::lowest();
+  double center_max_y = std::numeric_limits<double>::lowest();
+  for (uint32_t i = begin; i < end; ++i) {
+    const Box& box = roads_[(*order)[i]].box;
+    node.box.min_x = std::min(node.box.min_x, box.min_x);
+    node.box.min_y = std::min(node.box.min_y, box.min_y);
+    node.box.max_x = std::max(node.box.max_x, box.max_x);
+    node.box.max_y = std::max(node.box.max_y, box.max_y);
+    const double center_x = 0.5 * (box.min_x + box.max_x);
+    const double center_y = 0.5 * (box.min_y + box.max_y);
+    center_min_x = std::min(center_min_x, center_x);
+    center_min_y = std::min(center_min_y, center_y);
+    center_max_x = std::max(center_max_x, center_x);
+    center_max_y = std::max(center_max_y, center_y);
+  }
+  if (end - begin <= param_.leaf_max_size) {
+    node.begin = begin;
+    node.count = end - begin;
+    nodes_[node_index] = node;
+    return node_index;
+  }
+  // median split along the longer extent of the box centers
+  const bool split_x =
+      center_max_x - center_min_x >= center_max_y - center_min_y;
+  const uint32_t mid = begin + (end - begin) / 2;
+  std::nth_element(order->begin() + begin, order->begin() + mid,
+                   order->begin() + end, [&](uint32_t lhs, uint32_t rhs) {
+                     const Box& a = roads_[lhs].box;
+                     const Box& b = roads_[rhs].box;
+                     return split_x ? a.min_x + a.max_x < b.min_x + b.max_x
+                                    : a.min_y + a.max_y < b.min_y + b.max_y;
+                   });
+  Build(begin, mid, order);
+  node.begin = Build(mid, end, order);
+  node.count = 0;
+  nodes_[node_index] = node;
+  return node_index;
+}
+
+void RoadIndex::Search(const geometry::Vec2d& point, RoadIndexLevel level,
+                       size_t num_closest, RoadIndexResults* const results,
+                       double max_distance) const {
+  results->clear();
+  if (nodes_.empty() || 0 == num_closest) return;
+  const double px = point.x();
+  const double py = point.y();
+  auto box_distance = [px, py](const Box& box) {
+    const double dx = std::max(0.0, std::max(box.min_x - px, px - box.max_x));
+    const double dy = std::max(0.0, std::max(box.min_y - py, py - box.max_y));
+    return std::sqrt(dx * dx + dy * dy);
+  };
+  // the road, section or lane a lane is reported as
+  auto owner = [&](uint32_t lane) {
+    if (RoadIndexLevel::LANE == level) return lane;
+    const uint32_t section = lanes_[lane].section;
+    if (RoadIndexLevel::SECTION == level) return section;
+    return sections_[section].parent;
+  };
+  std::vector<uint32_t> reported;
+  auto is_reported = [&](uint32_t item) {
+    return std::find(reported.begin(), reported.end(), item) !=
+           reported.end();
+  };
+
+  // every entry is keyed by a lower bound of the distance to the lanes
+  // below it, so exact lane distances pop in ascending order
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+  RoadIndexResults hits;
+  std::vector<uint32_t> hit_lanes;
+  queue.push({box_distance(nodes_[0].box), EntryKind::NODE, 0});
+  while (!queue.empty() && results->size() < num_closest) {
+    const Entry entry = queue.top();
+    queue.pop();
+    if (entry.key > max_distance) break;
+    switch (entry.kind) {
+      case EntryKind::NODE: {
+        const Node& node = nodes_[entry.index];
+        if (node.count) {
+          for (uint32_t i = node.begin; i < node.begin + node.count; ++i) {
+            queue.push({box_distance(roads_[i].box), EntryKind::ROAD, i});
+          }
+        } else {
+          const uint32_t left = entry.index + 1;
+          queue.push({box_distance(nodes_[left].box), EntryKind::NODE, left});
+          queue.push({box_distance(nodes_[node.begin].box), EntryKind::NODE,
+                      node.begin});
+        }
+        break;
+      }
+      case EntryKind::ROAD: {
+        const Group& road = roads_[entry.index];
+        for (uint32_t i = road.begin; i < road.end; ++i) {
+          queue.push({box_distance(sections_[i].box), EntryKind::SECTION, i});
+        }
+        break;
+      }
+      case EntryKind::SECTION: {
+        const Group& section = sections_[entry.index];
+        for (uint32_t i = section.begin; i < section.end; ++i) {
+          queue.push({box_distance(lanes_[i].box), EntryKind::LANE, i});
+        }
+        break;
+      }
+      case EntryKind::LANE: {
+        // a road or section already found needs none of its other lanes
+        if (is_reported(owner(entry.index))) break;
+        const auto& curve = *lanes_[entry.index].curve;
+        RoadIndexResult hit;
+        const int segment =
+            curve.GetProjection(point, &hit.s, &hit.lateral, &hit.distance);
+        if (segment < 0) break;
+        const geometry::Vec2d direction =
+            curve.point(segment + 1) - curve.point(segment);
+        hit.heading = std::atan2(direction.y(), direction.x());
+        hit.lane_id = lane_ids_[entry.index];
+        queue.push({hit.distance, EntryKind::HIT,
+                    static_cast<uint32_t>(hits.size())});
+        hits.emplace_back(hit);
+        hit_lanes.emplace_back(entry.index);
+        break;
+      }
+      case EntryKind::HIT: {
+        const uint32_t item = owner(hit_lanes[entry.index]);
+        if (is_reported(item)) break;
+        reported.emplace_back(item);
+        RoadIndexResult result = hits[entry.index];
+        result.id = RoadIndexLevel::LANE == level      ? result.lane_id
+                    : RoadIndexLevel::SECTION == level ? section_ids_[item]
+                                                       : road_ids_[item];
+        results->emplace_back(result);
+        break;
+      }
+    }
+  }
+}
+
+}  // namespace bvh
+}  // namespace engine
+}  // namespace opendrive
@@ -0,0 +1,253 @@
+#include "opendrive-engine/algo/bvh/segment_bvh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace opendrive {
+namespace engine {
+namespace bvh {
+
+void SegmentBVH::Init(const Segments& segments, const SegmentIds& ids,
+                      const SegmentBVHParam& param) {
+  Init(segments, ids, SegmentTags(), param);
+}
+
+void SegmentBVH::Init(const Segments& segments, const SegmentIds& ids,
+                      const SegmentTags& tags, const SegmentBVHParam& param) {
+  param_ = param;
+  param_.leaf_max_size = std::max<size_t>(1, param_.leaf_max_size);
+  segments_.clear();
+  ids_.clear();
+  tags_.clear();
+  nodes_.clear();
+  if (segments.empty() || segments.size() != ids.size() ||
+      (!tags.empty() && tags.size() != segments.size())) {
+    return;
+  }
+  std::vector<uint32_t> order(segments.size());
+  for (uint32_t i = 0; i < order.size(); ++i) order[i] = i;
+  segments_ = segments;
+  nodes_.reserve(2 * segments.size() / param_.leaf_max_size + 1);
+  Build(0, static_cast<uint32_t>(order.size()), &order);
+  // leaves refer to ranges of order, store the segments in that order
+  Segments sorted_segments;
+  SegmentIds sorted_ids;
+  sorted_segments.reserve(order.size());
+  sorted_ids.reserve(order.size());
+  for (uint32_t index : order) {
+    sorted_segments.emplace_back(segments[index]);
+    sorted_ids.emplace_back(ids[index]);
+    if (!tags.empty()) tags_.emplace_back(tags[index]);
+  }
+  segments_.swap(sorted_segments);
+  ids_.swap(sorted_ids);
+}
+
+uint32_t SegmentBVH::Build(uint32_t begin, uint32_t end,
+                           std::vector<uint32_t>* order) {
+  const uint32_t node_index = static_cast<uint32_t>(nodes_.size());
+  nodes_.emplace_back();
+  Node node;
+  node.min_x = node.min_y = std::numeric_limits<double>::max();
+  node.max_x = node.max_y = std::numeric_limits<double>::lowest();
+  double center_min_x = std::numeric_limits<double>::max();
+  double center_min_y = std::numeric_limits<double>::max();
+  double center_max_x = std::numeric_limits<double>::lowest();
+  double center_max_y = std::numeric_limits<double>::lowest();
+  for (uint32_t i = begin; i < end; ++i) {
+    const auto& segment = segments_[(*order)[i]];
+    node.min_x = std::min({node.min_x, segment.start().x(), segment.end().x()});
+    node.min_y = std::min({node.min_y, segment.start().y(), segment.end().y()});
+    node.max_x = std::max({node.max_x, segment.start().x(), segment.end().x()});
+    node.max_y = std::max({node.max_y, segment.start().y(), segment.end().y()});
+    const geometry::Vec2d center = segment.center();
+    center_min_x = std::min(center_min_x, center.x());
+    center_min_y = std::min(center_min_y, center.y());
+    center_max_x = std::max(center_max_x, center.x());
+    center_max_y = std::max(center_max_y, center.y());
+  }
+  if (end - begin <= param_.leaf_max_size) {
+    node.begin = begin;
+    node.count = end - begin;
+    nodes_[node_index] = node;
+    return node_index;
+  }
+  // median split along the longer extent of the segment centers
+  const bool split_x =
+      center_max_x - center_min_x >= center_max_y - center_min_y;
+  const uint32_t mid = begin + (end - begin) / 2;
+  std::nth_element(order->begin() + begin, order->begin() + mid,
+                   order->begin() + end, [&](uint32_t lhs, uint32_t rhs) {
+                     const geometry::Vec2d a = segments_[lhs].center();
+                     const geometry::Vec2d b = segments_[rhs].center();
+                     return split_x ? a.x() < b.x() : a.y() < b.y();
+                   });
+  Build(begin, mid, order);
+  node.begin = Build(mid, end, order);
+  node.count = 0;
+  nodes_[node_index] = node;
+  return node_index;
+}
+
+void SegmentBVH::Query(const geometry::AABox2d& box,
+                       SegmentIndices* const indices) const {
+  indices->clear();
+  if (nodes_.empty()) return;
+  const double min_x = box.min_x();
+  const double min_y = box.min_y();
+  const double max_x = box.max_x();
+  const double max_y = box.max_y();
+  uint32_t stack[64];
+  size_t stack_size = 0;
+  stack[stack_size++] = 0;
+  while (stack_size) {
+    const Node& node = nodes_[stack[--stack_size]];
+    if (node.min_x > max_x || node.max_x < min_x || node.min_y > max_y ||
+        node.max_y < min_y) {
+      continue;
+    }
+    if (node.count) {
+      for (uint32_t i = node.begin; i < node.begin + node.count; ++i) {
+        const auto& segment = segments_[i];
+        if (std::max(segment.start().x(), segment.end().x()) < min_x ||
+            std::min(segment.start().x(), segment.end().x()) > max_x ||
+            std::max(segment.start().y(), segment.end().y()) < min_y ||
+            std::min(segment.start().y(), segment.end().y()) > max_y) {
+          continue;
+        }
+        indices->emplace_back(i);
+      }
+      continue;
+    }
+    const uint32_t left = static_cast<uint32_t>(&node - nodes_.data()) + 1;
+    stack[stack_size++] = node.begin;
+    stack[stack_size++] = left;
+  }
+}
+
+int SegmentBVH::Raycast(const geometry::Vec2d& origin,
+                        const geometry::Vec2d& direction, double max_range,
+                        double* const distance) const {
+  constexpr double kTie = 1e-9;
+  int best = -1;
+  bool best_exits = false;
+  double best_t = max_range;
+  if (nodes_.empty()) return best;
+  const double ox = origin.x();
+  const double oy = origin.y();
+  const double dx = direction.x();
+  const double dy = direction.y();
+  const double inv_dx = 1.0 / dx;
+  const double inv_dy = 1.0 / dy;
+  // slab test clipped to [0, best_t], an axis parallel ray has to start
+  // inside the slab
+  auto hits_box = [&](const Node& node) {
+    double t_min = 0.0;
+    double t_max = best_t + kTie;
+    if (std::abs(dx) < 1e-12) {
+      if (ox < node.min_x || ox > node.max_x) return false;
+    } else {
+      const double t0 = (node.min_x - ox) * inv_dx;
+      const double t1 = (node.max_x - ox) * inv_dx;
+      t_min = std::max(t_min, std::min(t0, t1));
+      t_max = std::min(t_max, std::max(t0, t1));
+    }
+    if (std::abs(dy) < 1e-12) {
+      if (oy < node.min_y || oy > node.max_y) return false;
+    } else {
+      const double t0 = (node.min_y - oy) * inv_dy;
+      const double t1 = (node.max_y - oy) * inv_dy;
+      t_min = std::max(t_min, std::min(t0, t1));
+      t_max = std::min(t_max, std::max(t0, t1));
+    }
+    return t_min <= t_max;
+  };
+  uint32_t stack[64];
+  size_t stack_size = 0;
+  stack[stack_size++] = 0;
+  while (stack_size) {
+    const uint32_t node_index = stack[--stack_size];
+    const Node& node = nodes_[node_index];
+    if (!hits_box(node)) continue;
+    if (node.count) {
+      for (uint32_t i = node.begin; i < node.begin + node.count; ++i) {
+        const auto& segment = segments_[i];
+        const double ex = segment.end().x() - segment.start().x();
+        const double ey = segment.end().y() - segment.start().y();
+        const double denom = dx * ey - dy * ex;
+        if (std::abs(denom) < 1e-12) continue;  // parallel
+        const double ax = segment.start().x() - ox;
+        const double ay = segment.start().y() - oy;
+        const double t = (ax * ey - ay * ex) / denom;
+        const double u = (ax * dy - ay * dx) / denom;
+        if (t < 0.0 || u < 0.0 || u > 1.0 || t > best_t + kTie) continue;
+        // the ray leaves the left side of the segment
+        const bool exits = denom > 0.0;
+        if (t < best_t - kTie || best < 0 || (exits && !best_exits)) {
+          best = static_cast<int>(i);
+          best_t = std::min(t, best_t);
+          best_exits = exits;
+        }
+      }
+      continue;
+    }
+    stack[stack_size++] = node.begin;
+    stack[stack_size++] = node_index + 1;
+  }
+  if (best >= 0) *distance = best_t;
+  return best;
+}
+
+int SegmentBVH::Nearest(const geometry::Vec2d& point, double max_distance,
+                        double* const distance) const {
+  int best = -1;
+  if (nodes_.empty() || !(max_distance >= 0)) return best;
+  // squaring may round below the square of the distance max_distance was
+  // taken from, the bound is checked exactly at the end instead
+  double best_sqr = max_distance * max_distance *
+                    (1.0 + 4.0 * std::numeric_limits<double>::epsilon());
+  const double px = point.x();
+  const double py = point.y();
+  auto box_distance_sqr = [px, py](const Node& node) {
+    const double dx = std::max(0.0, std::max(node.min_x - px, px - node.max_x));
+    const double dy = std::max(0.0, std::max(node.min_y - py, py - node.max_y));
+    return dx * dx + dy * dy;
+  };
+  uint32_t stack[64];
+  size_t stack_size = 0;
+  stack[stack_size++] = 0;
+  while (stack_size) {
+    const uint32_t node_index = stack[--stack_size];
+    const Node& node = nodes_[node_index];
+    if (box_distance_sqr(node) > best_sqr) continue;
+    if (node.count) {
+      for (uint32_t i = node.begin; i < node.begin + node.count; ++i) {
+        const double sqr = segments_[i].DistanceSquareTo(point);
+        if (sqr < best_sqr ||
+            (sqr == best_sqr && (best < 0 || static_cast<int>(i) < best))) {
+          best_sqr = sqr;
+          best = static_cast<int>(i);
+        }
+      }
+      continue;
+    }
+    // visit the nearer child first, it tightens the bound for the other
+    const uint32_t left = node_index + 1;
+    const uint32_t right = node.begin;
+    if (box_distance_sqr(nodes_[left]) <= box_distance_sqr(nodes_[right])) {
+      stack[stack_size++] = right;
+      stack[stack_size++] = left;
+    } else {
+      stack[stack_size++] = left;
+      stack[stack_size++] = right;
+    }
+  }
+  if (best < 0 || std::sqrt(best_sqr) > max_distance) return -1;
+  *distance = std::sqrt(best_sqr);
+  return best;
+}
+
+}  // namespace bvh
+}  // namespace engine
+}  // namespace opendrive
@@ -1,66 +1,373 @@
 #include "opendrive-engine/algo/kdtree/kdtree.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
 namespace opendrive {
 namespace engine {
 namespace kdtree {
 
+namespace {
+
+// nanoflann's KNNResultSet, except that the search radius starts at a bound
+// instead of infinity, so subtrees beyond it are never visited
+class BoundedResultSet {
+ public:
+  BoundedResultSet(size_t capacity, double bound)
+      : capacity_(capacity), count_(0), bound_(bound) {}
+
+  void init(size_t* indices, double* dists) {
+    indices_ = indices;
+    dists_ = dists;
+    count_ = 0;
+    dists_[capacity_ - 1] = bound_;
+  }
+
+  size_t size() const { return count_; }
+
+  bool empty() const { return 0 == count_; }
+
+  bool full() const { return count_ == capacity_; }
+
+  bool addPoint(double dist, size_t index) {
+    size_t i;
+    for (i = count_; i > 0; --i) {
+      if (dists_[i - 1] <= dist) break;
+      if (i < capacity_) {
+        dists_[i] = dists_[i - 1];
+        indices_[i] = indices_[i - 1];
+      }
+    }
+    if (i < capacity_) {
+      dists_[i] = dist;
+      indices_[i] = index;
+    }
+    if (count_ < capacity_) ++count_;
+    return true;
+  }
+
+  double worstDist() const { return dists_[capacity_ - 1]; }
+
+ private:
+  size_t* indices_;
+  double* dists_;
+  size_t capacity_;
+  size_t count_;
+  double bound_;
+};
+
+// queries are prefetched this many searches ahead of the one running
+constexpr size_t kPrefetchDistance = 4;
+// samples around the predicted position that are prefetched, 4 cache lines
+constexpr size_t kPrefetchSamples = 16;
+
+// interleaves the low 16 bits of x and y
+inline uint32_t Morton(uint32_t x, uint32_t y) {
+  auto spread = [](uint32_t v) {
+    v &= 0xffff;
+    v = (v | (v << 8)) & 0x00ff00ff;
+    v = (v | (v << 4)) & 0x0f0f0f0f;
+    v = (v | (v << 2)) & 0x33333333;
+    v = (v | (v << 1)) & 0x55555555;
+    return v;
+  };
+  return spread(x) | (spread(y) << 1);
+}
+
+inline uint32_t Quantize(double value, double min, double scale) {
+  const double q = (value - min) * scale;
+  return q <= 0 ? 0 : q >= 65535 ? 65535 : static_cast<uint32_t>(q);
+}
+
+inline double Scale(double min, double max) {
+  return max > min ? 65535 / (max - min) : 0;
+}
+
+}  // namespace
+
 KDTreeAdaptor::~KDTreeAdaptor() {}
 
 KDTreeAdaptor::KDTreeAdaptor() {}
 
-size_t KDTreeAdaptor::kdtree_get_point_count() const { return matrix_.size(); }
+size_t KDTreeAdaptor::kdtree_get_point_count() const {
+  return points_.size() / 2;
+}
 
 double KDTreeAdaptor::kdtree_get_pt(size_t idx, size_t dim) const {
-  return matrix_[idx][dim];
+  return points_[2 * idx + dim];
 }
 
 void KDTreeAdaptor::Init(const SamplePoints& samples) {
-  KDTreeNodes().swap(matrix_);
+  KDTreeIndices indices(samples.size());
+  for (size_t i = 0; i < indices.size(); ++i) indices[i] = i;
+  Init(samples, indices);
+}
+
+void KDTreeAdaptor::Init(const SamplePoints& samples,
+                         const KDTreeIndices& indices) {
+  std::vector<double>().swap(points_);
   KDTreeIds().swap(ids_);
-  KDTreeNode node(2);
-  for (const auto& point : samples) {
-    node[0] = point.x();
-    node[1] = point.y();
+  points_.reserve(2 * indices.size());
+  ids_.reserve(indices.size());
+  for (size_t index : indices) {
+    const auto& point = samples[index];
+    points_.emplace_back(point.x());
+    points_.emplace_back(point.y());
     ids_.emplace_back(point.id());
-    matrix_.emplace_back(node);
   }
 }
-const KDTreeNodes& KDTreeAdaptor::matrix() const { return matrix_; }
+
+const std::vector<double>& KDTreeAdaptor::points() const { return points_; }
 
 const KDTreeIds& KDTreeAdaptor::ids() const { return ids_; }
 
 KDTree::~KDTree() {}
 
-KDTree::KDTree() : index_(nullptr) {}
+KDTree::KDTree() : sample_num_(0) {}
+
+size_t KDTree::num_shards() {
+  cactus::ReadLockGuard<cactus::AtomicRWLock> guard(rw_lock_);
+  return shards_.size();
+}
 
 int KDTree::Search(double x, double y, size_t num_closest,
-                   SearchResults& results) {
+                   const SearchParam& param, SearchResults& results) {
   results.clear();
+  if (num_closest > sample_num_) {
+    return -1;
+  }
+  if (0 == num_closest || !(param.max_distance >= 0)) {
+    return 0;
+  }
+  // nanoflann prunes on squared distances, eps is relative to distances
+  const double eps_error = (1 + param.eps) * (1 + param.eps);
+  const nanoflann::SearchParameters search_params(
+      static_cast<float>(eps_error - 1));
+  const double bound = param.max_distance * param.max_distance;
+  // shards nearest first, a shard whose box is farther than the current
+  // k-th distance cannot contribute
+  std::vector<std::pair<double, size_t>> order;
+  order.reserve(shards_.size());
+  for (size_t i = 0; i < shards_.size(); ++i) {
+    const Shard& shard = *shards_[i];
+    const double dx = std::max(0.0, std::max(shard.min_x - x, x - shard.max_x));
+    const double dy = std::max(0.0, std::max(shard.min_y - y, y - shard.max_y));
+    const double dist = dx * dx + dy * dy;
+    if (dist <= bound) order.emplace_back(dist, i);
+  }
+  std::sort(order.begin(), order.end());
+
+  struct Candidate {
+    double dist;  // sqr
+    size_t shard;
+    size_t index;
+    bool operator<(const Candidate& other) const { return dist < other.dist; }
+  };
+  std::vector<Candidate> candidates;
   KDTreeIndices indices(num_closest);  // 必须设置长度
   KDTreeDists dists(num_closest);      // 必须设置长度
   KDTreeNode query_node{x, y};
-  index_->knnSearch(&query_node[0], num_closest, &indices[0], &dists[0]);
-  if (indices.size() > adaptor_.matrix().size()) {
-    return -1;
+  for (const auto& item : order) {
+    const double worst =
+        candidates.size() == num_closest ? candidates.back().dist : bound;
+    if (item.first * eps_error > worst) break;
+    const Shard& shard = *shards_[item.second];
+    BoundedResultSet result_set(num_closest, worst);
+    result_set.init(&indices[0], &dists[0]);
+    shard.index->findNeighbors(result_set, &query_node[0], search_params);
+    for (size_t i = 0; i < result_set.size(); ++i) {
+      candidates.push_back({dists[i], item.second, indices[i]});
+    }
+    std::sort(candidates.begin(), candidates.end());
+    if (candidates.size() > num_closest) candidates.resize(num_closest);
   }
-  KDTreeResult result;
-  for (int i = 0; i < indices.size(); i++) {
-    result.x = adaptor_.matrix().at(indices.at(i))[0];
-    result.y = adaptor_.matrix().at(indices.at(i))[1];
-    result.id = adaptor_.ids().at(indices.at(i));
-    result.dist = std::sqrt(dists.at(i));
+  SearchResult result;
+  for (const auto& candidate : candidates) {
+    const auto& adaptor = shards_[candidate.shard]->adaptor;
+    result.x = adaptor.points()[2 * candidate.index];
+    result.y = adaptor.points()[2 * candidate.index + 1];
+    result.id = adaptor.ids()[candidate.index];
+    result.dist = std::sqrt(candidate.dist);
     results.emplace_back(result);
   }
   return 0;
 }
 
+void KDTree::Prefetch(double x, double y) const {
+  for (const auto& item : shards_) {
+    const Shard& shard = *item;
+    if (x < shard.min_x || x > shard.max_x || y < shard.min_y ||
+        y > shard.max_y) {
+      continue;
+    }
+    const uint32_t code = Morton(Quantize(x, shard.min_x, shard.scale_x),
+                                 Quantize(y, shard.min_y, shard.scale_y));
+    const size_t size = shard.codes.size();
+    size_t begin =
+        std::lower_bound(shard.codes.begin(), shard.codes.end(), code) -
+        shard.codes.begin();
+    begin = begin > kPrefetchSamples / 2 ? begin - kPrefetchSamples / 2 : 0;
+    const size_t end = std::min(size, begin + kPrefetchSamples);
+    const double* points = shard.adaptor.points().data();
+    for (size_t i = begin; i < end; i += 4) {  // 4 samples per cache line
+      __builtin_prefetch(points + 2 * i);
+    }
+    return;
+  }
+}
+
+void KDTree::SearchBatch(const double* x, const double* y, size_t size,
+                         size_t num_closest, const SearchParam& param,
+                         std::vector<SearchResults>* const results) {
+  if (0 == size) return;
+  double min_x = std::numeric_limits<double>::max();
+  double min_y = std::numeric_limits<double>::max();
+  double max_x = std::numeric_limits<double>::lowest();
+  double max_y = std::numeric_limits<double>::lowest();
+  for (size_t i = 0; i < size; ++i) {
+    min_x = std::min(min_x, x[i]);
+    min_y = std::min(min_y, y[i]);
+    max_x = std::max(max_x, x[i]);
+    max_y = std::max(max_y, y[i]);
+  }
+  const double scale_x = Scale(min_x, max_x);
+  const double scale_y = Scale(min_y, max_y);
+  std::vector<std::pair<uint32_t, uint32_t>> order(size);
+  for (size_t i = 0; i < size; ++i) {
+    order[i].first = Morton(Quantize(x[i], min_x, scale_x),
+                            Quantize(y[i], min_y, scale_y));
+    order[i].second = static_cast<uint32_t>(i);
+  }
+  std::sort(order.begin(), order.end());
+  for (size_t i = 0; i < size; ++i) {
+    if (i + kPrefetchDistance < size) {
+      const size_t ahead = order[i + kPrefetchDistance].second;
+      Prefetch(x[ahead], y[ahead]);
+    }
+    const size_t index = order[i].second;
+    Search(x[index], y[index], num_closest, param, (*results)[index]);
+  }
+}
+
+void KDTree::Split(const SamplePoints& samples, size_t begin, size_t end,
+                   KDTreeIndices* const order,
+                   std::vector<std::pair<size_t, size_t>>* const ranges) const {
+  if (end - begin <= param_.max_shard_size) {
+    ranges->emplace_back(begin, end);
+    return;
+  }
+  // median split along the longer extent, shards stay compact
+  double min_x = std::numeric_limits<double>::max();
+  double min_y = std::numeric_limits<double>::max();
+  double max_x = std::numeric_limits<double>::lowest();
+  double max_y = std::numeric_limits<double>::lowest();
+  for (size_t i = begin; i < end; ++i) {
+    const auto& point = samples[(*order)[i]];
+    min_x = std::min(min_x, point.x());
+    min_y = std::min(min_y, point.y());
+    max_x = std::max(max_x, point.x());
+    max_y = std::max(max_y, point.y());
+  }
+  const bool split_x = max_x - min_x >= max_y - min_y;
+  const size_t mid = begin + (end - begin) / 2;
+  std::nth_element(order->begin() + begin, order->begin() + mid,
+                   order->begin() + end, [&](size_t lhs, size_t rhs) {
+                     return split_x ? samples[lhs].x() < samples[rhs].x()
+                                    : samples[lhs].y() < samples[rhs].y();
+                   });
+  Split(samples, begin, mid, order, ranges);
+  Split(samples, mid, end, order, ranges);
+}
+
 void KDTree::Init(const SamplePoints& samples, const KDTreeParam& param) {
   cactus::WriteLockGuard<cactus::AtomicRWLock> guard(rw_lock_);
+  param_ = param;
+  param_.max_shard_size = std::max<size_t>(1, param_.max_shard_size);
+  param_.max_threads = std::max<size_t>(1, param_.max_threads);
+  sample_num_ = samples.size();
+  shards_.clear();
+  if (samples.empty()) return;
+
+  KDTreeIndices order(samples.size());
+  for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+  std::vector<std::pair<size_t, size_t>> ranges;
+  Split(samples, 0, order.size(), &order, &ranges);
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    shards_.emplace_back(new Shard());
+  }
+
   nanoflann::KDTreeSingleIndexAdaptorParams adaptor_params;
-  adaptor_params.flags = param.flags;
-  adaptor_params.leaf_max_size = param.leaf_max_size;
-  adaptor_.Init(samples);
-  index_.reset(new KDTreeIndex(samples.size(), adaptor_, adaptor_params));
+  adaptor_params.flags = param_.flags;
+  adaptor_params.leaf_max_size = param_.leaf_max_size;
+  // shards are independent, so they are built on a few threads; the first
+  // failure stops the others and is rethrown once all are joined
+  std::atomic<size_t> next(0);
+  std::mutex error_mutex;
+  std::exception_ptr error;
+  auto build = [&](size_t i) {
+    Shard& shard = *shards_[i];
+    KDTreeIndices indices(order.begin() + ranges[i].first,
+                          order.begin() + ranges[i].second);
+    shard.min_x = shard.min_y = std::numeric_limits<double>::max();
+    shard.max_x = shard.max_y = std::numeric_limits<double>::lowest();
+    for (size_t index : indices) {
+      shard.min_x = std::min(shard.min_x, samples[index].x());
+      shard.min_y = std::min(shard.min_y, samples[index].y());
+      shard.max_x = std::max(shard.max_x, samples[index].x());
+      shard.max_y = std::max(shard.max_y, samples[index].y());
+    }
+    // samples in morton order, so every leaf reads a few adjacent cache
+    // lines and the block a query will scan can be found ahead of time
+    shard.scale_x = Scale(shard.min_x, shard.max_x);
+    shard.scale_y = Scale(shard.min_y, shard.max_y);
+    std::vector<std::pair<uint32_t, size_t>> coded;
+    coded.reserve(indices.size());
+    for (size_t index : indices) {
+      coded.emplace_back(
+          Morton(Quantize(samples[index].x(), shard.min_x, shard.scale_x),
+                 Quantize(samples[index].y(), shard.min_y, shard.scale_y)),
+          index);
+    }
+    std::sort(coded.begin(), coded.end());
+    shard.codes.clear();
+    shard.codes.reserve(coded.size());
+    for (size_t k = 0; k < coded.size(); ++k) {
+      shard.codes.emplace_back(coded[k].first);
+      indices[k] = coded[k].second;
+    }
+    shard.adaptor.Init(samples, indices);
+    shard.index.reset(new KDTreeIndex(2, shard.adaptor, adaptor_params));
+  };
+  auto work = [&]() {
+    for (size_t i = next++; i < ranges.size(); i = next++) {
+      try {
+        build(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) error = std::current_exception();
+        next = ranges.size();
+      }
+    }
+  };
+  const size_t num_threads = std::min(param_.max_threads, ranges.size());
+  std::vector<std::thread> workers;
+  try {
+    for (size_t i = 1; i < num_threads; ++i) workers.emplace_back(work);
+  } catch (const std::system_error&) {
+    // fewer threads than asked for, the started ones take the rest
+  }
+  work();
+  for (auto& worker : workers) worker.join();
+  if (error) {
+    shards_.clear();
+    std::rethrow_exception(error);
+  }
 }
 
 }  // namespace kdtree
@@ -0,0 +1,225 @@
+#include "opendrive-engine/algo/raster/distance_field.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace opendrive {
+namespace engine {
+namespace raster {
+
+namespace {
+
+// nodes are processed in blocks of this many per side, every block only
+// looks at the edges that can be nearest to one of its nodes
+constexpr int kBlockNodes = 8;
+
+inline int64_t FloorDiv(int64_t value, int64_t divisor) {
+  return value >= 0 ? value / divisor : -((-value - 1) / divisor) - 1;
+}
+
+}  // namespace
+
+constexpr int DistanceField::kTileCells;
+constexpr int DistanceField::kTileNodes;
+
+size_t DistanceField::TileKeyHash::operator()(const TileKey& key) const {
+  return std::hash<int64_t>()(key.x * 73856093 ^ key.y * 19349663);
+}
+
+void DistanceField::Init(const bvh::SegmentBVH::ConstPtr& edges,
+                         const Polygons& areas,
+                         const DistanceFieldParam& param) {
+  param_ = param;
+  edges_ = edges;
+  DrivableRasterParam raster_param;
+  raster_param.max_cached_tiles = param_.max_cached_tiles;
+  raster_param.max_threads = 1;
+  areas_.Init(areas, raster_param);
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  cache_.clear();
+  lru_.clear();
+  built_tiles_ = 0;
+}
+
+size_t DistanceField::cached_tiles() const {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  return cache_.size();
+}
+
+size_t DistanceField::built_tiles() const {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  return built_tiles_;
+}
+
+bool DistanceField::Evaluate(const geometry::Vec2d& point,
+                             double* const distance,
+                             geometry::Vec2d* const gradient) {
+  const double x = point.x();
+  const double y = point.y();
+  double gradient_x = 0;
+  double gradient_y = 0;
+  if (!Evaluate(&x, &y, 1, distance, &gradient_x, &gradient_y)) {
+    return false;
+  }
+  if (gradient) *gradient = geometry::Vec2d(gradient_x, gradient_y);
+  return true;
+}
+
+bool DistanceField::Evaluate(const double* x, const double* y, size_t size,
+                             double* const distance, double* const gradient_x,
+                             double* const gradient_y) {
+  if (!edges_ || edges_->empty() || !(param_.resolution > 0)) return false;
+  const double res = param_.resolution;
+  TileKey current{0, 0};
+  TilePtr tile;
+  for (size_t i = 0; i < size; ++i) {
+    // node (col, row) sits at the center of lattice cell (col, row)
+    const double u = x[i] / res - 0.5;
+    const double v = y[i] / res - 0.5;
+    if (!(std::abs(u) < 1e15 && std::abs(v) < 1e15)) {
+      distance[i] = -param_.max_distance;
+      if (gradient_x) gradient_x[i] = gradient_y[i] = 0;
+      continue;
+    }
+    const double fu = std::floor(u);
+    const double fv = std::floor(v);
+    const int64_t col = static_cast<int64_t>(fu);
+    const int64_t row = static_cast<int64_t>(fv);
+    const TileKey key{FloorDiv(col, kTileCells), FloorDiv(row, kTileCells)};
+    if (!tile || !(key == current)) {
+      tile = GetTile(key);
+      current = key;
+    }
+    const float* node = tile->data() +
+                        (row - key.y * kTileCells) * kTileNodes +
+                        (col - key.x * kTileCells);
+    const double v00 = node[0];
+    const double v10 = node[1];
+    const double v01 = node[kTileNodes];
+    const double v11 = node[kTileNodes + 1];
+    const double tx = u - fu;
+    const double ty = v - fv;
+    distance[i] = (1 - ty) * ((1 - tx) * v00 + tx * v10) +
+                  ty * ((1 - tx) * v01 + tx * v11);
+    if (gradient_x) {
+      gradient_x[i] = ((1 - ty) * (v10 - v00) + ty * (v11 - v01)) / res;
+      gradient_y[i] = ((1 - tx) * (v01 - v00) + tx * (v11 - v10)) / res;
+    }
+  }
+  return true;
+}
+
+DistanceField::TilePtr DistanceField::GetTile(const TileKey& key) {
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    auto it = cache_.find(key);
+    if (it != cache_.end()) {
+      lru_.splice(lru_.begin(), lru_, it->second.lru);
+      return it->second.tile;
+    }
+  }
+  // built outside the lock, other tiles stay readable meanwhile
+  auto tile = std::make_shared<Tile>();
+  BuildTile(key, tile.get());
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  ++built_tiles_;
+  auto it = cache_.find(key);
+  if (it != cache_.end()) {
+    // another caller built the same tile meanwhile
+    lru_.splice(lru_.begin(), lru_, it->second.lru);
+    return it->second.tile;
+  }
+  lru_.push_front(key);
+  cache_[key] = CacheEntry{tile, lru_.begin()};
+  while (cache_.size() > param_.max_cached_tiles) {
+    cache_.erase(lru_.back());
+    lru_.pop_back();
+  }
+  return tile;
+}
+
+void DistanceField::BuildTile(const TileKey& key, Tile* const tile) {
+  const double res = param_.resolution;
+  const double max_distance = param_.max_distance;
+  const int64_t col0 = key.x * kTileCells;
+  const int64_t row0 = key.y * kTileCells;
+  auto node_x = [&](int c) { return (col0 + c + 0.5) * res; };
+  auto node_y = [&](int r) { return (row0 + r + 0.5) * res; };
+
+  // the sign, nodes coincide with the cell centers of the area raster
+  DrivableGrid inside;
+  areas_.Rasterize(geometry::AABox2d({(col0 + 0.25) * res, (row0 + 0.25) * res},
+                                     {(col0 + kTileCells + 0.75) * res,
+                                      (row0 + kTileCells + 0.75) * res}),
+                   res, &inside);
+
+  bvh::SegmentIndices candidates;
+  edges_->Query(geometry::AABox2d({node_x(0) - max_distance,
+                                   node_y(0) - max_distance},
+                                  {node_x(kTileCells) + max_distance,
+                                   node_y(kTileCells) + max_distance}),
+                &candidates);
+
+  tile->assign(kTileNodes * kTileNodes, static_cast<float>(-max_distance));
+  double xs[kBlockNodes * kBlockNodes];
+  double ys[kBlockNodes * kBlockNodes];
+  double best[kBlockNodes * kBlockNodes];
+  double distance_sqr[kBlockNodes * kBlockNodes];
+  for (int r0 = 0; r0 < kTileNodes; r0 += kBlockNodes) {
+    const int r1 = std::min(kTileNodes, r0 + kBlockNodes);
+    for (int c0 = 0; c0 < kTileNodes; c0 += kBlockNodes) {
+      const int c1 = std::min(kTileNodes, c0 + kBlockNodes);
+      size_t count = 0;
+      for (int r = r0; r < r1; ++r) {
+        for (int c = c0; c < c1; ++c) {
+          xs[count] = node_x(c);
+          ys[count] = node_y(r);
+          best[count] = max_distance * max_distance;
+          ++count;
+        }
+      }
+      // every node of the block is within the center's distance plus the
+      // half diagonal of some edge, farther edges cannot be nearest
+      const geometry::Vec2d center(0.5 * (node_x(c0) + node_x(c1 - 1)),
+                                   0.5 * (node_y(r0) + node_y(r1 - 1)));
+      const double half_diagonal =
+          0.5 * std::hypot(node_x(c1 - 1) - node_x(c0),
+                           node_y(r1 - 1) - node_y(r0));
+      double reach = max_distance;
+      for (size_t index : candidates) {
+        reach = std::min(reach, edges_->segment(index).DistanceTo(center) +
+                                    half_diagonal);
+      }
+      const double min_x = node_x(c0) - reach;
+      const double max_x = node_x(c1 - 1) + reach;
+      const double min_y = node_y(r0) - reach;
+      const double max_y = node_y(r1 - 1) + reach;
+      for (size_t index : candidates) {
+        const auto& segment = edges_->segment(index);
+        if (std::max(segment.start().x(), segment.end().x()) < min_x ||
+            std::min(segment.start().x(), segment.end().x()) > max_x ||
+            std::max(segment.start().y(), segment.end().y()) < min_y ||
+            std::min(segment.start().y(), segment.end().y()) > max_y) {
+          continue;
+        }
+        segment.DistanceSquareTo(xs, ys, count, distance_sqr);
+        for (size_t k = 0; k < count; ++k) {
+          best[k] = std::min(best[k], distance_sqr[k]);
+        }
+      }
+      count = 0;
+      for (int r = r0; r < r1; ++r) {
+        for (int c = c0; c < c1; ++c) {
+          const double distance = std::sqrt(best[count++]);
+          (*tile)[r * kTileNodes + c] =
+              static_cast<float>(inside.at(c, r) ? distance : -distance);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace raster
+}  // namespace engine
+}  // namespace opendrive
@@ -0,0 +1,284 @@
+#include "opendrive-engine/algo/raster/drivable_raster.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+namespace opendrive {
+namespace engine {
+namespace raster {
+
+namespace {
+
+constexpr double kBucketSize = 50.0;
+
+inline int64_t Bucket(double value) {
+  return static_cast<int64_t>(std::floor(value / kBucketSize));
+}
+
+inline int64_t BucketKey(int64_t x, int64_t y) {
+  return static_cast<int64_t>((static_cast<uint64_t>(x) << 32) ^
+                              (static_cast<uint64_t>(y) & 0xffffffff));
+}
+
+// index of the first lattice cell whose center is at or above value
+inline int64_t FirstCenterAtOrAbove(double value, double resolution) {
+  return static_cast<int64_t>(std::ceil(value / resolution - 0.5));
+}
+
+}  // namespace
+
+constexpr int DrivableRaster::kTileCells;
+
+size_t DrivableRaster::TileKeyHash::operator()(const TileKey& key) const {
+  const size_t h = std::hash<int64_t>()(key.x * 73856093 ^ key.y * 19349663);
+  return h ^ (std::hash<double>()(key.resolution) << 1);
+}
+
+void DrivableRaster::Init(const Polygons& polygons,
+                          const DrivableRasterParam& param) {
+  param_ = param;
+  param_.max_threads = std::max<size_t>(1, param_.max_threads);
+  polygons_.clear();
+  bounds_.clear();
+  buckets_.clear();
+  for (const auto& polygon : polygons) {
+    if (polygon.size() < 3) continue;
+    const uint32_t index = static_cast<uint32_t>(polygons_.size());
+    polygons_.emplace_back(polygon);
+    bounds_.emplace_back(polygon);
+    const auto& box = bounds_.back();
+    const int64_t x0 = Bucket(box.min_x());
+    const int64_t x1 = Bucket(box.max_x());
+    const int64_t y0 = Bucket(box.min_y());
+    const int64_t y1 = Bucket(box.max_y());
+    for (int64_t x = x0; x <= x1; ++x) {
+      for (int64_t y = y0; y <= y1; ++y) {
+        buckets_[BucketKey(x, y)].emplace_back(index);
+      }
+    }
+  }
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  cache_.clear();
+  lru_.clear();
+  rasterized_tiles_ = 0;
+}
+
+size_t DrivableRaster::cached_tiles() const {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  return cache_.size();
+}
+
+size_t DrivableRaster::rasterized_tiles() const {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  return rasterized_tiles_;
+}
+
+void DrivableRaster::CandidatePolygons(
+    const geometry::AABox2d& box, std::vector<uint32_t>* const indices) const {
+  indices->clear();
+  const int64_t x0 = Bucket(box.min_x());
+  const int64_t x1 = Bucket(box.max_x());
+  const int64_t y0 = Bucket(box.min_y());
+  const int64_t y1 = Bucket(box.max_y());
+  for (int64_t x = x0; x <= x1; ++x) {
+    for (int64_t y = y0; y <= y1; ++y) {
+      auto it = buckets_.find(BucketKey(x, y));
+      if (it == buckets_.end()) continue;
+      for (uint32_t index : it->second) {
+        if (bounds_[index].HasOverlap(box)) indices->emplace_back(index);
+      }
+    }
+  }
+  // a polygon spanning several buckets is found once per bucket
+  std::sort(indices->begin(), indices->end());
+  indices->erase(std::unique(indices->begin(), indices->end()),
+                 indices->end());
+}
+
+bool DrivableRaster::Contains(const geometry::Vec2d& point) const {
+  if (!std::isfinite(point.x()) || !std::isfinite(point.y())) return false;
+  auto it = buckets_.find(BucketKey(Bucket(point.x()), Bucket(point.y())));
+  if (it == buckets_.end()) return false;
+  for (uint32_t index : it->second) {
+    const auto& box = bounds_[index];
+    if (point.x() < box.min_x() || point.x() > box.max_x() ||
+        point.y() < box.min_y() || point.y() > box.max_y()) {
+      continue;
+    }
+    // even-odd crossings of a ray towards +x
+    const auto& polygon = polygons_[index];
+    bool inside = false;
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+      const geometry::Vec2d& a = polygon[j];
+      const geometry::Vec2d& b = polygon[i];
+      if ((a.y() > point.y()) != (b.y() > point.y()) &&
+          point.x() < a.x() + (point.y() - a.y()) * (b.x() - a.x()) /
+                                  (b.y() - a.y())) {
+        inside = !inside;
+      }
+    }
+    if (inside) return true;
+  }
+  return false;
+}
+
+void DrivableRaster::RasterizeTile(const TileKey& key, Tile* const tile) const {
+  tile->assign(kTileCells * kTileCells, 0);
+  const double res = key.resolution;
+  const int64_t col0 = key.x * kTileCells;
+  const int64_t row0 = key.y * kTileCells;
+  const geometry::AABox2d box({col0 * res, row0 * res},
+                              {(col0 + kTileCells) * res,
+                               (row0 + kTileCells) * res});
+  std::vector<uint32_t> indices;
+  CandidatePolygons(box, &indices);
+  std::vector<double> crossings[kTileCells];
+  for (uint32_t index : indices) {
+    const auto& polygon = polygons_[index];
+    // even-odd crossings of every edge with the row centers it spans; the
+    // half open span [low, high) counts a shared vertex once
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+      const geometry::Vec2d& a = polygon[j];
+      const geometry::Vec2d& b = polygon[i];
+      if (a.y() == b.y()) continue;
+      const double low = std::min(a.y(), b.y());
+      const double high = std::max(a.y(), b.y());
+      const int64_t r0 =
+          std::max<int64_t>(0, FirstCenterAtOrAbove(low, res) - row0);
+      const int64_t r1 = std::min<int64_t>(
+          kTileCells, FirstCenterAtOrAbove(high, res) - row0);
+      const double slope = (b.x() - a.x()) / (b.y() - a.y());
+      for (int64_t r = r0; r < r1; ++r) {
+        const double y = (row0 + r + 0.5) * res;
+        crossings[r].emplace_back(a.x() + (y - a.y()) * slope);
+      }
+    }
+    for (int r = 0; r < kTileCells; ++r) {
+      auto& xs = crossings[r];
+      if (xs.empty()) continue;
+      std::sort(xs.begin(), xs.end());
+      uint8_t* row = tile->data() + r * kTileCells;
+      for (size_t k = 0; k + 1 < xs.size(); k += 2) {
+        const int64_t c0 =
+            std::max<int64_t>(0, FirstCenterAtOrAbove(xs[k], res) - col0);
+        const int64_t c1 = std::min<int64_t>(
+            kTileCells, FirstCenterAtOrAbove(xs[k + 1], res) - col0);
+        if (c0 < c1) std::memset(row + c0, 1, c1 - c0);
+      }
+      xs.clear();
+    }
+  }
+}
+
+bool DrivableRaster::Rasterize(const geometry::AABox2d& window,
+                               double resolution, DrivableGrid* const grid) {
+  if (!(resolution > 0)) return false;
+  const int64_t col_begin =
+      static_cast<int64_t>(std::floor(window.min_x() / resolution));
+  const int64_t row_begin =
+      static_cast<int64_t>(std::floor(window.min_y() / resolution));
+  const int64_t col_end = std::max(
+      col_begin + 1,
+      static_cast<int64_t>(std::ceil(window.max_x() / resolution)));
+  const int64_t row_end = std::max(
+      row_begin + 1,
+      static_cast<int64_t>(std::ceil(window.max_y() / resolution)));
+  const size_t width = static_cast<size_t>(col_end - col_begin);
+  const size_t height = static_cast<size_t>(row_end - row_begin);
+  if (width > param_.max_cells / height) return false;
+  grid->min_x = col_begin * resolution;
+  grid->min_y = row_begin * resolution;
+  grid->resolution = resolution;
+  grid->width = width;
+  grid->height = height;
+  grid->cells.assign(width * height, 0);
+
+  // floor division, cells left of the origin belong to negative tiles
+  auto tile_of = [](int64_t cell) {
+    return cell >= 0 ? cell / kTileCells : -((-cell - 1) / kTileCells) - 1;
+  };
+  std::vector<TileKey> keys;
+  for (int64_t ty = tile_of(row_begin); ty <= tile_of(row_end - 1); ++ty) {
+    for (int64_t tx = tile_of(col_begin); tx <= tile_of(col_end - 1); ++tx) {
+      keys.push_back({tx, ty, resolution});
+    }
+  }
+
+  std::vector<std::shared_ptr<const Tile>> tiles(keys.size());
+  std::vector<size_t> missing;
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    for (size_t i = 0; i < keys.size(); ++i) {
+      auto it = cache_.find(keys[i]);
+      if (it == cache_.end()) {
+        missing.emplace_back(i);
+        continue;
+      }
+      tiles[i] = it->second.tile;
+      lru_.splice(lru_.begin(), lru_, it->second.lru);
+    }
+  }
+
+  // tiles are independent, so missing ones are spread over a few threads
+  std::vector<Tile> fresh(missing.size());
+  std::atomic<size_t> next(0);
+  auto work = [&]() {
+    for (size_t i = next++; i < missing.size(); i = next++) {
+      RasterizeTile(keys[missing[i]], &fresh[i]);
+    }
+  };
+  const size_t num_threads = std::min(param_.max_threads, missing.size());
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < num_threads; ++i) workers.emplace_back(work);
+  work();
+  for (auto& worker : workers) worker.join();
+
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    for (size_t i = 0; i < missing.size(); ++i) {
+      const auto& key = keys[missing[i]];
+      auto tile = std::make_shared<const Tile>(std::move(fresh[i]));
+      tiles[missing[i]] = tile;
+      ++rasterized_tiles_;
+      // another caller may have added the tile meanwhile
+      auto it = cache_.find(key);
+      if (it != cache_.end()) {
+        it->second.tile = tile;
+        lru_.splice(lru_.begin(), lru_, it->second.lru);
+        continue;
+      }
+      lru_.push_front(key);
+      cache_[key] = CacheEntry{tile, lru_.begin()};
+    }
+    while (cache_.size() > param_.max_cached_tiles) {
+      cache_.erase(lru_.back());
+      lru_.pop_back();
+    }
+  }
+
+  // copy the part of every tile that lies inside the grid
+  for (size_t i = 0; i < keys.size(); ++i) {
+    const int64_t tile_col = keys[i].x * kTileCells;
+    const int64_t tile_row = keys[i].y * kTileCells;
+    const int64_t c0 = std::max(col_begin, tile_col);
+    const int64_t c1 = std::min(col_end, tile_col + kTileCells);
+    const int64_t r0 = std::max(row_begin, tile_row);
+    const int64_t r1 = std::min(row_end, tile_row + kTileCells);
+    const uint8_t* src = tiles[i]->data();
+    for (int64_t r = r0; r < r1; ++r) {
+      std::memcpy(grid->cells.data() + (r - row_begin) * width +
+                      (c0 - col_begin),
+                  src + (r - tile_row) * kTileCells + (c0 - tile_col),
+                  c1 - c0);
+    }
+  }
+  return true;
+}
+
+}  // namespace raster
+}  // namespace engine
+}  // namespace opendrive
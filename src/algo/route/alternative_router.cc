@@ -0,0 +1,331 @@
+#include "opendrive-engine/algo/route/alternative_router.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <utility>
+
+namespace opendrive {
+namespace engine {
+namespace route {
+
+namespace {
+
+constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+enum Side { FORWARD = 0, BACKWARD = 1 };
+
+// search nodes are lanes in one of two phases: forward, phase 1 holds the
+// lanes reached from the start by lane changes alone; backward, the lanes
+// that reach the goal that way. A lane change keeps the position along the
+// lane, so such lanes are entered at the start position, or left towards
+// the goal position
+inline uint32_t Node(uint32_t lane, uint32_t phase) { return 2 * lane + phase; }
+inline uint32_t LaneOf(uint32_t node) { return node >> 1; }
+inline uint32_t PhaseOf(uint32_t node) { return node & 1; }
+
+typedef std::pair<double, uint32_t> HeapEntry;
+
+// labels of both searches; an entry belongs to the current query only if
+// its stamp is the current generation, so nothing is cleared in between
+struct Workspace {
+  void Reset(size_t num_lanes) {
+    if (visited.size() != num_lanes) {
+      for (int side = FORWARD; side <= BACKWARD; ++side) {
+        label[side].assign(2 * num_lanes, kInfinity);
+        link[side].assign(2 * num_lanes, kNone);
+        link_type[side].assign(2 * num_lanes, LaneEdgeType::SUCCESSOR);
+        stamp[side].assign(2 * num_lanes, 0);
+        settled[side].assign(2 * num_lanes, 0);
+      }
+      visited.assign(num_lanes, 0);
+      generation = 0;
+    }
+    ++generation;
+    heap.clear();
+    reached.clear();
+  }
+  double Label(int side, uint32_t node) const {
+    return stamp[side][node] == generation ? label[side][node] : kInfinity;
+  }
+  bool Settled(int side, uint32_t node) const {
+    return settled[side][node] == generation;
+  }
+  void Relax(int side, uint32_t node, double value, uint32_t from,
+             LaneEdgeType type) {
+    if (value >= Label(side, node)) return;
+    stamp[side][node] = generation;
+    label[side][node] = value;
+    link[side][node] = from;
+    link_type[side][node] = type;
+    heap.emplace_back(value, node);
+    std::push_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+  }
+  bool Pop(HeapEntry* const entry) {
+    if (heap.empty()) return false;
+    std::pop_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+    *entry = heap.back();
+    heap.pop_back();
+    return true;
+  }
+
+  std::vector<double> label[2];
+  std::vector<uint32_t> link[2];  // previous node forward, next backward
+  std::vector<LaneEdgeType> link_type[2];
+  std::vector<uint32_t> stamp[2];
+  std::vector<uint32_t> settled[2];
+  std::vector<uint32_t> visited;  // repeated lane check of a candidate
+  uint32_t generation = 0;
+  std::vector<HeapEntry> heap;
+  std::vector<uint32_t> reached;  // nodes settled by the forward search
+};
+
+Workspace& GetWorkspace() {
+  static thread_local Workspace workspace;
+  return workspace;
+}
+
+struct Candidate {
+  double cost;
+  uint32_t forward;   // via nodes of both searches, kNone for staying on
+  uint32_t backward;  // the start lane
+  bool operator<(const Candidate& other) const { return cost < other.cost; }
+};
+
+bool OnRoute(const std::vector<std::vector<uint32_t>>& routes,
+             uint32_t lane) {
+  for (const auto& route : routes) {
+    if (std::binary_search(route.begin(), route.end(), lane)) return true;
+  }
+  return false;
+}
+
+inline double Fraction(double s, double length) {
+  if (!(length > 0)) return 0;
+  return std::min(1.0, std::max(0.0, s / length));
+}
+
+}  // namespace
+
+void AlternativeRouter::Init(const LaneGraph::ConstPtr& graph,
+                             const AlternativeRouteParam& param) {
+  graph_ = graph;
+  param_ = param;
+  param_.max_stretch = std::max(1.0, param_.max_stretch);
+}
+
+bool AlternativeRouter::Search(uint32_t from, double from_s, uint32_t to,
+                               double to_s, size_t num_routes,
+                               Routes* const routes) const {
+  if (!graph_) {
+    routes->clear();
+    return false;
+  }
+  return Search(from, from_s, to, to_s, num_routes, graph_->weights(), routes);
+}
+
+bool AlternativeRouter::Search(uint32_t from, double from_s, uint32_t to,
+                               double to_s, size_t num_routes,
+                               const std::vector<double>& weights,
+                               Routes* const routes) const {
+  routes->clear();
+  if (!graph_ || from >= graph_->num_lanes() || to >= graph_->num_lanes() ||
+      weights.size() != graph_->num_lanes() || 0 == num_routes) {
+    return false;
+  }
+  const LaneGraph& graph = *graph_;
+  const double lane_change_cost = graph.param().lane_change_cost;
+  auto edge_cost = [&](uint32_t lane, LaneEdgeType type) {
+    return LaneEdgeType::SUCCESSOR == type ? weights[lane] : lane_change_cost;
+  };
+  const double from_fraction = Fraction(from_s, graph.lane(from).length);
+  const double to_fraction = Fraction(to_s, graph.lane(to).length);
+  // cost of the part of the start lane not driven, and of the goal lane part
+  // that is driven
+  const double from_offset = weights[from] * from_fraction;
+  const double to_offset = weights[to] * to_fraction;
+  const bool direct = from == to && to_fraction >= from_fraction;
+
+  Workspace& ws = GetWorkspace();
+  ws.Reset(graph.num_lanes());
+  // lane changes alone cannot lead to a goal behind the start
+  const bool behind = to_fraction < from_fraction;
+  auto valid = [behind](uint32_t forward, uint32_t backward) {
+    return !(behind && PhaseOf(forward) && PhaseOf(backward));
+  };
+
+  // the costs an alternative may have; weights differing between neighbours
+  // can make a short lane change cost less than nothing
+  auto limit = [this](double best) {
+    if (best == kInfinity) return best;
+    return best + (param_.max_stretch - 1) * std::max(0.0, best);
+  };
+
+  // backward from the goal until no node left of the start can improve the
+  // best cost, stretch included
+  double best = direct ? to_offset - from_offset : kInfinity;
+  ws.Relax(BACKWARD, Node(to, 1), to_offset, kNone, LaneEdgeType::SUCCESSOR);
+  HeapEntry entry;
+  while (ws.Pop(&entry)) {
+    if (entry.first > ws.Label(BACKWARD, entry.second)) continue;
+    if (entry.first > limit(best) + from_offset) break;
+    const uint32_t node = entry.second;
+    const uint32_t lane = LaneOf(node);
+    ws.settled[BACKWARD][node] = ws.generation;
+    for (auto it = graph.out_begin(from); it != graph.out_end(from); ++it) {
+      const uint32_t head =
+          Node(it->lane, LaneEdgeType::LANE_CHANGE == it->type);
+      if (it->lane == lane && valid(head, node)) {
+        best = std::min(best, edge_cost(from, it->type) - from_offset +
+                                  entry.first);
+      }
+    }
+    for (auto it = graph.in_begin(lane); it != graph.in_end(lane); ++it) {
+      const bool change = LaneEdgeType::LANE_CHANGE == it->type;
+      ws.Relax(BACKWARD, Node(it->lane, change && PhaseOf(node)),
+               entry.first + edge_cost(it->lane, it->type), node, it->type);
+    }
+  }
+  if (best == kInfinity) return false;
+  const double bound = limit(best);
+
+  // forward from the lanes the start continues into; the start lane itself
+  // is only labeled if a loop leads back to it, changing lanes back into it
+  // never pays off. Lanes the backward search left are at least the bound
+  // away from the goal, no route within the bound passes them
+  auto remaining = [&ws](uint32_t lane) {
+    double cost = kInfinity;
+    for (uint32_t phase = 0; phase < 2; ++phase) {
+      if (ws.Settled(BACKWARD, Node(lane, phase))) {
+        cost = std::min(cost, ws.Label(BACKWARD, Node(lane, phase)));
+      }
+    }
+    return cost;
+  };
+  ws.heap.clear();
+  for (auto it = graph.out_begin(from); it != graph.out_end(from); ++it) {
+    const bool change = LaneEdgeType::LANE_CHANGE == it->type;
+    const double cost = edge_cost(from, it->type) - from_offset;
+    if (cost + remaining(it->lane) > bound) continue;
+    ws.Relax(FORWARD, Node(it->lane, change), cost, kNone, it->type);
+  }
+  while (ws.Pop(&entry)) {
+    if (entry.first > ws.Label(FORWARD, entry.second)) continue;
+    if (entry.first > bound) break;
+    const uint32_t node = entry.second;
+    const uint32_t lane = LaneOf(node);
+    ws.settled[FORWARD][node] = ws.generation;
+    ws.reached.emplace_back(node);
+    for (auto it = graph.out_begin(lane); it != graph.out_end(lane); ++it) {
+      const bool change = LaneEdgeType::LANE_CHANGE == it->type;
+      if (change && PhaseOf(node) && it->lane == from) continue;
+      const double cost = entry.first + edge_cost(lane, it->type);
+      if (cost + remaining(it->lane) > bound) continue;
+      ws.Relax(FORWARD, Node(it->lane, change && PhaseOf(node)), cost, node,
+               it->type);
+    }
+  }
+
+  std::vector<Candidate> candidates;
+  if (direct) candidates.push_back({to_offset - from_offset, kNone, kNone});
+  for (uint32_t node : ws.reached) {
+    const uint32_t lane = LaneOf(node);
+    for (uint32_t phase = 0; phase < 2; ++phase) {
+      const uint32_t other = Node(lane, phase);
+      if (!ws.Settled(BACKWARD, other) || !valid(node, other)) continue;
+      const double cost =
+          ws.Label(FORWARD, node) + ws.Label(BACKWARD, other);
+      if (cost <= bound) candidates.push_back({cost, node, other});
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+
+  std::vector<std::vector<uint32_t>> taken;  // sorted lanes of every route
+  std::vector<uint32_t> lanes;
+  std::vector<LaneEdgeType> types;  // of the edge leaving lanes[i]
+  for (const auto& candidate : candidates) {
+    if (routes->size() >= num_routes) break;
+    // a via lane on a route taken mostly leads to that route again
+    if (kNone != candidate.forward &&
+        OnRoute(taken, LaneOf(candidate.forward))) {
+      continue;
+    }
+    lanes.clear();
+    types.clear();
+    if (kNone != candidate.forward) {
+      // start, forward links up to the via lane, then backward links
+      for (uint32_t node = candidate.forward; kNone != node;
+           node = ws.link[FORWARD][node]) {
+        lanes.emplace_back(LaneOf(node));
+        types.emplace_back(ws.link_type[FORWARD][node]);
+      }
+      lanes.emplace_back(from);
+      std::reverse(lanes.begin(), lanes.end());
+      std::reverse(types.begin(), types.end());
+      for (uint32_t node = candidate.backward;
+           kNone != ws.link[BACKWARD][node];) {
+        types.emplace_back(ws.link_type[BACKWARD][node]);
+        node = ws.link[BACKWARD][node];
+        lanes.emplace_back(LaneOf(node));
+      }
+    } else {
+      lanes.emplace_back(from);
+    }
+
+    // the two halves may cross, a route drives every lane once; the lanes
+    // changed into right at the start are only partly driven at first, a
+    // loop may come back to them
+    size_t partial = 1;
+    while (partial < lanes.size() &&
+           LaneEdgeType::LANE_CHANGE == types[partial - 1]) {
+      ++partial;
+    }
+    bool repeated = false;
+    for (size_t i = partial; i < lanes.size() && !repeated; ++i) {
+      repeated = ws.visited[lanes[i]] == ws.generation;
+      ws.visited[lanes[i]] = ws.generation;
+    }
+    for (uint32_t lane : lanes) ws.visited[lane] = 0;
+    if (repeated) continue;
+
+    // weight of the lanes between start and goal in common with each route
+    std::vector<uint32_t> sorted(lanes.begin(), lanes.end());
+    std::sort(sorted.begin(), sorted.end());
+    bool accepted = true;
+    for (const auto& other : taken) {
+      if (other == sorted) {
+        accepted = false;
+        break;
+      }
+      double shared = 0;
+      for (size_t i = 1; i + 1 < lanes.size(); ++i) {
+        if (std::binary_search(other.begin(), other.end(), lanes[i])) {
+          shared += weights[lanes[i]];
+        }
+      }
+      if (shared > param_.max_sharing * best) {
+        accepted = false;
+        break;
+      }
+    }
+    if (!accepted) continue;
+
+    Route route;
+    route.cost = candidate.cost;
+    route.length = to_s - from_s;
+    for (size_t i = 0; i + 1 < lanes.size(); ++i) {
+      if (LaneEdgeType::SUCCESSOR == types[i]) {
+        route.length += graph.lane(lanes[i]).length;
+      }
+    }
+    route.lanes = lanes;
+    routes->emplace_back(std::move(route));
+    taken.emplace_back(std::move(sorted));
+  }
+  return !routes->empty();
+}
+
+}  // namespace route
+}  // namespace engine
+}  // namespace opendrive
@@ -0,0 +1,554 @@
+#include "opendrive-engine/algo/route/customizable_router.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <thread>
+
+namespace opendrive {
+namespace engine {
+namespace route {
+
+namespace {
+
+constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+// ranks of a level per thread below which spawning another one does not pay
+// off, the top levels of the elimination tree are narrow
+constexpr size_t kRanksPerThread = 256;
+
+// labels of the two elimination tree searches by rank, valid only with the
+// current stamp
+struct SearchSpace {
+  void Reset(size_t size) {
+    if (stamp[0].size() != size) {
+      for (int side = 0; side < 2; ++side) {
+        label[side].assign(size, kInfinity);
+        link[side].assign(size, kNone);
+        shortcut[side].assign(size, kNone);
+        stamp[side].assign(size, 0);
+      }
+      origin.assign(size, kNone);
+      visited.assign(size, 0);
+      generation = 0;
+    }
+    ++generation;
+    ranks.clear();
+  }
+  double Label(int side, uint32_t rank) const {
+    return stamp[side][rank] == generation ? label[side][rank] : kInfinity;
+  }
+  bool Relax(int side, uint32_t rank, double value, uint32_t from,
+             uint32_t via) {
+    if (value >= Label(side, rank)) return false;
+    stamp[side][rank] = generation;
+    label[side][rank] = value;
+    link[side][rank] = from;
+    shortcut[side][rank] = via;
+    return true;
+  }
+
+  std::vector<double> label[2];
+  std::vector<uint32_t> link[2];  // the rank the label came from
+  std::vector<uint32_t> shortcut[2];
+  std::vector<uint32_t> stamp[2];
+  std::vector<uint32_t> origin;   // the start lane change a seed follows
+  std::vector<uint32_t> visited;  // stamp, rank is in the forward space
+  uint32_t generation = 0;
+  std::vector<uint32_t> ranks;  // forward search space
+};
+
+SearchSpace& GetSearchSpace() {
+  static thread_local SearchSpace space;
+  return space;
+}
+
+// a lane reached from the start by lane changes alone, at the start position
+struct Change {
+  uint32_t lane;
+  double cost;
+  uint32_t previous;  // index in the changes, kNone for the start
+};
+
+inline double Fraction(double s, double length) {
+  if (!(length > 0)) return 0;
+  return std::min(1.0, std::max(0.0, s / length));
+}
+
+}  // namespace
+
+void CustomizableRouter::Init(const LaneGraph::ConstPtr& graph,
+                              const CustomizableRouteParam& param) {
+  std::lock_guard<std::mutex> lock(customize_mutex_);
+  graph_ = graph;
+  param_ = param;
+  param_.cell_size = std::max<size_t>(1, param_.cell_size);
+  param_.max_threads = std::max<size_t>(1, param_.max_threads);
+  const size_t size = graph_->num_lanes();
+
+  // the metric does not care about directions or edge types
+  std::vector<std::vector<uint32_t>> neighbours(size);
+  for (uint32_t lane = 0; lane < size; ++lane) {
+    for (auto it = graph_->out_begin(lane); it != graph_->out_end(lane);
+         ++it) {
+      if (it->lane == lane) continue;
+      neighbours[lane].emplace_back(it->lane);
+      neighbours[it->lane].emplace_back(lane);
+    }
+  }
+  for (auto& list : neighbours) {
+    std::sort(list.begin(), list.end());
+    list.erase(std::unique(list.begin(), list.end()), list.end());
+  }
+
+  rank_.assign(size, kNone);
+  std::vector<uint32_t> lanes(size);
+  for (uint32_t lane = 0; lane < size; ++lane) lanes[lane] = lane;
+  std::vector<uint8_t> marks(size, 0);
+  uint32_t next_rank = 0;
+  Order(neighbours, &lanes, &next_rank, &marks);
+  lane_.assign(size, 0);
+  for (uint32_t lane = 0; lane < size; ++lane) lane_[rank_[lane]] = lane;
+  Contract(neighbours);
+
+  // every graph edge gives the initial cost of one shortcut direction
+  inputs_.clear();
+  for (uint32_t lane = 0; lane < size; ++lane) {
+    for (auto it = graph_->out_begin(lane); it != graph_->out_end(lane);
+         ++it) {
+      if (it->lane == lane) continue;
+      const uint32_t a = rank_[lane];
+      const uint32_t b = rank_[it->lane];
+      const uint32_t low = std::min(a, b);
+      const uint32_t high = std::max(a, b);
+      const uint32_t shortcut = static_cast<uint32_t>(
+          std::lower_bound(heads_.begin() + up_offsets_[low],
+                           heads_.begin() + up_offsets_[low + 1], high) -
+          heads_.begin());
+      inputs_.push_back({shortcut, lane, a < b, it->type});
+    }
+  }
+  std::sort(inputs_.begin(), inputs_.end(),
+            [](const Input& lhs, const Input& rhs) {
+              return lhs.shortcut < rhs.shortcut;
+            });
+  input_offsets_.assign(heads_.size() + 1, 0);
+  for (const auto& input : inputs_) ++input_offsets_[input.shortcut + 1];
+  for (size_t i = 0; i < heads_.size(); ++i) {
+    input_offsets_[i + 1] += input_offsets_[i];
+  }
+
+  Apply(std::vector<double>(graph_->weights()));
+}
+
+void CustomizableRouter::Order(
+    const std::vector<std::vector<uint32_t>>& neighbours,
+    std::vector<uint32_t>* const lanes, uint32_t* const next_rank,
+    std::vector<uint8_t>* const marks) {
+  if (lanes->size() <= param_.cell_size) {
+    for (uint32_t lane : *lanes) rank_[lane] = (*next_rank)++;
+    return;
+  }
+  // halve the cell across its longer extent
+  auto center = [this](uint32_t lane) {
+    const auto& item = graph_->lane(lane);
+    return (item.entry + item.exit) / 2.0;
+  };
+  double min_x = kInfinity;
+  double min_y = kInfinity;
+  double max_x = -kInfinity;
+  double max_y = -kInfinity;
+  for (uint32_t lane : *lanes) {
+    const geometry::Vec2d point = center(lane);
+    min_x = std::min(min_x, point.x());
+    min_y = std::min(min_y, point.y());
+    max_x = std::max(max_x, point.x());
+    max_y = std::max(max_y, point.y());
+  }
+  const bool split_x = max_x - min_x >= max_y - min_y;
+  const size_t mid = lanes->size() / 2;
+  std::nth_element(lanes->begin(), lanes->begin() + mid, lanes->end(),
+                   [&](uint32_t lhs, uint32_t rhs) {
+                     const geometry::Vec2d a = center(lhs);
+                     const geometry::Vec2d b = center(rhs);
+                     return split_x ? a.x() < b.x() : a.y() < b.y();
+                   });
+  std::vector<uint32_t> halves[2] = {
+      std::vector<uint32_t>(lanes->begin(), lanes->begin() + mid),
+      std::vector<uint32_t>(lanes->begin() + mid, lanes->end())};
+  std::vector<uint32_t>().swap(*lanes);
+  // the lanes of either half next to the other one separate the two, the
+  // smaller of those boundaries is contracted last
+  std::vector<uint32_t> boundary[2];
+  std::vector<uint32_t> rest[2];
+  for (int side = 0; side < 2; ++side) {
+    for (uint32_t lane : halves[1 - side]) (*marks)[lane] = 1;
+    for (uint32_t lane : halves[side]) {
+      const bool next_to_other = std::any_of(
+          neighbours[lane].begin(), neighbours[lane].end(),
+          [marks](uint32_t other) { return 0 != (*marks)[other]; });
+      (next_to_other ? boundary[side] : rest[side]).emplace_back(lane);
+    }
+    for (uint32_t lane : halves[1 - side]) (*marks)[lane] = 0;
+  }
+  const int side = boundary[0].size() <= boundary[1].size() ? 0 : 1;
+  Order(neighbours, &rest[side], next_rank, marks);
+  Order(neighbours, &halves[1 - side], next_rank, marks);
+  const std::vector<uint32_t>& separator = boundary[side];
+  for (uint32_t lane : separator) rank_[lane] = (*next_rank)++;
+}
+
+void CustomizableRouter::Contract(
+    const std::vector<std::vector<uint32_t>>& neighbours) {
+  const size_t size = rank_.size();
+  std::vector<std::vector<uint32_t>> up(size);
+  for (uint32_t lane = 0; lane < size; ++lane) {
+    for (uint32_t other : neighbours[lane]) {
+      if (rank_[other] > rank_[lane]) up[rank_[lane]].push_back(rank_[other]);
+    }
+  }
+  // contracting a rank makes its higher neighbours a clique, the lowest of
+  // them inherits the others
+  std::vector<uint32_t> merged;
+  for (uint32_t rank = 0; rank < size; ++rank) {
+    auto& heads = up[rank];
+    std::sort(heads.begin(), heads.end());
+    if (heads.size() < 2) continue;
+    auto& parent = up[heads.front()];
+    std::sort(parent.begin(), parent.end());
+    merged.clear();
+    std::set_union(parent.begin(), parent.end(), heads.begin() + 1,
+                   heads.end(), std::back_inserter(merged));
+    parent.swap(merged);
+  }
+
+  up_offsets_.assign(size + 1, 0);
+  for (uint32_t rank = 0; rank < size; ++rank) {
+    up_offsets_[rank + 1] =
+        up_offsets_[rank] + static_cast<uint32_t>(up[rank].size());
+  }
+  heads_.clear();
+  tails_.clear();
+  heads_.reserve(up_offsets_[size]);
+  tails_.reserve(up_offsets_[size]);
+  std::vector<uint32_t> down_count(size + 1, 0);
+  for (uint32_t rank = 0; rank < size; ++rank) {
+    for (uint32_t head : up[rank]) {
+      heads_.emplace_back(head);
+      tails_.emplace_back(rank);
+      ++down_count[head + 1];
+    }
+  }
+  down_offsets_.assign(size + 1, 0);
+  for (size_t rank = 0; rank < size; ++rank) {
+    down_offsets_[rank + 1] = down_offsets_[rank] + down_count[rank + 1];
+  }
+  downs_.resize(heads_.size());
+  std::vector<uint32_t> fill(down_offsets_.begin(), down_offsets_.end() - 1);
+  for (uint32_t shortcut = 0; shortcut < heads_.size(); ++shortcut) {
+    downs_[fill[heads_[shortcut]]++] = {tails_[shortcut], shortcut};
+  }
+
+  // a rank depends on its lower neighbours only
+  std::vector<uint32_t> level(size, 0);
+  uint32_t num_levels = size ? 1 : 0;
+  for (uint32_t rank = 0; rank < size; ++rank) {
+    for (uint32_t i = up_offsets_[rank]; i < up_offsets_[rank + 1]; ++i) {
+      level[heads_[i]] = std::max(level[heads_[i]], level[rank] + 1);
+    }
+    num_levels = std::max(num_levels, level[rank] + 1);
+  }
+  level_offsets_.assign(num_levels + 1, 0);
+  for (uint32_t rank = 0; rank < size; ++rank) {
+    ++level_offsets_[level[rank] + 1];
+  }
+  for (uint32_t i = 0; i < num_levels; ++i) {
+    level_offsets_[i + 1] += level_offsets_[i];
+  }
+  levels_.resize(size);
+  fill.assign(level_offsets_.begin(), level_offsets_.end() - 1);
+  for (uint32_t rank = 0; rank < size; ++rank) {
+    levels_[fill[level[rank]]++] = rank;
+  }
+}
+
+bool CustomizableRouter::Customize(const std::vector<double>& weights) {
+  std::lock_guard<std::mutex> lock(customize_mutex_);
+  if (!graph_ || weights.size() != graph_->num_lanes()) return false;
+  for (double weight : weights) {
+    if (!(weight >= 0)) return false;
+  }
+  Apply(std::vector<double>(weights));
+  return true;
+}
+
+bool CustomizableRouter::Customize(
+    const std::vector<std::pair<uint32_t, double>>& changes) {
+  std::lock_guard<std::mutex> lock(customize_mutex_);
+  if (!graph_) return false;
+  for (const auto& change : changes) {
+    if (change.first >= graph_->num_lanes() || !(change.second >= 0)) {
+      return false;
+    }
+  }
+  std::vector<double> weights = std::atomic_load(&metric_)->weights;
+  for (const auto& change : changes) weights[change.first] = change.second;
+  Apply(std::move(weights));
+  return true;
+}
+
+void CustomizableRouter::Apply(std::vector<double>&& weights) {
+  auto metric = std::make_shared<Metric>();
+  metric->weights = std::move(weights);
+  metric->up.assign(heads_.size(), kInfinity);
+  metric->down.assign(heads_.size(), kInfinity);
+  const double lane_change_cost = graph_->param().lane_change_cost;
+  for (const auto& input : inputs_) {
+    const double cost = LaneEdgeType::SUCCESSOR == input.type
+                            ? metric->weights[input.tail]
+                            : lane_change_cost;
+    double& value =
+        input.up ? metric->up[input.shortcut] : metric->down[input.shortcut];
+    value = std::min(value, cost);
+  }
+
+  // the ranks of a level only read shortcuts of lower levels and write their
+  // own, so they are relaxed in parallel
+  std::vector<std::vector<uint32_t>> markers(
+      param_.max_threads, std::vector<uint32_t>(rank_.size(), kNone));
+  for (size_t level = 0; level + 1 < level_offsets_.size(); ++level) {
+    const uint32_t begin = level_offsets_[level];
+    const uint32_t end = level_offsets_[level + 1];
+    std::atomic<uint32_t> next(begin);
+    auto work = [&](std::vector<uint32_t>* const marker) {
+      for (uint32_t i = next++; i < end; i = next++) {
+        Relax(levels_[i], metric.get(), marker);
+      }
+    };
+    const size_t num_threads = std::min(
+        param_.max_threads,
+        std::max<size_t>(1, (end - begin) / kRanksPerThread));
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < num_threads; ++i) {
+      workers.emplace_back(work, &markers[i]);
+    }
+    work(&markers[0]);
+    for (auto& worker : workers) worker.join();
+  }
+  std::atomic_store(&metric_, MetricPtr(std::move(metric)));
+}
+
+void CustomizableRouter::Relax(uint32_t rank, Metric* const metric,
+                               std::vector<uint32_t>* const marker) const {
+  auto& up = metric->up;
+  auto& down = metric->down;
+  const uint32_t up_begin = up_offsets_[rank];
+  const uint32_t up_end = up_offsets_[rank + 1];
+  for (uint32_t i = up_begin; i < up_end; ++i) (*marker)[heads_[i]] = i;
+  // every lower neighbour closes a triangle with each pair of its higher
+  // neighbours, those above rank are shortcuts of rank
+  for (uint32_t d = down_offsets_[rank]; d < down_offsets_[rank + 1]; ++d) {
+    const uint32_t lower = downs_[d].rank;
+    const uint32_t to_lower = downs_[d].shortcut;
+    for (uint32_t i = up_offsets_[lower]; i < up_offsets_[lower + 1]; ++i) {
+      if (heads_[i] <= rank) continue;
+      const uint32_t shortcut = (*marker)[heads_[i]];
+      up[shortcut] = std::min(up[shortcut], down[to_lower] + up[i]);
+      down[shortcut] = std::min(down[shortcut], down[i] + up[to_lower]);
+    }
+  }
+  for (uint32_t i = up_begin; i < up_end; ++i) (*marker)[heads_[i]] = kNone;
+}
+
+CustomizableRouter::MetricPtr CustomizableRouter::metric() const {
+  return std::atomic_load(&metric_);
+}
+
+void CustomizableRouter::Unpack(const Metric& metric, uint32_t shortcut,
+                                bool up, std::vector<uint32_t>* const lanes)
+    const {
+  const double cost = up ? metric.up[shortcut] : metric.down[shortcut];
+  const uint32_t tail = tails_[shortcut];
+  const uint32_t head = heads_[shortcut];
+  const double lane_change_cost = graph_->param().lane_change_cost;
+  for (uint32_t i = input_offsets_[shortcut];
+       i < input_offsets_[shortcut + 1]; ++i) {
+    const Input& input = inputs_[i];
+    if (input.up != up) continue;
+    const double input_cost = LaneEdgeType::SUCCESSOR == input.type
+                                  ? metric.weights[input.tail]
+                                  : lane_change_cost;
+    if (input_cost == cost) {
+      lanes->emplace_back(lane_[up ? head : tail]);
+      return;
+    }
+  }
+  // otherwise a lower triangle gave the cost, found again by the same sums
+  uint32_t a = down_offsets_[tail];
+  uint32_t b = down_offsets_[head];
+  while (a < down_offsets_[tail + 1] && b < down_offsets_[head + 1]) {
+    if (downs_[a].rank < downs_[b].rank) {
+      ++a;
+    } else if (downs_[b].rank < downs_[a].rank) {
+      ++b;
+    } else {
+      const uint32_t to_tail = downs_[a].shortcut;
+      const uint32_t to_head = downs_[b].shortcut;
+      if (up && metric.down[to_tail] + metric.up[to_head] == cost) {
+        Unpack(metric, to_tail, false, lanes);
+        Unpack(metric, to_head, true, lanes);
+        return;
+      }
+      if (!up && metric.down[to_head] + metric.up[to_tail] == cost) {
+        Unpack(metric, to_head, false, lanes);
+        Unpack(metric, to_tail, true, lanes);
+        return;
+      }
+      ++a;
+      ++b;
+    }
+  }
+}
+
+bool CustomizableRouter::Search(uint32_t from, double from_s, uint32_t to,
+                                double to_s, Route* const route) const {
+  *route = Route();
+  const MetricPtr metric_ptr = metric();
+  if (!metric_ptr || from >= rank_.size() || to >= rank_.size()) return false;
+  const Metric& metric = *metric_ptr;
+  const LaneGraph& graph = *graph_;
+  const auto& weights = metric.weights;
+  const double from_fraction = Fraction(from_s, graph.lane(from).length);
+  const double to_fraction = Fraction(to_s, graph.lane(to).length);
+  const double from_offset = weights[from] * from_fraction;
+  const double to_offset = weights[to] * to_fraction;
+  const bool behind = to_fraction < from_fraction;
+
+  // lane changes keep the position, the lanes they reach from the start
+  // are handled here and the searches begin where a lane is left through
+  // its exit
+  std::vector<Change> changes{{from, 0, kNone}};
+  for (size_t i = 0; i < changes.size(); ++i) {
+    const uint32_t lane = changes[i].lane;
+    for (auto it = graph.out_begin(lane); it != graph.out_end(lane); ++it) {
+      if (LaneEdgeType::LANE_CHANGE != it->type) continue;
+      const bool seen = std::any_of(
+          changes.begin(), changes.end(),
+          [&](const Change& change) { return change.lane == it->lane; });
+      if (!seen) {
+        changes.push_back({it->lane,
+                           changes[i].cost + graph.param().lane_change_cost,
+                           static_cast<uint32_t>(i)});
+      }
+    }
+  }
+  double best = kInfinity;
+  uint32_t best_change = kNone;
+  uint32_t meeting = kNone;
+  for (uint32_t i = 0; i < changes.size(); ++i) {
+    if (changes[i].lane == to && !behind &&
+        changes[i].cost - from_offset + to_offset < best) {
+      best = changes[i].cost - from_offset + to_offset;
+      best_change = i;
+    }
+  }
+
+  SearchSpace& space = GetSearchSpace();
+  space.Reset(rank_.size());
+  for (uint32_t i = 0; i < changes.size(); ++i) {
+    const uint32_t lane = changes[i].lane;
+    for (auto it = graph.out_begin(lane); it != graph.out_end(lane); ++it) {
+      if (LaneEdgeType::SUCCESSOR != it->type) continue;
+      const uint32_t rank = rank_[it->lane];
+      if (space.Relax(0, rank, changes[i].cost + weights[lane] - from_offset,
+                      kNone, kNone)) {
+        space.origin[rank] = i;
+      }
+    }
+  }
+  // everything above a seed lies on its path to the root of the elimination
+  // tree, those paths in ascending rank order settle each rank once
+  auto parent = [this](uint32_t rank) {
+    return up_offsets_[rank] < up_offsets_[rank + 1]
+               ? heads_[up_offsets_[rank]]
+               : kNone;
+  };
+  for (uint32_t i = 0; i < changes.size(); ++i) {
+    const uint32_t lane = changes[i].lane;
+    for (auto it = graph.out_begin(lane); it != graph.out_end(lane); ++it) {
+      if (LaneEdgeType::SUCCESSOR != it->type) continue;
+      for (uint32_t rank = rank_[it->lane];
+           kNone != rank && space.visited[rank] != space.generation;
+           rank = parent(rank)) {
+        space.visited[rank] = space.generation;
+        space.ranks.emplace_back(rank);
+      }
+    }
+  }
+  std::sort(space.ranks.begin(), space.ranks.end());
+  for (uint32_t rank : space.ranks) {
+    const double label = space.Label(0, rank);
+    if (label == kInfinity) continue;
+    for (uint32_t i = up_offsets_[rank]; i < up_offsets_[rank + 1]; ++i) {
+      space.Relax(0, heads_[i], label + metric.up[i], rank, i);
+    }
+  }
+  // backward along the path of the goal, meeting the forward labels
+  space.Relax(1, rank_[to], to_offset, kNone, kNone);
+  for (uint32_t rank = rank_[to]; kNone != rank; rank = parent(rank)) {
+    const double label = space.Label(1, rank);
+    if (label == kInfinity) continue;
+    if (space.Label(0, rank) + label < best) {
+      best = space.Label(0, rank) + label;
+      meeting = rank;
+    }
+    for (uint32_t i = up_offsets_[rank]; i < up_offsets_[rank + 1]; ++i) {
+      space.Relax(1, heads_[i], label + metric.down[i], rank, i);
+    }
+  }
+  if (best == kInfinity) return false;
+
+  // the lane changes at the start, then the shortcuts up to the meeting rank
+  // and down to the goal, unpacked
+  std::vector<uint32_t> shortcuts;
+  uint32_t seed = kNone;
+  if (kNone != meeting) {
+    for (seed = meeting; kNone != space.link[0][seed];
+         seed = space.link[0][seed]) {
+      shortcuts.emplace_back(space.shortcut[0][seed]);
+    }
+    best_change = space.origin[seed];
+  }
+  std::vector<uint32_t> start;
+  for (uint32_t i = best_change; kNone != i; i = changes[i].previous) {
+    start.emplace_back(changes[i].lane);
+  }
+  route->lanes.assign(start.rbegin(), start.rend());
+  if (kNone != meeting) {
+    route->lanes.emplace_back(lane_[seed]);
+    for (auto it = shortcuts.rbegin(); it != shortcuts.rend(); ++it) {
+      Unpack(metric, *it, true, &route->lanes);
+    }
+    for (uint32_t rank = meeting; kNone != space.link[1][rank];
+         rank = space.link[1][rank]) {
+      Unpack(metric, space.shortcut[1][rank], false, &route->lanes);
+    }
+  }
+  route->cost = best;
+  route->length = to_s - from_s;
+  for (size_t i = 0; i + 1 < route->lanes.size(); ++i) {
+    const uint32_t lane = route->lanes[i];
+    for (auto it = graph.out_begin(lane); it != graph.out_end(lane); ++it) {
+      if (it->lane == route->lanes[i + 1] &&
+          LaneEdgeType::SUCCESSOR == it->type) {
+        route->length += graph.lane(lane).length;
+        break;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace route
+}  // namespace engine
+}  // namespace opendrive
@@ -0,0 +1,128 @@
+#include "opendrive-engine/algo/route/lane_graph.h"
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+#include <utility>
+
+namespace opendrive {
+namespace engine {
+namespace route {
+
+namespace {
+
+inline int64_t CellKey(double x, double y, double size) {
+  const int64_t cx = static_cast<int64_t>(std::floor(x / size));
+  const int64_t cy = static_cast<int64_t>(std::floor(y / size));
+  return static_cast<int64_t>((static_cast<uint64_t>(cx) << 32) ^
+                              (static_cast<uint64_t>(cy) & 0xffffffff));
+}
+
+inline double HeadingDiff(double a, double b) {
+  const double diff = std::remainder(a - b, 2 * M_PI);
+  return std::abs(diff);
+}
+
+}  // namespace
+
+void LaneGraph::Init(const LaneGraphLanes& lanes,
+                     const LaneGraphParam& param) {
+  param_ = param;
+  lanes_ = lanes;
+  weights_.resize(lanes_.size());
+  index_.clear();
+  for (uint32_t i = 0; i < lanes_.size(); ++i) {
+    weights_[i] = lanes_[i].length;
+    index_[lanes_[i].id] = i;
+  }
+
+  // entries hashed on a grid of the connect distance, an exit only looks at
+  // its own cell and the neighbouring ones
+  const double cell = std::max(param_.connect_distance, 1e-3);
+  std::unordered_map<int64_t, std::vector<uint32_t>> entries;
+  for (uint32_t i = 0; i < lanes_.size(); ++i) {
+    entries[CellKey(lanes_[i].entry.x(), lanes_[i].entry.y(), cell)]
+        .emplace_back(i);
+  }
+  std::vector<std::pair<uint32_t, LaneEdge>> edges;
+  for (uint32_t i = 0; i < lanes_.size(); ++i) {
+    const auto& lane = lanes_[i];
+    for (int dx = -1; dx <= 1; ++dx) {
+      for (int dy = -1; dy <= 1; ++dy) {
+        auto it = entries.find(CellKey(lane.exit.x() + dx * cell,
+                                       lane.exit.y() + dy * cell, cell));
+        if (it == entries.end()) continue;
+        for (uint32_t j : it->second) {
+          const auto& next = lanes_[j];
+          if (lane.exit.DistanceTo(next.entry) > param_.connect_distance ||
+              HeadingDiff(lane.exit_heading, next.entry_heading) >
+                  param_.connect_heading) {
+            continue;
+          }
+          edges.push_back({i, {j, LaneEdgeType::SUCCESSOR}});
+        }
+      }
+    }
+  }
+  // neighbours: the same section, the same side and adjacent numbers
+  std::unordered_map<core::Id, std::vector<uint32_t>> sections;
+  for (uint32_t i = 0; i < lanes_.size(); ++i) {
+    sections[lanes_[i].section_id].emplace_back(i);
+  }
+  for (const auto& section : sections) {
+    for (uint32_t i : section.second) {
+      for (uint32_t j : section.second) {
+        const int a = lanes_[i].index;
+        const int b = lanes_[j].index;
+        if ((a > 0) == (b > 0) && 1 == std::abs(a - b)) {
+          edges.push_back({i, {j, LaneEdgeType::LANE_CHANGE}});
+        }
+      }
+    }
+  }
+  // neighbouring cells can report the same entry twice
+  std::sort(edges.begin(), edges.end(),
+            [](const std::pair<uint32_t, LaneEdge>& lhs,
+               const std::pair<uint32_t, LaneEdge>& rhs) {
+              return std::make_tuple(lhs.first, lhs.second.lane,
+                                     lhs.second.type) <
+                     std::make_tuple(rhs.first, rhs.second.lane,
+                                     rhs.second.type);
+            });
+  edges.erase(std::unique(edges.begin(), edges.end(),
+                          [](const std::pair<uint32_t, LaneEdge>& lhs,
+                             const std::pair<uint32_t, LaneEdge>& rhs) {
+                            return lhs.first == rhs.first &&
+                                   lhs.second.lane == rhs.second.lane &&
+                                   lhs.second.type == rhs.second.type;
+                          }),
+              edges.end());
+
+  out_offsets_.assign(lanes_.size() + 1, 0);
+  in_offsets_.assign(lanes_.size() + 1, 0);
+  for (const auto& edge : edges) {
+    ++out_offsets_[edge.first + 1];
+    ++in_offsets_[edge.second.lane + 1];
+  }
+  for (size_t i = 0; i < lanes_.size(); ++i) {
+    out_offsets_[i + 1] += out_offsets_[i];
+    in_offsets_[i + 1] += in_offsets_[i];
+  }
+  out_edges_.resize(edges.size());
+  in_edges_.resize(edges.size());
+  std::vector<uint32_t> in_fill(in_offsets_.begin(), in_offsets_.end() - 1);
+  for (size_t k = 0; k < edges.size(); ++k) {
+    out_edges_[k] = edges[k].second;
+    in_edges_[in_fill[edges[k].second.lane]++] = {edges[k].first,
+                                                  edges[k].second.type};
+  }
+}
+
+int LaneGraph::FindLane(const core::Id& id) const {
+  auto it = index_.find(id);
+  return it == index_.end() ? -1 : static_cast<int>(it->second);
+}
+
+}  // namespace route
+}  // namespace engine
+}  // namespace opendrive
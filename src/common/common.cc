@@ -1,5 +1,9 @@
 #include "opendrive-engine/common/common.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace opendrive {
 namespace engine {
 namespace common {
@@ -25,6 +29,64 @@ bool IsLineGeometry(core::Lane::ConstPtr lane) {
   return true;
 }
 
+bool ProjectOntoCurve(const core::Curve& curve, double x, double y,
+                      core::LaneProjection& projection) {
+  const auto& pts = curve.pts();
+  if (pts.empty() || !std::isfinite(x) || !std::isfinite(y)) {
+    return false;
+  }
+  if (1 == pts.size()) {
+    projection.s = 0;
+    projection.l = 0;
+    projection.heading = pts.front().heading();
+    projection.dist = std::hypot(x - pts.front().x(), y - pts.front().y());
+    return true;
+  }
+  const auto& polyline = curve.polyline();
+  if (polyline.num_points() == pts.size()) {
+    const int index =
+        polyline.GetProjection({x, y}, &projection.s, &projection.l,
+                               &projection.dist);
+    if (index < 0) return false;
+    const double dx = pts[index + 1].x() - pts[index].x();
+    const double dy = pts[index + 1].y() - pts[index].y();
+    projection.heading = std::hypot(dx, dy) > 1e-10 ? std::atan2(dy, dx)
+                                                    : pts[index].heading();
+    return true;
+  }
+  double min_dist_sqr = std::numeric_limits<double>::max();
+  double accumulate_s = 0;
+  for (size_t i = 0; i + 1 < pts.size(); ++i) {
+    const double dx = pts[i + 1].x() - pts[i].x();
+    const double dy = pts[i + 1].y() - pts[i].y();
+    const double length = std::hypot(dx, dy);
+    const double x0 = x - pts[i].x();
+    const double y0 = y - pts[i].y();
+    double proj = 0;
+    double prod = 0;
+    double dist_sqr = x0 * x0 + y0 * y0;
+    if (length > 1e-10) {
+      proj = (x0 * dx + y0 * dy) / length;
+      prod = (dx * y0 - dy * x0) / length;
+      if (proj >= length) {
+        dist_sqr = (x0 - dx) * (x0 - dx) + (y0 - dy) * (y0 - dy);
+      } else if (proj > 0) {
+        dist_sqr = prod * prod;
+      }
+    }
+    if (dist_sqr < min_dist_sqr) {
+      min_dist_sqr = dist_sqr;
+      projection.s = accumulate_s + std::max(0.0, std::min(proj, length));
+      projection.l = prod;
+      projection.heading =
+          length > 1e-10 ? std::atan2(dy, dx) : pts[i].heading();
+    }
+    accumulate_s += length;
+  }
+  projection.dist = std::sqrt(min_dist_sqr);
+  return true;
+}
+
 }  // namespace common
 }  // namespace engine
 }  // namespace opendrive
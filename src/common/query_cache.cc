@@ -0,0 +1,82 @@
+#include "opendrive-engine/common/query_cache.h"
+
+namespace opendrive {
+namespace engine {
+namespace common {
+
+constexpr size_t QueryCache::kMaxValues;
+
+void QueryCache::Init(size_t capacity) {
+  size_t slots = 0;
+  if (capacity) {
+    slots = 1;
+    while (slots < capacity) slots <<= 1;
+  }
+  // same size, the slots are kept and entries of an old version just miss
+  if (slots == capacity_) return;
+  capacity_ = slots;
+  slots_.reset(slots ? new Slot[slots]() : nullptr);
+}
+
+size_t QueryCache::SlotIndex(const QueryCacheKey& key) const {
+  uint64_t h = static_cast<uint64_t>(key.x) * 0x9e3779b97f4a7c15ull;
+  h ^= static_cast<uint64_t>(key.y) * 0xc2b2ae3d27d4eb4full;
+  h ^= (key.eps * 31 + key.max_distance + key.k) * 0x165667b19e3779f9ull;
+  h ^= h >> 29;
+  return static_cast<size_t>(h) & (capacity_ - 1);
+}
+
+bool QueryCache::Lookup(const QueryCacheKey& key, uint64_t version,
+                        uint32_t* const values, size_t* const count) const {
+  if (!capacity_) return false;
+  const Slot& slot = slots_[SlotIndex(key)];
+  const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+  if (sequence & 1) return false;
+  const bool match = slot.version.load(std::memory_order_relaxed) == version &&
+                     slot.x.load(std::memory_order_relaxed) == key.x &&
+                     slot.y.load(std::memory_order_relaxed) == key.y &&
+                     slot.k.load(std::memory_order_relaxed) == key.k &&
+                     slot.eps.load(std::memory_order_relaxed) == key.eps &&
+                     slot.max_distance.load(std::memory_order_relaxed) ==
+                         key.max_distance;
+  if (!match) return false;
+  const size_t size = slot.count.load(std::memory_order_relaxed);
+  if (size > kMaxValues) return false;
+  for (size_t i = 0; i < size; ++i) {
+    values[i] = slot.values[i].load(std::memory_order_relaxed);
+  }
+  // the slot must not have been rewritten while it was read
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (slot.sequence.load(std::memory_order_relaxed) != sequence) return false;
+  *count = size;
+  return true;
+}
+
+void QueryCache::Insert(const QueryCacheKey& key, uint64_t version,
+                        const uint32_t* values, size_t count) {
+  if (!capacity_ || count > kMaxValues) return;
+  Slot& slot = slots_[SlotIndex(key)];
+  uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+  if ((sequence & 1) ||
+      !slot.sequence.compare_exchange_strong(sequence, sequence + 1,
+                                             std::memory_order_acquire,
+                                             std::memory_order_relaxed)) {
+    return;  // another writer holds the slot
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.version.store(version, std::memory_order_relaxed);
+  slot.x.store(key.x, std::memory_order_relaxed);
+  slot.y.store(key.y, std::memory_order_relaxed);
+  slot.k.store(key.k, std::memory_order_relaxed);
+  slot.eps.store(key.eps, std::memory_order_relaxed);
+  slot.max_distance.store(key.max_distance, std::memory_order_relaxed);
+  slot.count.store(static_cast<uint32_t>(count), std::memory_order_relaxed);
+  for (size_t i = 0; i < count; ++i) {
+    slot.values[i].store(values[i], std::memory_order_relaxed);
+  }
+  slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+}  // namespace common
+}  // namespace engine
+}  // namespace opendrive
@@ -1,8 +1,18 @@
 #include "opendrive-engine/convertor.h"
 
+#include <tinyxml2.h>
+
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <fstream>
+#include <future>
 #include <memory>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "cactus/factory.h"
 #include "opendrive-cpp/common/common.hpp"
@@ -12,6 +22,27 @@
 namespace opendrive {
 namespace engine {
 
+namespace {
+
+// threads for building per lane structures, lanes are independent
+constexpr unsigned kMaxBuildThreads = 8;
+
+// a lane's road marks describe its outer boundary, offsets are relative to
+// the section start like the sampled points
+core::LaneBoundaryAttrs RoadMarks(const element::Lane& ele_lane) {
+  core::LaneBoundaryAttrs attrs;
+  for (const auto& ele_mark : ele_lane.road_marks()) {
+    core::LaneBoundaryAttr attr;
+    attr.set_s(ele_mark.s_offset());
+    attr.set_boundary_type(ele_mark.type());
+    attr.set_boundary_color(ele_mark.color());
+    attrs.emplace_back(attr);
+  }
+  return attrs;
+}
+
+}  // namespace
+
 inline void Convertor::SetStatus(ErrorCode code, const std::string& msg) {
   status_.error_code = code;
   status_.msg = msg;
@@ -50,14 +81,36 @@ Status Convertor::Start() {
 
   ConvertHeader(ele_map)
       .ConvertRoad(ele_map)
-      .ConvertJunction(ele_map)
       .BuildKDTree()
+      .ConvertJunction(ele_map)
+      .BuildPolylines()
+      .BuildRoadIndex()
+      .BuildLaneGraph()
+      .BuildEdgeBVH()
+      .BuildBoundaryBVH()
+      .BuildDrivableRaster()
+      .BuildDistanceField()
       .End();
 
   return status_;
 }
 
 void Convertor::End() {
+  // the kdtree is built alongside the later steps, wait for it either way
+  if (kdtree_build_.valid()) {
+    try {
+      kdtree_build_.get();
+    } catch (const std::exception& e) {
+      if (Continue()) {
+        SetStatus(ErrorCode::CONVERTOR_KDTREE_ERROR,
+                  std::string("kdtree build error: ") + e.what());
+      }
+    } catch (...) {
+      if (Continue()) {
+        SetStatus(ErrorCode::CONVERTOR_KDTREE_ERROR, "kdtree build error.");
+      }
+    }
+  }
   if (!Continue()) return;
   core::Curve::Points().swap(center_line_pts_);
 }
@@ -76,11 +129,46 @@ Convertor& Convertor::ConvertHeader(opendrive::element::Map::Ptr ele_map) {
   header->set_west(ele_map->header().west());
   header->set_east(ele_map->header().east());
   header->set_vendor(ele_map->header().vendor());
+  header->set_geo_reference(ReadGeoReference(param_->map_file));
   data_->set_header(header);
   ENGINE_INFO("Convert Header End")
   return *this;
 }
 
+std::string Convertor::ReadGeoReference(const std::string& map_file) {
+  // only the header is needed, so the file is read up to its end and that
+  // part is parsed on its own instead of loading the whole map again
+  std::ifstream file(map_file);
+  std::string text;
+  std::string line;
+  while (std::getline(file, line)) {
+    text.append(line).push_back('\n');
+    if (std::string::npos != line.find("</header>") ||
+        std::string::npos != line.find("<road")) {
+      break;
+    }
+  }
+  const size_t begin = text.find("<header");
+  const size_t end = text.find("</header>");
+  if (std::string::npos == begin || std::string::npos == end || end < begin) {
+    return "";
+  }
+  tinyxml2::XMLDocument doc;
+  if (tinyxml2::XML_SUCCESS !=
+      doc.Parse(text.c_str() + begin, end + sizeof("</header>") - 1 - begin)) {
+    return "";
+  }
+  const auto* header = doc.FirstChildElement("header");
+  if (!header) return "";
+  const auto* geo_reference = header->FirstChildElement("geoReference");
+  if (!geo_reference || !geo_reference->GetText()) return "";
+  std::string geo_text = geo_reference->GetText();
+  const size_t first = geo_text.find_first_not_of(" \t\r\n");
+  if (std::string::npos == first) return "";
+  const size_t last = geo_text.find_last_not_of(" \t\r\n");
+  return geo_text.substr(first, last - first + 1);
+}
+
 Convertor& Convertor::ConvertJunction(opendrive::element::Map::Ptr ele_map) {
   if (!Continue()) return *this;
   ENGINE_INFO("Convert Junction Start")
@@ -173,13 +261,17 @@ Convertor& Convertor::ConvertSection(const element::Road& ele_road,
       lane->set_parent_id(section->id());
       CenterLaneSampling(ele_road.plan_view().geometrys(),
                          ele_road.lanes().lane_offsets(), section, road_ds);
+      const auto attrs = RoadMarks(ele_section.center().lanes().front());
+      lane->mutable_left_boundary().set_attrs(attrs);
+      lane->mutable_right_boundary().set_attrs(attrs);
       data_->mutable_lanes()[lane->id()] = lane;
     }
     // 参考线: 中心车道的左边界
-    core::Curve::Line& refe_line = section->mutable_center_lane()
-                                       ->mutable_left_boundary()
-                                       .mutable_curve()
-                                       .mutable_pts();
+    core::Curve::Line refe_line =
+        section->center_lane()->left_boundary().curve().pts();
+    // 内侧边界的标线: 相邻内侧车道的外边界标线
+    core::LaneBoundaryAttrs inner_attrs =
+        section->center_lane()->left_boundary().attrs();
 
     /// left lanes
     for (const auto& ele_lane : ele_section.left().lanes()) {
@@ -188,15 +280,17 @@ Convertor& Convertor::ConvertSection(const element::Road& ele_road,
       lane->set_id(section->id() + "_" +
                    std::to_string(ele_lane.attribute().id()));
       lane->set_parent_id(section->id());
+      lane->set_type(ele_lane.attribute().type());
       LaneSampling(ele_lane, lane, refe_line);
+      lane->mutable_left_boundary().set_attrs(inner_attrs);
+      inner_attrs = RoadMarks(ele_lane);
+      lane->mutable_right_boundary().set_attrs(inner_attrs);
       data_->mutable_lanes()[lane->id()] = lane;
-      refe_line = lane->mutable_right_boundary().mutable_curve().mutable_pts();
+      refe_line = lane->right_boundary().curve().pts();
     }
     // 参考线: 中心车道的右边界
-    refe_line = section->mutable_center_lane()
-                    ->mutable_right_boundary()
-                    .mutable_curve()
-                    .mutable_pts();
+    refe_line = section->center_lane()->right_boundary().curve().pts();
+    inner_attrs = section->center_lane()->right_boundary().attrs();
 
     /// right lanes
     for (const auto& ele_lane : ele_section.right().lanes()) {
@@ -205,12 +299,115 @@ Convertor& Convertor::ConvertSection(const element::Road& ele_road,
       lane->set_id(section->id() + "_" +
                    std::to_string(ele_lane.attribute().id()));
       lane->set_parent_id(section->id());
+      lane->set_type(ele_lane.attribute().type());
       LaneSampling(ele_lane, lane, refe_line);
+      lane->mutable_left_boundary().set_attrs(inner_attrs);
+      inner_attrs = RoadMarks(ele_lane);
+      lane->mutable_right_boundary().set_attrs(inner_attrs);
       data_->mutable_lanes()[lane->id()] = lane;
-      refe_line = lane->mutable_right_boundary().mutable_curve().mutable_pts();
+      refe_line = lane->right_boundary().curve().pts();
+    }
+  }
+
+  return *this;
+}
+
+Convertor& Convertor::BuildPolylines() {
+  if (!Continue()) return *this;
+  std::vector<core::Lane*> lanes;
+  lanes.reserve(data_->lanes().size());
+  for (auto& lane_item : data_->mutable_lanes()) {
+    lanes.emplace_back(lane_item.second.get());
+  }
+  std::atomic<size_t> next(0);
+  auto work = [&]() {
+    for (size_t i = next++; i < lanes.size(); i = next++) {
+      lanes[i]->mutable_central_curve().BuildPolyline();
+      lanes[i]->mutable_left_boundary().mutable_curve().BuildPolyline();
+      lanes[i]->mutable_right_boundary().mutable_curve().BuildPolyline();
     }
+  };
+  const size_t num_threads = std::min<size_t>(
+      lanes.size(),
+      std::max(1u, std::min(kMaxBuildThreads,
+                            std::thread::hardware_concurrency())));
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < num_threads; ++i) workers.emplace_back(work);
+  work();
+  for (auto& worker : workers) worker.join();
+  return *this;
+}
+
+Convertor& Convertor::BuildRoadIndex() {
+  if (!Continue()) return *this;
+  bvh::RoadIndexLanes lanes;
+  for (const auto& lane_item : data_->lanes()) {
+    const auto& lane = lane_item.second;
+    // the center lane is the reference line, not a lane to be on
+    if (lane->id() == lane->parent_id() + "_0") continue;
+    auto section = data_->sections().find(lane->parent_id());
+    if (section == data_->sections().end()) continue;
+    lanes.push_back({section->second->parent_id(), lane->parent_id(),
+                     lane->id(), &lane->central_curve().polyline()});
   }
+  bvh::RoadIndexParam param;
+  param.max_threads = std::max(
+      1u, std::min(kMaxBuildThreads, std::thread::hardware_concurrency()));
+  auto factory = cactus::Factory::Instance();
+  auto road_index = factory->GetObject<bvh::RoadIndex>("road_index");
+  road_index->Init(lanes, param);
+  ENGINE_INFO("Build Road Index End, roads: " << road_index->num_roads()
+                                               << ", lanes: "
+                                               << road_index->num_lanes())
+  return *this;
+}
 
+Convertor& Convertor::BuildLaneGraph() {
+  if (!Continue()) return *this;
+  route::LaneGraphLanes lanes;
+  for (const auto& lane_item : data_->lanes()) {
+    const auto& lane = lane_item.second;
+    if (core::Lane::Type::DRIVING != lane->type()) continue;
+    if (lane->id() == lane->parent_id() + "_0") continue;
+    auto section = data_->sections().find(lane->parent_id());
+    if (section == data_->sections().end()) continue;
+    auto road = data_->roads().find(section->second->parent_id());
+    if (road == data_->roads().end()) continue;
+    const auto& curve = lane->central_curve().polyline();
+    if (curve.num_points() < 2) continue;
+    route::LaneGraphLane graph_lane;
+    graph_lane.id = lane->id();
+    graph_lane.section_id = lane->parent_id();
+    graph_lane.index =
+        std::stoi(lane->id().substr(lane->parent_id().size() + 1));
+    graph_lane.length = curve.length();
+    const size_t last = curve.num_points() - 1;
+    const geometry::Vec2d first_direction = curve.point(1) - curve.point(0);
+    const geometry::Vec2d last_direction =
+        curve.point(last) - curve.point(last - 1);
+    graph_lane.entry = curve.point(0);
+    graph_lane.exit = curve.point(last);
+    graph_lane.entry_heading =
+        std::atan2(first_direction.y(), first_direction.x());
+    graph_lane.exit_heading =
+        std::atan2(last_direction.y(), last_direction.x());
+    // right lanes run along the reference line with right hand traffic, the
+    // others are driven against their curve
+    if ((graph_lane.index < 0) != (RoadRule::RHT == road->second->rule())) {
+      graph_lane.reversed = true;
+      std::swap(graph_lane.entry, graph_lane.exit);
+      std::swap(graph_lane.entry_heading, graph_lane.exit_heading);
+      graph_lane.entry_heading += M_PI;
+      graph_lane.exit_heading += M_PI;
+    }
+    lanes.emplace_back(graph_lane);
+  }
+  auto factory = cactus::Factory::Instance();
+  auto lane_graph = factory->GetObject<route::LaneGraph>("lane_graph");
+  lane_graph->Init(lanes);
+  ENGINE_INFO("Build Lane Graph End, lanes: " << lane_graph->num_lanes()
+                                              << ", edges: "
+                                              << lane_graph->num_edges())
   return *this;
 }
 
@@ -218,10 +415,194 @@ Convertor& Convertor::BuildKDTree() {
   if (!Continue()) return *this;
   auto factory = cactus::Factory::Instance();
   auto kdtree = factory->GetObject<kdtree::KDTree>("kdtree");
-  kdtree->Init(center_line_pts_);
+  kdtree::KDTreeParam param;
+  param.max_threads = std::max(
+      1u, std::min(kMaxBuildThreads, std::thread::hardware_concurrency()));
+  // the samples are complete only once every road is converted, so the
+  // index is built in the background while the remaining structures are
+  kdtree_build_ = std::async(
+      std::launch::async,
+      [kdtree, param](const core::Curve::Points& samples) {
+        kdtree->Init(samples, param);
+      },
+      std::move(center_line_pts_));
+  core::Curve::Points().swap(center_line_pts_);
+  return *this;
+}
+
+Convertor& Convertor::BuildEdgeBVH() {
+  if (!Continue()) return *this;
+  bvh::Segments segments;
+  bvh::SegmentIds ids;
+  for (const auto& section_item : data_->sections()) {
+    const auto& section = section_item.second;
+    auto road = data_->roads().find(section->parent_id());
+    // connecting roads overlap each other inside a junction
+    if (road == data_->roads().end() || !road->second->junction_id().empty()) {
+      continue;
+    }
+    // sampling chains outwards, the last lane holds the outer edge
+    if (section->left_lanes().empty()) {
+      AppendEdgeSegments(*section->center_lane(),
+                         section->center_lane()->left_boundary().curve(),
+                         &segments, &ids);
+    } else {
+      auto lane = section->left_lanes().back();
+      AppendEdgeSegments(*lane, lane->right_boundary().curve(), &segments,
+                         &ids);
+    }
+    if (section->right_lanes().empty()) {
+      AppendEdgeSegments(*section->center_lane(),
+                         section->center_lane()->right_boundary().curve(),
+                         &segments, &ids);
+    } else {
+      auto lane = section->right_lanes().back();
+      AppendEdgeSegments(*lane, lane->right_boundary().curve(), &segments,
+                         &ids);
+    }
+  }
+  auto factory = cactus::Factory::Instance();
+  auto edge_bvh = factory->GetObject<bvh::SegmentBVH>("edge_bvh");
+  edge_bvh->Init(segments, ids);
+  ENGINE_INFO("Build Edge BVH End, segments: " << segments.size())
+  return *this;
+}
+
+Convertor& Convertor::BuildBoundaryBVH() {
+  if (!Continue()) return *this;
+  bvh::Segments segments;
+  bvh::SegmentIds ids;
+  bvh::SegmentTags tags;
+  for (const auto& section_item : data_->sections()) {
+    const auto& section = section_item.second;
+    // the center lane has no width, its boundaries belong to its neighbours
+    const core::Lane::ConstPtrs sides[2] = {section->left_lanes(),
+                                            section->right_lanes()};
+    for (int k = 0; k < 2; ++k) {
+      const auto& lanes = sides[k];
+      for (size_t i = 0; i < lanes.size(); ++i) {
+        // lanes are ordered outwards, the outer boundary of the last one is
+        // the edge, and so is the inner one of the first if the other side
+        // of the road has no lanes
+        AppendBoundarySegments(*lanes[i], core::BoundarySide::INNER,
+                               0 == i && sides[1 - k].empty(), &segments,
+                               &ids, &tags);
+        AppendBoundarySegments(*lanes[i], core::BoundarySide::OUTER,
+                               i + 1 == lanes.size(), &segments, &ids, &tags);
+      }
+    }
+  }
+  auto factory = cactus::Factory::Instance();
+  auto boundary_bvh = factory->GetObject<bvh::SegmentBVH>("boundary_bvh");
+  boundary_bvh->Init(segments, ids, tags);
+  ENGINE_INFO("Build Boundary BVH End, segments: " << segments.size())
+  return *this;
+}
+
+Convertor& Convertor::BuildDrivableRaster() {
+  if (!Continue()) return *this;
+  raster::Polygons polygons;
+  for (const auto& lane_item : data_->lanes()) {
+    const auto& lane = lane_item.second;
+    if (core::Lane::Type::DRIVING != lane->type()) continue;
+    // left boundary forwards, right boundary back
+    const auto& left = lane->left_boundary().curve().pts();
+    const auto& right = lane->right_boundary().curve().pts();
+    raster::Polygon polygon;
+    polygon.reserve(left.size() + right.size());
+    for (const auto& point : left) {
+      polygon.emplace_back(point.x(), point.y());
+    }
+    for (auto it = right.rbegin(); it != right.rend(); ++it) {
+      polygon.emplace_back(it->x(), it->y());
+    }
+    polygons.emplace_back(std::move(polygon));
+  }
+  auto factory = cactus::Factory::Instance();
+  auto drivable_raster =
+      factory->GetObject<raster::DrivableRaster>("drivable_raster");
+  drivable_raster->Init(polygons);
+  ENGINE_INFO("Build Drivable Raster End, polygons: " << polygons.size())
+  return *this;
+}
+
+Convertor& Convertor::BuildDistanceField() {
+  if (!Continue()) return *this;
+  // the road surface, one outline per section between its outer edges
+  raster::Polygons polygons;
+  for (const auto& section_item : data_->sections()) {
+    const auto& section = section_item.second;
+    const auto left_lanes = section->left_lanes();
+    const auto right_lanes = section->right_lanes();
+    const auto& left_edge =
+        left_lanes.empty()
+            ? section->center_lane()->left_boundary().curve().pts()
+            : left_lanes.back()->right_boundary().curve().pts();
+    const auto& right_edge =
+        right_lanes.empty()
+            ? section->center_lane()->right_boundary().curve().pts()
+            : right_lanes.back()->right_boundary().curve().pts();
+    raster::Polygon polygon;
+    polygon.reserve(left_edge.size() + right_edge.size());
+    for (const auto& point : left_edge) {
+      polygon.emplace_back(point.x(), point.y());
+    }
+    for (auto it = right_edge.rbegin(); it != right_edge.rend(); ++it) {
+      polygon.emplace_back(it->x(), it->y());
+    }
+    polygons.emplace_back(std::move(polygon));
+  }
+  auto factory = cactus::Factory::Instance();
+  auto edge_bvh = factory->GetObject<bvh::SegmentBVH>("edge_bvh");
+  auto distance_field =
+      factory->GetObject<raster::DistanceField>("edge_distance_field");
+  // tiles are only computed once queried
+  distance_field->Init(edge_bvh, polygons);
+  ENGINE_INFO("Build Distance Field End, areas: " << polygons.size())
   return *this;
 }
 
+void Convertor::AppendBoundarySegments(const core::Lane& lane,
+                                       core::BoundarySide side,
+                                       bool road_edge,
+                                       bvh::Segments* const segments,
+                                       bvh::SegmentIds* const ids,
+                                       bvh::SegmentTags* const tags) {
+  const auto& pts = core::BoundarySide::INNER == side
+                        ? lane.left_boundary().curve().pts()
+                        : lane.right_boundary().curve().pts();
+  const auto& central = lane.central_curve().pts();
+  for (size_t i = 1; i < pts.size(); ++i) {
+    geometry::Vec2d start(pts[i - 1].x(), pts[i - 1].y());
+    geometry::Vec2d end(pts[i].x(), pts[i].y());
+    if (start.DistanceSquareTo(end) <= 1e-20) continue;
+    // orient the segment so the lane lies on its left, a ray crossing it
+    // from left to right leaves the lane
+    if (i - 1 < central.size()) {
+      const geometry::Vec2d inner(central[i - 1].x(), central[i - 1].y());
+      if ((end - start).CrossProd(inner - start) < 0) std::swap(start, end);
+    }
+    segments->emplace_back(start, end);
+    ids->emplace_back(lane.id());
+    tags->emplace_back(static_cast<uint32_t>(side) |
+                       (road_edge ? core::kRoadEdgeTag : 0));
+  }
+}
+
+void Convertor::AppendEdgeSegments(const core::Lane& lane,
+                                   const core::Curve& edge,
+                                   bvh::Segments* const segments,
+                                   bvh::SegmentIds* const ids) {
+  const auto& pts = edge.pts();
+  for (size_t i = 1; i < pts.size(); ++i) {
+    geometry::LineSegment2d segment({pts[i - 1].x(), pts[i - 1].y()},
+                                    {pts[i].x(), pts[i].y()});
+    if (segment.length() <= 1e-10) continue;
+    segments->emplace_back(segment);
+    ids->emplace_back(lane.id());
+  }
+}
+
 void Convertor::AppendKDTreeSample(const core::Curve::Point& point) {
   center_line_pts_.emplace_back(point);
 }
@@ -56,5 +56,135 @@ core::Header::ConstPtr Engine::GetHeader() {
   return impl_->GetHeader();
 }
 
+common::Stats Engine::GetStats() {
+  cactus::ReadLockGuard<cactus::AtomicRWLock> guard(rw_lock_);
+  return impl_->GetStats();
+}
+
+core::Road::ConstPtrs Engine::GetNearestRoads(double x, double y,
+                                              size_t num_closest) {
+  cactus::ReadLockGuard<cactus::AtomicRWLock> guard(rw_lock_);
+  return impl_->GetNearestRoads(x, y, num_closest);
+}
+
+core::Section::ConstPtrs Engine::GetNearestSections(double x, double y,
+                                                    size_t num_closest) {
+  cactus::ReadLockGuard<cactus::AtomicRWLock> guard(rw_lock_);
+  return impl_->GetNearestSections(x, y, num_closest);
+}
+
+core::LaneProjections Engine::GetNearestProjections(double x, double y,
+                                                    size_t num_closest) {
+  cactus::ReadLockGuard<cactus::AtomicRWLock> guard(rw_lock_);
+  return impl_->GetNearestProjections(x, y, num_closest);
+}
+
+bool Engine::GetProjection(const core::Id& lane_id, double x, double y,
+                           core::LaneProjection& projection) {
+  cactus::ReadLockGuard<cactus::AtomicRWLock> guard(rw_lock_);
+  return impl_->GetProjection(lane_id, x, y, projection);
+}
+
+std::vector<core::Lane::ConstPtrs> Engine::GetNearestLanes(
+    const geometry::Point4D& pose,
+    const std::vector<geometry::Point2D>& vehicle_points, size_t num_closest) {
+  cactus::ReadLockGuard<cactus::AtomicRWLock> guard(rw_lock_);
+  return impl_->GetNearestLanes(pose, vehicle_points, num_closest);
+}
+
+std::vector<core::Lane::ConstPtrs> Engine::GetNearestLanes(
+    const std::vector<geometry::GeoPoint>& geo_points, size_t num_closest) {
+  cactus::ReadLockGuard<cactus::AtomicRWLock> guard(rw_lock_);
+  return impl_->GetNearestLanes(geo_points, num_closest);
+}
+
+bool Engine::GetProjection(const core::Id& lane_id,
+                           const geometry::GeoPoint& geo,
+                           core::LaneProjection& projection) {
+  cactus::ReadLockGuard<cactus::AtomicRWLock> guard(rw_lock_);
+  return impl_->GetProjection(lane_id, geo, projection);
+}
+
+bool Engine::GeodeticToMap(const std::vector<geometry::GeoPoint>& geo_points,
+                           std::vector<geometry::Point2D>& points) {
+  cactus::ReadLockGuard<cactus::AtomicRWLock> guard(rw_lock_);
+  return impl_->GeodeticToMap(geo_points, points);
+}
+
+bool Engine::MapToGeodetic(const std::vector<geometry::Point2D>& points,
+                           std::vector<geometry::GeoPoint>& geo_points) {
+  cactus::ReadLockGuard<cactus::AtomicRWLock> guard(rw_lock_);
+  return impl_->MapToGeodetic(points, geo_points);
+}
+
+bool Engine::CheckTrajectory(const std::vector<geometry::Point4D>& poses,
+                             double length, double width,
+                             core::TrajectoryCollision& collision) {
+  cactus::ReadLockGuard<cactus::AtomicRWLock> guard(rw_lock_);
+  return impl_->CheckTrajectory(poses, length, width, collision);
+}
+
+bool Engine::Raycast(const geometry::Point2D& origin,
+                     const geometry::Point2D& direction, double max_range,
+                     core::RaycastHit& hit) {
+  cactus::ReadLockGuard<cactus::AtomicRWLock> guard(rw_lock_);
+  return impl_->Raycast(origin, direction, max_range, hit);
+}
+
+bool Engine::Raycast(const geometry::Point2D& origin,
+                     const std::vector<double>& headings, double max_range,
+                     core::RaycastHits& hits) {
+  cactus::ReadLockGuard<cactus::AtomicRWLock> guard(rw_lock_);
+  return impl_->Raycast(origin, headings, max_range, hits);
+}
+
+bool Engine::GetNearestBoundary(double x, double y,
+                                core::NearestBoundary& boundary) {
+  cactus::ReadLockGuard<cactus::AtomicRWLock> guard(rw_lock_);
+  return impl_->GetNearestBoundary(x, y, boundary);
+}
+
+bool Engine::GetNearestBoundary(const std::vector<geometry::Point2D>& points,
+                                core::NearestBoundaries& boundaries) {
+  cactus::ReadLockGuard<cactus::AtomicRWLock> guard(rw_lock_);
+  return impl_->GetNearestBoundary(points, boundaries);
+}
+
+bool Engine::RasterizeDrivable(const geometry::AABox2d& window,
+                               double resolution,
+                               raster::DrivableGrid& grid) {
+  cactus::ReadLockGuard<cactus::AtomicRWLock> guard(rw_lock_);
+  return impl_->RasterizeDrivable(window, resolution, grid);
+}
+
+bool Engine::GetEdgeDistance(const std::vector<geometry::Point2D>& points,
+                             core::EdgeDistances& distances) {
+  cactus::ReadLockGuard<cactus::AtomicRWLock> guard(rw_lock_);
+  return impl_->GetEdgeDistance(points, distances);
+}
+
+bool Engine::GetRoutes(const core::Id& from_lane, double from_s,
+                       const core::Id& to_lane, double to_s, size_t num_routes,
+                       core::RoutingPaths& paths) {
+  cactus::ReadLockGuard<cactus::AtomicRWLock> guard(rw_lock_);
+  return impl_->GetRoutes(from_lane, from_s, to_lane, to_s, num_routes, paths);
+}
+
+bool Engine::GetRoute(const core::Id& from_lane, double from_s,
+                      const core::Id& to_lane, double to_s,
+                      core::RoutingPath& path) {
+  cactus::ReadLockGuard<cactus::AtomicRWLock> guard(rw_lock_);
+  return impl_->GetRoute(from_lane, from_s, to_lane, to_s, path);
+}
+
+bool Engine::SetLaneWeights(
+    const std::unordered_map<core::Id, double>& weights) {
+  // nothing shared is written in place: the router customizes a new metric
+  // and swaps it in atomically, the lane graph stays untouched, so a read
+  // lock lets queries go on meanwhile
+  cactus::ReadLockGuard<cactus::AtomicRWLock> guard(rw_lock_);
+  return impl_->SetLaneWeights(weights);
+}
+
 }  // namespace engine
 }  // namespace opendrive
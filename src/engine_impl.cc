@@ -1,9 +1,50 @@
 #include "opendrive-engine/engine_impl.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "opendrive-engine/geometry/aabox2d.h"
+#include "opendrive-engine/geometry/box2d.h"
+#include "opendrive-engine/geometry/transform.h"
+#include "opendrive-engine/geometry/vec2d_batch.h"
+
 namespace opendrive {
 namespace engine {
 
-EngineImpl::EngineImpl() : param_(nullptr), data_(nullptr), kdtree_(nullptr) {}
+namespace {
+
+// the edge candidates are fetched for a region this much larger than a
+// single pose needs and reused until a footprint leaves it
+constexpr double kEdgeCacheSlack = 10.0;
+// the way between two poses is checked for leaving the driving lanes at
+// most this far apart
+constexpr double kMaxSweepStep = 1.0;
+
+uint64_t DoubleBits(double d) {
+  uint64_t bits = 0;
+  std::memcpy(&bits, &d, sizeof(bits));
+  return bits;
+}
+
+}  // namespace
+
+EngineImpl::EngineImpl()
+    : param_(nullptr),
+      data_(nullptr),
+      kdtree_(nullptr),
+      road_index_(nullptr),
+      lane_graph_(nullptr),
+      edge_bvh_(nullptr),
+      boundary_bvh_(nullptr),
+      drivable_raster_(nullptr),
+      edge_distance_field_(nullptr),
+      geo_referenced_(false),
+      map_version_(0) {}
 
 Status EngineImpl::Init(const common::Param& param) {
   // factory load
@@ -11,14 +52,94 @@ Status EngineImpl::Init(const common::Param& param) {
   factory->Register<common::Param>(&param, "engine_param", true);
   factory->Register<core::Data>("core_data", true);
   factory->Register<kdtree::KDTree>("kdtree", true);
+  factory->Register<bvh::RoadIndex>("road_index", true);
+  factory->Register<route::LaneGraph>("lane_graph", true);
+  factory->Register<bvh::SegmentBVH>("edge_bvh", true);
+  factory->Register<bvh::SegmentBVH>("boundary_bvh", true);
+  factory->Register<raster::DrivableRaster>("drivable_raster", true);
+  factory->Register<raster::DistanceField>("edge_distance_field", true);
   param_ = factory->GetObject<common::Param>("engine_param");
   data_ = factory->GetObject<core::Data>("core_data");
   kdtree_ = factory->GetObject<kdtree::KDTree>("kdtree");
+  road_index_ = factory->GetObject<bvh::RoadIndex>("road_index");
+  lane_graph_ = factory->GetObject<route::LaneGraph>("lane_graph");
+  edge_bvh_ = factory->GetObject<bvh::SegmentBVH>("edge_bvh");
+  boundary_bvh_ = factory->GetObject<bvh::SegmentBVH>("boundary_bvh");
+  drivable_raster_ =
+      factory->GetObject<raster::DrivableRaster>("drivable_raster");
+  edge_distance_field_ =
+      factory->GetObject<raster::DistanceField>("edge_distance_field");
   ENGINE_INFO("Factory Load End.");
 
   // convert data
   Convertor convertor;
-  return convertor.Start();
+  auto status = convertor.Start();
+  if (ErrorCode::OK == status.error_code) {
+    CollectStats();
+    BuildLaneTable();
+    alternative_router_.Init(lane_graph_);
+    customizable_router_.Init(lane_graph_);
+    ++map_version_;
+    nearest_lanes_cache_.Init(
+        param_->query_cache_resolution > 0 ? param_->query_cache_size : 0);
+    const auto& geo_reference = data_->header()->geo_reference();
+    geo_referenced_ =
+        !geo_reference.empty() && geo_projection_.Init(geo_reference);
+    if (!geo_reference.empty() && !geo_referenced_) {
+      ENGINE_INFO("Unsupported geoReference: " << geo_reference)
+    }
+  }
+  return status;
+}
+
+void EngineImpl::CollectStats() {
+  map_stats_ = common::Stats();
+  map_stats_.road_num = data_->roads().size();
+  map_stats_.section_num = data_->sections().size();
+  map_stats_.lane_num = data_->lanes().size();
+  size_t point_num = 0;
+  for (const auto& lane_item : data_->lanes()) {
+    const auto& lane = lane_item.second;
+    point_num += lane->central_curve().pts().size() +
+                 lane->left_boundary().curve().pts().size() +
+                 lane->right_boundary().curve().pts().size();
+    if (lane->id() != lane->parent_id() + "_0") {  // center lane not sampled
+      map_stats_.sample_num += lane->central_curve().pts().size();
+    }
+  }
+  // points dominate, ids are short enough to stay in the sso buffer
+  map_stats_.memory_bytes =
+      point_num * sizeof(core::Curve::Point) +
+      map_stats_.lane_num * sizeof(core::Lane) +
+      map_stats_.section_num * sizeof(core::Section) +
+      map_stats_.road_num * sizeof(core::Road) +
+      map_stats_.sample_num *
+          (2 * sizeof(double) + sizeof(size_t) + sizeof(core::Id));
+}
+
+void EngineImpl::BuildLaneTable() {
+  lane_table_.clear();
+  lane_index_.clear();
+  lane_table_.reserve(data_->lanes().size());
+  for (const auto& lane_item : data_->lanes()) {
+    lane_index_[lane_item.second.get()] =
+        static_cast<uint32_t>(lane_table_.size());
+    lane_table_.emplace_back(lane_item.second);
+  }
+}
+
+common::Stats EngineImpl::GetStats() const {
+  common::Stats stats = map_stats_;
+  stats.nearest_points.count = nearest_points_latency_.count();
+  stats.nearest_points.seconds = nearest_points_latency_.seconds();
+  stats.nearest_lanes.count = nearest_lanes_latency_.count();
+  stats.nearest_lanes.seconds = nearest_lanes_latency_.seconds();
+  stats.nearest_lanes_cached.count = nearest_lanes_cached_latency_.count();
+  stats.nearest_lanes_cached.seconds = nearest_lanes_cached_latency_.seconds();
+  stats.nearest_lanes_cache_misses = nearest_lanes_cache_misses_.Value();
+  stats.projection.count = projection_latency_.count();
+  stats.projection.seconds = projection_latency_.seconds();
+  return stats;
 }
 
 std::string EngineImpl::GetXodrVersion() const {
@@ -98,23 +219,587 @@ core::Road::ConstPtrs EngineImpl::GetRoads() const {
 
 core::Header::ConstPtr EngineImpl::GetHeader() const { return data_->header(); }
 
-kdtree::SearchResults EngineImpl::GetNearestPoints(double x, double y,
-                                                   size_t num_closest) {
-  return kdtree_->Query(x, y, num_closest);
+kdtree::SearchResults EngineImpl::GetNearestPoints(
+    double x, double y, size_t num_closest, const kdtree::SearchParam& param) {
+  common::ScopedLatency latency(&nearest_points_latency_);
+  return kdtree_->Query(x, y, num_closest, param);
 }
 
-core::Lane::ConstPtrs EngineImpl::GetNearestLanes(double x, double y,
-                                                  size_t num_closest) {
-  core::Lane::ConstPtrs lanes;
-  auto search_ret = kdtree_->Query(x, y, num_closest);
-  for (const auto& it : search_ret) {
+bool EngineImpl::NearestLanesKey(double x, double y, size_t num_closest,
+                                 const kdtree::SearchParam& param,
+                                 common::QueryCacheKey* const key) const {
+  if (!nearest_lanes_cache_.capacity() ||
+      num_closest > common::QueryCache::kMaxValues || !(std::abs(x) < 1e15) ||
+      !(std::abs(y) < 1e15)) {
+    return false;
+  }
+  const double resolution = param_->query_cache_resolution;
+  key->x = static_cast<int64_t>(std::floor(x / resolution));
+  key->y = static_cast<int64_t>(std::floor(y / resolution));
+  key->k = static_cast<uint32_t>(num_closest);
+  key->eps = DoubleBits(param.eps);
+  key->max_distance = DoubleBits(param.max_distance);
+  return true;
+}
+
+bool EngineImpl::LookupNearestLanes(const common::QueryCacheKey& key,
+                                    core::Lane::ConstPtrs* const lanes) const {
+  uint32_t indices[common::QueryCache::kMaxValues];
+  size_t count = 0;
+  if (!nearest_lanes_cache_.Lookup(key, map_version_, indices, &count)) {
+    return false;
+  }
+  lanes->reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    lanes->emplace_back(lane_table_[indices[i]]);
+  }
+  return true;
+}
+
+void EngineImpl::InsertNearestLanes(const common::QueryCacheKey& key,
+                                    const core::Lane::ConstPtrs& lanes) {
+  uint32_t indices[common::QueryCache::kMaxValues];
+  size_t count = 0;
+  for (const auto& lane : lanes) {
+    indices[count++] = lane_index_.at(lane.get());
+  }
+  nearest_lanes_cache_.Insert(key, map_version_, indices, count);
+}
+
+void EngineImpl::LanesOf(const kdtree::SearchResults& results,
+                         core::Lane::ConstPtrs* const lanes) const {
+  for (const auto& it : results) {
     core::Id lane_id = common::GetLaneIdById(it.id);
     if (!lane_id.empty()) {
-      lanes.emplace_back(data_->lanes().at(lane_id));
+      lanes->emplace_back(data_->lanes().at(lane_id));
+    }
+  }
+}
+
+core::Lane::ConstPtrs EngineImpl::GetNearestLanes(
+    double x, double y, size_t num_closest, const kdtree::SearchParam& param) {
+  common::ScopedLatency latency(&nearest_lanes_latency_);
+  common::ScopedLatency cached_latency(nullptr);
+  core::Lane::ConstPtrs lanes;
+  // repeated queries from about the same place skip the kdtree entirely
+  common::QueryCacheKey key;
+  const bool cacheable = NearestLanesKey(x, y, num_closest, param, &key);
+  if (cacheable) {
+    if (LookupNearestLanes(key, &lanes)) {
+      cached_latency.set_counter(&nearest_lanes_cached_latency_);
+      return lanes;
     }
+    nearest_lanes_cache_misses_.Add();
   }
+  LanesOf(kdtree_->Query(x, y, num_closest, param), &lanes);
+  if (cacheable) InsertNearestLanes(key, lanes);
   return lanes;
 }
 
+std::vector<core::Lane::ConstPtrs> EngineImpl::GetNearestLanes(
+    const std::vector<geometry::Point2D>& points, size_t num_closest,
+    const kdtree::SearchParam& param) {
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<core::Lane::ConstPtrs> lanes_list(points.size());
+  std::vector<common::QueryCacheKey> keys(points.size());
+  std::vector<uint8_t> cacheable(points.size(), 0);
+  std::vector<geometry::Point2D> misses;
+  std::vector<size_t> miss_indices;
+  size_t hits = 0;
+  for (size_t i = 0; i < points.size(); ++i) {
+    const auto& point = points[i];
+    if (NearestLanesKey(point.x(), point.y(), num_closest, param, &keys[i])) {
+      if (LookupNearestLanes(keys[i], &lanes_list[i])) {
+        ++hits;
+        continue;
+      }
+      cacheable[i] = 1;
+      nearest_lanes_cache_misses_.Add();
+    }
+    misses.emplace_back(point);
+    miss_indices.emplace_back(i);
+  }
+  const auto lookup_end = std::chrono::steady_clock::now();
+  // the kdtree orders the remaining points for locality itself
+  const auto results = kdtree_->Query(misses, num_closest, param);
+  for (size_t j = 0; j < results.size(); ++j) {
+    const size_t i = miss_indices[j];
+    LanesOf(results[j], &lanes_list[i]);
+    if (cacheable[i]) InsertNearestLanes(keys[i], lanes_list[i]);
+  }
+  auto nanoseconds = [](std::chrono::steady_clock::duration duration) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration)
+        .count();
+  };
+  nearest_lanes_latency_.Record(
+      nanoseconds(std::chrono::steady_clock::now() - start), points.size());
+  // the lookup pass is attributed to the hits
+  if (hits) {
+    nearest_lanes_cached_latency_.Record(nanoseconds(lookup_end - start),
+                                         hits);
+  }
+  return lanes_list;
+}
+
+std::vector<core::Lane::ConstPtrs> EngineImpl::GetNearestLanes(
+    const geometry::Point4D& pose,
+    const std::vector<geometry::Point2D>& vehicle_points, size_t num_closest) {
+  geometry::Vec2dBatch batch;
+  batch.reserve(vehicle_points.size());
+  for (const auto& point : vehicle_points) {
+    batch.emplace_back(point.x(), point.y());
+  }
+  geometry::Transform2d(pose).Apply(&batch);
+  std::vector<geometry::Point2D> points;
+  points.reserve(batch.size());
+  for (size_t i = 0; i < batch.size(); ++i) {
+    points.emplace_back(batch.x()[i], batch.y()[i]);
+  }
+  return GetNearestLanes(points, num_closest);
+}
+
+std::vector<core::Lane::ConstPtrs> EngineImpl::GetNearestLanes(
+    const std::vector<geometry::GeoPoint>& geo_points, size_t num_closest) {
+  std::vector<geometry::Point2D> points;
+  if (!GeodeticToMap(geo_points, points)) {
+    return {};
+  }
+  return GetNearestLanes(points, num_closest);
+}
+
+bool EngineImpl::GetProjection(const core::Id& lane_id,
+                               const geometry::GeoPoint& geo,
+                               core::LaneProjection& projection) const {
+  if (!geo_referenced_) {
+    return false;
+  }
+  double x = 0;
+  double y = 0;
+  geo_projection_.Forward(geo.lat(), geo.lon(), &x, &y);
+  return GetProjection(lane_id, x, y, projection);
+}
+
+bool EngineImpl::GeodeticToMap(
+    const std::vector<geometry::GeoPoint>& geo_points,
+    std::vector<geometry::Point2D>& points) const {
+  points.clear();
+  if (!geo_referenced_) {
+    return false;
+  }
+  // structure of arrays for the batch kernel
+  const size_t size = geo_points.size();
+  std::vector<double> buffer(4 * size);
+  double* lat = buffer.data();
+  double* lon = lat + size;
+  double* x = lon + size;
+  double* y = x + size;
+  for (size_t i = 0; i < size; ++i) {
+    lat[i] = geo_points[i].lat();
+    lon[i] = geo_points[i].lon();
+  }
+  geo_projection_.Forward(lat, lon, size, x, y);
+  points.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    points.emplace_back(x[i], y[i]);
+  }
+  return true;
+}
+
+bool EngineImpl::MapToGeodetic(
+    const std::vector<geometry::Point2D>& points,
+    std::vector<geometry::GeoPoint>& geo_points) const {
+  geo_points.clear();
+  if (!geo_referenced_) {
+    return false;
+  }
+  const size_t size = points.size();
+  std::vector<double> buffer(4 * size);
+  double* x = buffer.data();
+  double* y = x + size;
+  double* lat = y + size;
+  double* lon = lat + size;
+  for (size_t i = 0; i < size; ++i) {
+    x[i] = points[i].x();
+    y[i] = points[i].y();
+  }
+  geo_projection_.Inverse(x, y, size, lat, lon);
+  geo_points.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    geo_points.emplace_back(lat[i], lon[i]);
+  }
+  return true;
+}
+
+core::Road::ConstPtrs EngineImpl::GetNearestRoads(double x, double y,
+                                                  size_t num_closest) const {
+  core::Road::ConstPtrs roads;
+  bvh::RoadIndexResults results;
+  road_index_->Search({x, y}, bvh::RoadIndexLevel::ROAD, num_closest,
+                      &results);
+  for (const auto& result : results) {
+    auto road = GetRoadById(result.id);
+    if (road) roads.emplace_back(road);
+  }
+  return roads;
+}
+
+core::Section::ConstPtrs EngineImpl::GetNearestSections(
+    double x, double y, size_t num_closest) const {
+  core::Section::ConstPtrs sections;
+  bvh::RoadIndexResults results;
+  road_index_->Search({x, y}, bvh::RoadIndexLevel::SECTION, num_closest,
+                      &results);
+  for (const auto& result : results) {
+    auto section = GetSectionById(result.id);
+    if (section) sections.emplace_back(section);
+  }
+  return sections;
+}
+
+core::LaneProjections EngineImpl::GetNearestProjections(
+    double x, double y, size_t num_closest) const {
+  common::ScopedLatency latency(&projection_latency_);
+  core::LaneProjections projections;
+  bvh::RoadIndexResults results;
+  road_index_->Search({x, y}, bvh::RoadIndexLevel::LANE, num_closest,
+                      &results);
+  projections.reserve(results.size());
+  for (const auto& result : results) {
+    core::LaneProjection projection;
+    projection.lane_id = result.lane_id;
+    projection.s = result.s;
+    projection.l = result.lateral;
+    projection.heading = result.heading;
+    projection.dist = result.distance;
+    projections.emplace_back(projection);
+  }
+  return projections;
+}
+
+bool EngineImpl::GetProjection(const core::Id& lane_id, double x, double y,
+                               core::LaneProjection& projection) const {
+  common::ScopedLatency latency(&projection_latency_);
+  auto lane = GetLaneById(lane_id);
+  if (!lane || !common::ProjectOntoCurve(lane->central_curve(), x, y,
+                                         projection)) {
+    return false;
+  }
+  projection.lane_id = lane_id;
+  return true;
+}
+
+bool EngineImpl::CheckTrajectory(const std::vector<geometry::Point4D>& poses,
+                                 double length, double width,
+                                 core::TrajectoryCollision& collision) const {
+  collision = core::TrajectoryCollision();
+  if (poses.empty() || length <= 0 || width <= 0) {
+    return false;
+  }
+  collision.margin = core::kMaxTrajectoryMargin;
+  const double sweep_step = std::min(kMaxSweepStep, 0.5 * width);
+  std::vector<geometry::Vec2d> corners;
+  // consecutive poses are close, so one bvh query serves many of them
+  const double reach =
+      0.5 * std::hypot(length, width) + core::kMaxTrajectoryMargin;
+  geometry::AABox2d cache_box;
+  bool cache_valid = false;
+  bvh::SegmentIndices candidates;
+  for (size_t i = 0; i < poses.size(); ++i) {
+    const geometry::Vec2d center(poses[i].x(), poses[i].y());
+    if (!cache_valid || center.x() - reach < cache_box.min_x() ||
+        center.x() + reach > cache_box.max_x() ||
+        center.y() - reach < cache_box.min_y() ||
+        center.y() + reach > cache_box.max_y()) {
+      const double size = 2.0 * (reach + kEdgeCacheSlack);
+      cache_box = geometry::AABox2d(center, size, size);
+      edge_bvh_->Query(cache_box, &candidates);
+      cache_valid = true;
+    }
+    const geometry::Box2d footprint(center, poses[i].heading(), length, width);
+    for (size_t index : candidates) {
+      const auto& segment = edge_bvh_->segment(index);
+      // edges farther than the current margin cannot lower it
+      if (std::max(segment.start().x(), segment.end().x()) <
+              footprint.min_x() - collision.margin ||
+          std::min(segment.start().x(), segment.end().x()) >
+              footprint.max_x() + collision.margin ||
+          std::max(segment.start().y(), segment.end().y()) <
+              footprint.min_y() - collision.margin ||
+          std::min(segment.start().y(), segment.end().y()) >
+              footprint.max_y() + collision.margin) {
+        continue;
+      }
+      const double distance = footprint.DistanceTo(segment);
+      if (distance < collision.margin) {
+        collision.margin = distance;
+        collision.boundary_id = edge_bvh_->id(index);
+      }
+      if (distance <= 1e-10) {
+        collision.index = static_cast<int>(i);
+        collision.margin = 0;
+        return true;
+      }
+    }
+    // a footprint off the driving lanes touches no edge if it is entirely
+    // off the road, and junctions have no edges at all
+    bool contained = drivable_raster_->Contains(center);
+    footprint.GetAllCorners(&corners);
+    for (const auto& corner : corners) {
+      contained = contained && drivable_raster_->Contains(corner);
+    }
+    if (!contained ||
+        (i > 0 && LeavesDrivable({poses[i - 1].x(), poses[i - 1].y()}, center,
+                                 sweep_step))) {
+      collision.index = static_cast<int>(i);
+      collision.margin = 0;
+      return true;
+    }
+  }
+  return true;
+}
+
+bool EngineImpl::LeavesDrivable(const geometry::Vec2d& from,
+                                const geometry::Vec2d& to, double step) const {
+  const geometry::Vec2d delta = to - from;
+  const double length = delta.Length();
+  if (length <= 1e-10) return false;
+  // crossing a road edge, or off the driving lanes between two samples
+  double distance = 0;
+  if (edge_bvh_->Raycast(from, delta / length, length, &distance) >= 0) {
+    return true;
+  }
+  const int samples = static_cast<int>(std::ceil(length / step));
+  for (int k = 1; k < samples; ++k) {
+    const double ratio = static_cast<double>(k) / samples;
+    if (!drivable_raster_->Contains(from + delta * ratio)) return true;
+  }
+  return false;
+}
+
+bool EngineImpl::Raycast(const geometry::Point2D& origin,
+                         const geometry::Point2D& direction, double max_range,
+                         core::RaycastHit& hit) const {
+  hit = core::RaycastHit();
+  const double norm = std::hypot(direction.x(), direction.y());
+  if (norm <= 1e-10 || max_range <= 0) {
+    return false;
+  }
+  const geometry::Vec2d from(origin.x(), origin.y());
+  const geometry::Vec2d unit(direction.x() / norm, direction.y() / norm);
+  double distance = 0;
+  const int index = boundary_bvh_->Raycast(from, unit, max_range, &distance);
+  if (index >= 0) {
+    hit.hit = true;
+    hit.distance = distance;
+    hit.x = from.x() + distance * unit.x();
+    hit.y = from.y() + distance * unit.y();
+    hit.lane_id = boundary_bvh_->id(index);
+    hit.side = static_cast<core::BoundarySide>(boundary_bvh_->tag(index) &
+                                               core::kBoundarySideTag);
+  }
+  return true;
+}
+
+bool EngineImpl::Raycast(const geometry::Point2D& origin,
+                         const std::vector<double>& headings,
+                         double max_range, core::RaycastHits& hits) const {
+  hits.resize(headings.size());
+  for (size_t i = 0; i < headings.size(); ++i) {
+    const geometry::Point2D direction(std::cos(headings[i]),
+                                      std::sin(headings[i]));
+    if (!Raycast(origin, direction, max_range, hits[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool EngineImpl::GetNearestBoundary(double x, double y,
+                                    core::NearestBoundary& boundary) const {
+  boundary = core::NearestBoundary();
+  if (boundary_bvh_->empty()) {
+    return false;
+  }
+  const geometry::Vec2d point(x, y);
+  double distance = 0;
+  const int index = boundary_bvh_->Nearest(
+      point, std::numeric_limits<double>::infinity(), &distance);
+  FillNearestBoundary(index, point, distance, &boundary);
+  return true;
+}
+
+bool EngineImpl::GetNearestBoundary(
+    const std::vector<geometry::Point2D>& points,
+    core::NearestBoundaries& boundaries) const {
+  boundaries.clear();
+  if (boundary_bvh_->empty()) {
+    return false;
+  }
+  boundaries.resize(points.size());
+  int index = -1;
+  for (size_t i = 0; i < points.size(); ++i) {
+    const geometry::Vec2d point(points[i].x(), points[i].y());
+    // trajectory points are close to each other, the distance to the
+    // previous answer bounds the search for the next
+    const double bound =
+        index < 0 ? std::numeric_limits<double>::infinity()
+                  : std::sqrt(boundary_bvh_->segment(index).DistanceSquareTo(
+                        point));
+    double distance = 0;
+    index = boundary_bvh_->Nearest(point, bound, &distance);
+    FillNearestBoundary(index, point, distance, &boundaries[i]);
+  }
+  return true;
+}
+
+bool EngineImpl::RasterizeDrivable(const geometry::AABox2d& window,
+                                   double resolution,
+                                   raster::DrivableGrid& grid) {
+  return drivable_raster_->Rasterize(window, resolution, &grid);
+}
+
+bool EngineImpl::GetEdgeDistance(const std::vector<geometry::Point2D>& points,
+                                 core::EdgeDistances& distances) {
+  distances.clear();
+  // structure of arrays for the batch lookup
+  const size_t size = points.size();
+  std::vector<double> buffer(5 * size);
+  double* x = buffer.data();
+  double* y = x + size;
+  double* distance = y + size;
+  double* gradient_x = distance + size;
+  double* gradient_y = gradient_x + size;
+  for (size_t i = 0; i < size; ++i) {
+    x[i] = points[i].x();
+    y[i] = points[i].y();
+  }
+  if (!edge_distance_field_->Evaluate(x, y, size, distance, gradient_x,
+                                      gradient_y)) {
+    return false;
+  }
+  distances.resize(size);
+  for (size_t i = 0; i < size; ++i) {
+    distances[i].distance = distance[i];
+    distances[i].gradient_x = gradient_x[i];
+    distances[i].gradient_y = gradient_y[i];
+  }
+  return true;
+}
+
+bool EngineImpl::GetRoutes(const core::Id& from_lane, double from_s,
+                           const core::Id& to_lane, double to_s,
+                           size_t num_routes, core::RoutingPaths& paths) const {
+  paths.clear();
+  const int from = lane_graph_->FindLane(from_lane);
+  const int to = lane_graph_->FindLane(to_lane);
+  if (from < 0 || to < 0) return false;
+  // alternatives follow the customized weights too
+  const auto metric = customizable_router_.metric();
+  route::Routes routes;
+  if (!alternative_router_.Search(static_cast<uint32_t>(from),
+                                  DrivenS(from, from_s),
+                                  static_cast<uint32_t>(to), DrivenS(to, to_s),
+                                  num_routes, metric->weights, &routes)) {
+    return false;
+  }
+  paths.resize(routes.size());
+  for (size_t i = 0; i < routes.size(); ++i) {
+    ToRoutingPath(routes[i], &paths[i]);
+  }
+  return true;
+}
+
+bool EngineImpl::GetRoute(const core::Id& from_lane, double from_s,
+                          const core::Id& to_lane, double to_s,
+                          core::RoutingPath& path) const {
+  path = core::RoutingPath();
+  const int from = lane_graph_->FindLane(from_lane);
+  const int to = lane_graph_->FindLane(to_lane);
+  if (from < 0 || to < 0) return false;
+  route::Route route;
+  if (!customizable_router_.Search(
+          static_cast<uint32_t>(from), DrivenS(from, from_s),
+          static_cast<uint32_t>(to), DrivenS(to, to_s), &route)) {
+    return false;
+  }
+  ToRoutingPath(route, &path);
+  return true;
+}
+
+bool EngineImpl::SetLaneWeights(
+    const std::unordered_map<core::Id, double>& weights) {
+  // the graph is shared read only, the current weights live in the metric
+  // of the customizable router alone
+  std::vector<std::pair<uint32_t, double>> changes;
+  changes.reserve(weights.size());
+  for (const auto& weight : weights) {
+    const int index = lane_graph_->FindLane(weight.first);
+    if (index < 0) return false;
+    changes.emplace_back(static_cast<uint32_t>(index), weight.second);
+  }
+  return customizable_router_.Customize(changes);
+}
+
+double EngineImpl::DrivenS(int index, double s) const {
+  // the routers measure along the driving direction
+  const auto& lane = lane_graph_->lane(static_cast<uint32_t>(index));
+  return lane.reversed ? lane.length - s : s;
+}
+
+void EngineImpl::ToRoutingPath(const route::Route& route,
+                               core::RoutingPath* const path) const {
+  path->cost = route.cost;
+  path->length = route.length;
+  path->path.clear();
+  path->path.reserve(route.lanes.size());
+  for (uint32_t lane : route.lanes) {
+    path->path.emplace_back(lane_graph_->lane(lane).id);
+  }
+}
+
+void EngineImpl::FillNearestBoundary(
+    int index, const geometry::Vec2d& point, double distance,
+    core::NearestBoundary* const boundary) const {
+  if (index < 0) return;
+  geometry::Vec2d nearest;
+  boundary_bvh_->segment(index).DistanceSquareTo(point, &nearest);
+  const uint32_t tag = boundary_bvh_->tag(index);
+  boundary->found = true;
+  boundary->distance = distance;
+  boundary->x = nearest.x();
+  boundary->y = nearest.y();
+  boundary->lane_id = boundary_bvh_->id(index);
+  boundary->side =
+      static_cast<core::BoundarySide>(tag & core::kBoundarySideTag);
+  boundary->road_edge = tag & core::kRoadEdgeTag;
+  auto lane = GetLaneById(boundary->lane_id);
+  if (!lane) return;
+  const auto& lane_boundary = core::BoundarySide::INNER == boundary->side
+                                  ? lane->left_boundary()
+                                  : lane->right_boundary();
+  const auto& attrs = lane_boundary.attrs();
+  if (attrs.empty()) return;
+  // road marks are keyed by their offset from the section start, which the
+  // sampled points carry, so interpolate it on the projected segment
+  const auto& pts = lane_boundary.curve().pts();
+  const auto& polyline = lane_boundary.curve().polyline();
+  double s = 0;
+  double lateral = 0;
+  const int segment = polyline.GetProjection(nearest, &s, &lateral);
+  if (segment >= 0 && polyline.num_points() == pts.size()) {
+    const double start = polyline.s(segment);
+    const double length = polyline.s(segment + 1) - start;
+    const double ratio = length > 0 ? (s - start) / length : 0;
+    s = pts[segment].start_position() +
+        ratio * (pts[segment + 1].start_position() -
+                 pts[segment].start_position());
+  }
+  boundary->type = attrs.front().boundary_type();
+  for (const auto& attr : attrs) {
+    if (attr.s() > s) break;
+    boundary->type = attr.boundary_type();
+  }
+}
+
 }  // namespace engine
 }  // namespace opendrive
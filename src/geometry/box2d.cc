@@ -1,5 +1,8 @@
 #include "opendrive-engine/geometry/box2d.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "opendrive-engine/geometry/polygon2d.h"
 
 namespace opendrive {
@@ -69,7 +72,9 @@ Box2d::Box2d(const AABox2d& aabox)
       half_width_(aabox.half_width()),
       heading_(0),
       cos_heading_(1),
-      sin_heading_(0) {}
+      sin_heading_(0) {
+  InitCorners();
+}
 
 void Box2d::InitCorners() {
   const double dx1 = cos_heading_ * half_length_;
@@ -82,6 +87,10 @@ void Box2d::InitCorners() {
   corners_.emplace_back(center_.x() - dx1 - dx2, center_.y() - dy1 - dy2);
   corners_.emplace_back(center_.x() - dx1 + dx2, center_.y() - dy1 + dy2);
 
+  max_x_ = std::numeric_limits<double>::lowest();
+  min_x_ = std::numeric_limits<double>::max();
+  max_y_ = std::numeric_limits<double>::lowest();
+  min_y_ = std::numeric_limits<double>::max();
   for (auto& corner : corners_) {
     max_x_ = std::fmax(corner.x(), max_x_);
     min_x_ = std::fmin(corner.x(), min_x_);
@@ -0,0 +1,253 @@
+#include "opendrive-engine/geometry/box2d_batch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace opendrive {
+namespace engine {
+namespace geometry {
+
+namespace {
+
+// Boxes per block. As in the polygon kernels the loops always run a full
+// block so that the compiler can vectorize them, the last block is padded
+// with boxes that can not overlap anything.
+constexpr size_t kBatchBlock = 32;
+
+struct Block {
+  double center_x[kBatchBlock];
+  double center_y[kBatchBlock];
+  double cos_heading[kBatchBlock];
+  double sin_heading[kBatchBlock];
+  double half_length[kBatchBlock];
+  double half_width[kBatchBlock];
+  double min_x[kBatchBlock];
+  double max_x[kBatchBlock];
+  double min_y[kBatchBlock];
+  double max_y[kBatchBlock];
+  // union aabb of the boxes in the block
+  double bound_min_x;
+  double bound_max_x;
+  double bound_min_y;
+  double bound_max_y;
+};
+
+// One box in scalar form, read from a Box2d or a Box2dBatch entry.
+struct Shape {
+  double center_x;
+  double center_y;
+  double cos_heading;
+  double sin_heading;
+  double half_length;
+  double half_width;
+  double min_x;
+  double max_x;
+  double min_y;
+  double max_y;
+};
+
+Shape ToShape(const Box2d& box) {
+  return {box.center_x(),    box.center_y(),  box.cos_heading(),
+          box.sin_heading(), box.half_length(), box.half_width(),
+          box.min_x(),       box.max_x(),     box.min_y(),
+          box.max_y()};
+}
+
+Shape ToShape(const Box2dBatch& boxes, const size_t i) {
+  return {boxes.center_x()[i],    boxes.center_y()[i],
+          boxes.cos_heading()[i], boxes.sin_heading()[i],
+          boxes.half_length()[i], boxes.half_width()[i],
+          boxes.min_x()[i],       boxes.max_x()[i],
+          boxes.min_y()[i],       boxes.max_y()[i]};
+}
+
+void CopyField(const double* const field, const size_t begin,
+               const size_t size, const double padding, double* const out) {
+  std::copy(field + begin, field + begin + size, out);
+  std::fill(out + size, out + kBatchBlock, padding);
+}
+
+// Boxes [begin, begin + kBatchBlock) of the batch. Padding boxes have an
+// empty aabb (min > max) so they never pass the broad phase.
+void LoadBlock(const Box2dBatch& boxes, const size_t begin,
+               Block* const block) {
+  const size_t size = std::min(kBatchBlock, boxes.size() - begin);
+  const double inf = std::numeric_limits<double>::infinity();
+  CopyField(boxes.center_x(), begin, size, 0.0, block->center_x);
+  CopyField(boxes.center_y(), begin, size, 0.0, block->center_y);
+  CopyField(boxes.cos_heading(), begin, size, 1.0, block->cos_heading);
+  CopyField(boxes.sin_heading(), begin, size, 0.0, block->sin_heading);
+  CopyField(boxes.half_length(), begin, size, 0.0, block->half_length);
+  CopyField(boxes.half_width(), begin, size, 0.0, block->half_width);
+  CopyField(boxes.min_x(), begin, size, inf, block->min_x);
+  CopyField(boxes.max_x(), begin, size, -inf, block->max_x);
+  CopyField(boxes.min_y(), begin, size, inf, block->min_y);
+  CopyField(boxes.max_y(), begin, size, -inf, block->max_y);
+  block->bound_min_x = *std::min_element(block->min_x, block->min_x + size);
+  block->bound_max_x = *std::max_element(block->max_x, block->max_x + size);
+  block->bound_min_y = *std::min_element(block->min_y, block->min_y + size);
+  block->bound_max_y = *std::max_element(block->max_y, block->max_y + size);
+}
+
+// Aabb test of the block against one box, first against the union of the
+// block then per lane. Returns whether any pair passed.
+bool BroadPhase(const Block& block, const Shape& box,
+                double* __restrict candidate) {
+  if (box.max_x < block.bound_min_x || box.min_x > block.bound_max_x ||
+      box.max_y < block.bound_min_y || box.min_y > block.bound_max_y) {
+    return false;
+  }
+  const double box_min_x = box.min_x;
+  const double box_max_x = box.max_x;
+  const double box_min_y = box.min_y;
+  const double box_max_y = box.max_y;
+  double any = 0.0;
+  for (size_t k = 0; k < kBatchBlock; ++k) {
+    const bool pass = (box_max_x >= block.min_x[k]) &
+                      (box_min_x <= block.max_x[k]) &
+                      (box_max_y >= block.min_y[k]) &
+                      (box_min_y <= block.max_y[k]);
+    candidate[k] = pass ? 1.0 : 0.0;
+    any += candidate[k];
+  }
+  return any > 0.0;
+}
+
+// Separating axis test of the block against one box, the four axes of
+// Box2d::HasOverlap evaluated for all lanes. overlap is or-ed with the
+// lanes that passed both phases.
+void NarrowPhase(const Block& block, const Shape& box,
+                 const double* __restrict candidate,
+                 double* __restrict overlap) {
+  const double cx = box.center_x;
+  const double cy = box.center_y;
+  const double cos_b = box.cos_heading;
+  const double sin_b = box.sin_heading;
+  const double hl_b = box.half_length;
+  const double hw_b = box.half_width;
+  const double dx3 = cos_b * hl_b;
+  const double dy3 = sin_b * hl_b;
+  const double dx4 = sin_b * hw_b;
+  const double dy4 = -cos_b * hw_b;
+  for (size_t k = 0; k < kBatchBlock; ++k) {
+    const double cos_a = block.cos_heading[k];
+    const double sin_a = block.sin_heading[k];
+    const double hl_a = block.half_length[k];
+    const double hw_a = block.half_width[k];
+    const double shift_x = cx - block.center_x[k];
+    const double shift_y = cy - block.center_y[k];
+    const double dx1 = cos_a * hl_a;
+    const double dy1 = sin_a * hl_a;
+    const double dx2 = sin_a * hw_a;
+    const double dy2 = -cos_a * hw_a;
+    const bool axis1 = std::abs(shift_x * cos_a + shift_y * sin_a) <=
+                       std::abs(dx3 * cos_a + dy3 * sin_a) +
+                           std::abs(dx4 * cos_a + dy4 * sin_a) + hl_a;
+    const bool axis2 = std::abs(shift_x * sin_a - shift_y * cos_a) <=
+                       std::abs(dx3 * sin_a - dy3 * cos_a) +
+                           std::abs(dx4 * sin_a - dy4 * cos_a) + hw_a;
+    const bool axis3 = std::abs(shift_x * cos_b + shift_y * sin_b) <=
+                       std::abs(dx1 * cos_b + dy1 * sin_b) +
+                           std::abs(dx2 * cos_b + dy2 * sin_b) + hl_b;
+    const bool axis4 = std::abs(shift_x * sin_b - shift_y * cos_b) <=
+                       std::abs(dx1 * sin_b - dy1 * cos_b) +
+                           std::abs(dx2 * sin_b - dy2 * cos_b) + hw_b;
+    const bool hit =
+        (candidate[k] > 0.0) & axis1 & axis2 & axis3 & axis4;
+    overlap[k] = hit ? 1.0 : overlap[k];
+  }
+}
+
+}  // namespace
+
+Box2dBatch::Box2dBatch(const std::vector<Box2d>& boxes) {
+  reserve(boxes.size());
+  for (const auto& box : boxes) {
+    push_back(box);
+  }
+}
+
+void Box2dBatch::reserve(size_t size) {
+  for (auto field : {&center_x_, &center_y_, &cos_heading_, &sin_heading_,
+                     &half_length_, &half_width_, &min_x_, &max_x_, &min_y_,
+                     &max_y_}) {
+    field->reserve(size);
+  }
+}
+
+void Box2dBatch::clear() {
+  for (auto field : {&center_x_, &center_y_, &cos_heading_, &sin_heading_,
+                     &half_length_, &half_width_, &min_x_, &max_x_, &min_y_,
+                     &max_y_}) {
+    field->clear();
+  }
+}
+
+void Box2dBatch::push_back(const Box2d& box) {
+  center_x_.emplace_back(box.center_x());
+  center_y_.emplace_back(box.center_y());
+  cos_heading_.emplace_back(box.cos_heading());
+  sin_heading_.emplace_back(box.sin_heading());
+  half_length_.emplace_back(box.half_length());
+  half_width_.emplace_back(box.half_width());
+  min_x_.emplace_back(box.min_x());
+  max_x_.emplace_back(box.max_x());
+  min_y_.emplace_back(box.min_y());
+  max_y_.emplace_back(box.max_y());
+}
+
+void Box2dBatch::HasOverlap(const Box2d& box,
+                            std::vector<uint8_t>* const overlaps) const {
+  const size_t n = size();
+  overlaps->resize(n);
+  const Shape shape = ToShape(box);
+  Block block;
+  double candidate[kBatchBlock];
+  double overlap[kBatchBlock];
+  for (size_t begin = 0; begin < n; begin += kBatchBlock) {
+    LoadBlock(*this, begin, &block);
+    std::fill(overlap, overlap + kBatchBlock, 0.0);
+    if (BroadPhase(block, shape, candidate)) {
+      NarrowPhase(block, shape, candidate, overlap);
+    }
+    const size_t block_size = std::min(kBatchBlock, n - begin);
+    for (size_t k = 0; k < block_size; ++k) {
+      (*overlaps)[begin + k] = overlap[k] > 0.0;
+    }
+  }
+}
+
+int Box2dBatch::FirstOverlap(const Box2dBatch& others) const {
+  const size_t n = size();
+  const size_t other_num = others.size();
+  Block block;
+  double candidate[kBatchBlock];
+  double overlap[kBatchBlock];
+  std::vector<Shape> shapes;
+  shapes.reserve(other_num);
+  for (size_t j = 0; j < other_num; ++j) {
+    shapes.emplace_back(ToShape(others, j));
+  }
+  for (size_t begin = 0; begin < n; begin += kBatchBlock) {
+    LoadBlock(*this, begin, &block);
+    std::fill(overlap, overlap + kBatchBlock, 0.0);
+    bool hit = false;
+    for (const auto& shape : shapes) {
+      if (BroadPhase(block, shape, candidate)) {
+        NarrowPhase(block, shape, candidate, overlap);
+        hit = true;
+      }
+    }
+    if (!hit) continue;
+    const size_t block_size = std::min(kBatchBlock, n - begin);
+    for (size_t k = 0; k < block_size; ++k) {
+      if (overlap[k] > 0.0) return static_cast<int>(begin + k);
+    }
+  }
+  return -1;
+}
+
+}  // namespace geometry
+}  // namespace engine
+}  // namespace opendrive
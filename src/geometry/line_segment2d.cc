@@ -11,48 +11,12 @@ bool IsWithin(double val, double bound1, double bound2) {
   return val >= bound1 - 1e-10 && val <= bound2 + 1e-10;
 }
 
-LineSegment2d::LineSegment2d() : heading_(0), length_(0) {
-  unit_direction_ = geometry::Vec2d(1, 0);
-}
-
-LineSegment2d::LineSegment2d(const geometry::Vec2d& start,
-                             const geometry::Vec2d& end)
-    : start_(start), end_(end) {
-  const double dx = end_.x() - start_.x();
-  const double dy = end_.y() - start_.y();
-  length_ = hypot(dx, dy);
-  unit_direction_ =
-      (length_ <= 1e-10 ? geometry::Vec2d(0, 0)
-                        : geometry::Vec2d(dx / length_, dy / length_));
-  heading_ = unit_direction_.Angle();
-}
-
 geometry::Vec2d LineSegment2d::rotate(const double angle) {
   geometry::Vec2d diff_vec = end_ - start_;
   diff_vec.SelfRotate(angle);
   return start_ + diff_vec;
 }
 
-double LineSegment2d::length() const { return length_; }
-
-double LineSegment2d::length_sqr() const { return length_ * length_; }
-
-double LineSegment2d::DistanceTo(const geometry::Vec2d& point) const {
-  if (length_ <= 1e-10) {
-    return point.DistanceTo(start_);
-  }
-  const double x0 = point.x() - start_.x();
-  const double y0 = point.y() - start_.y();
-  const double proj = x0 * unit_direction_.x() + y0 * unit_direction_.y();
-  if (proj <= 0.0) {
-    return hypot(x0, y0);
-  }
-  if (proj >= length_) {
-    return point.DistanceTo(end_);
-  }
-  return std::abs(x0 * unit_direction_.y() - y0 * unit_direction_.x());
-}
-
 double LineSegment2d::DistanceTo(const geometry::Vec2d& point,
                                  geometry::Vec2d* const nearest_pt) const {
   if (length_ <= 1e-10) {
@@ -74,22 +38,6 @@ double LineSegment2d::DistanceTo(const geometry::Vec2d& point,
   return std::abs(x0 * unit_direction_.y() - y0 * unit_direction_.x());
 }
 
-double LineSegment2d::DistanceSquareTo(const geometry::Vec2d& point) const {
-  if (length_ <= 1e-10) {
-    return point.DistanceSquareTo(start_);
-  }
-  const double x0 = point.x() - start_.x();
-  const double y0 = point.y() - start_.y();
-  const double proj = x0 * unit_direction_.x() + y0 * unit_direction_.y();
-  if (proj <= 0.0) {
-    return math::Square(x0) + math::Square(y0);
-  }
-  if (proj >= length_) {
-    return point.DistanceSquareTo(end_);
-  }
-  return math::Square(x0 * unit_direction_.y() - y0 * unit_direction_.x());
-}
-
 double LineSegment2d::DistanceSquareTo(
     const geometry::Vec2d& point, geometry::Vec2d* const nearest_pt) const {
   if (length_ <= 1e-10) {
@@ -125,14 +73,6 @@ bool LineSegment2d::IsPointIn(const geometry::Vec2d& point) const {
          IsWithin(point.y(), start_.y(), end_.y());
 }
 
-double LineSegment2d::ProjectOntoUnit(const geometry::Vec2d& point) const {
-  return unit_direction_.InnerProd(point - start_);
-}
-
-double LineSegment2d::ProductOntoUnit(const geometry::Vec2d& point) const {
-  return unit_direction_.CrossProd(point - start_);
-}
-
 bool LineSegment2d::HasIntersect(const LineSegment2d& other_segment) const {
   geometry::Vec2d point;
   return GetIntersect(other_segment, &point);
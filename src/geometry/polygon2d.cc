@@ -1,9 +1,227 @@
 #include "opendrive-engine/geometry/polygon2d.h"
 
+#include <algorithm>
+#include <limits>
+#include <utility>
+
 namespace opendrive {
 namespace engine {
 namespace geometry {
 
+namespace {
+
+// Vertex of a convex polygon with the largest projection onto direction.
+const Vec2d& Support(const std::vector<Vec2d>& points,
+                     const Vec2d& direction) {
+  size_t best = 0;
+  double best_proj = points[0].InnerProd(direction);
+  for (size_t i = 1; i < points.size(); ++i) {
+    const double proj = points[i].InnerProd(direction);
+    if (proj > best_proj) {
+      best_proj = proj;
+      best = i;
+    }
+  }
+  return points[best];
+}
+
+// Closest point to the origin on segment ab. Returns the number of vertices
+// of the feature it lies on, moved to the front of simplex.
+int ClosestOnSegment(Vec2d* const simplex, Vec2d* const closest) {
+  const Vec2d a = simplex[0];
+  const Vec2d ab = simplex[1] - a;
+  const double t = -a.InnerProd(ab);
+  if (t <= 0.0) {
+    *closest = a;
+    return 1;
+  }
+  const double length_sqr = ab.LengthSquare();
+  if (t >= length_sqr) {
+    simplex[0] = simplex[1];
+    *closest = simplex[0];
+    return 1;
+  }
+  *closest = a + ab * (t / length_sqr);
+  return 2;
+}
+
+// Closest point to the origin on triangle abc, 3 when the origin is inside.
+int ClosestOnTriangle(Vec2d* const simplex, Vec2d* const closest) {
+  const Vec2d& a = simplex[0];
+  const Vec2d& b = simplex[1];
+  const Vec2d& c = simplex[2];
+  const double area = (b - a).CrossProd(c - a);
+  if (std::abs(area) > 1e-20) {
+    const double side_ab = (b - a).CrossProd(a * -1.0);
+    const double side_bc = (c - b).CrossProd(b * -1.0);
+    const double side_ca = (a - c).CrossProd(c * -1.0);
+    if (area > 0 ? (side_ab >= 0 && side_bc >= 0 && side_ca >= 0)
+                 : (side_ab <= 0 && side_bc <= 0 && side_ca <= 0)) {
+      *closest = Vec2d(0.0, 0.0);
+      return 3;
+    }
+  }
+  // outside or degenerate, keep the best of the three edges
+  const std::pair<int, int> edges[3] = {{0, 1}, {1, 2}, {2, 0}};
+  Vec2d best_simplex[2];
+  int best_size = 0;
+  double best_sqr = std::numeric_limits<double>::infinity();
+  for (const auto& edge : edges) {
+    Vec2d segment[2] = {simplex[edge.first], simplex[edge.second]};
+    Vec2d point;
+    const int size = ClosestOnSegment(segment, &point);
+    if (point.LengthSquare() < best_sqr) {
+      best_sqr = point.LengthSquare();
+      best_simplex[0] = segment[0];
+      best_simplex[1] = segment[1];
+      best_size = size;
+      *closest = point;
+    }
+  }
+  simplex[0] = best_simplex[0];
+  simplex[1] = best_simplex[1];
+  return best_size;
+}
+
+// Points per block of the batched kernels, small enough for the per-point
+// state to stay in l1 while every edge streams over it. The kernels always
+// run full blocks, a constant trip count without a scalar tail is what lets
+// the compiler vectorize them at -O2. Per-point state is kept in doubles so
+// that every lane has the width of the coordinates.
+constexpr size_t kBatchBlock = 256;
+
+// Points [begin, begin + kBatchBlock) of the batch, the last block is padded
+// by repeating its last point.
+void LoadBlock(const Vec2dBatch& points, const size_t begin,
+               double* const px, double* const py) {
+  const size_t size = std::min(kBatchBlock, points.size() - begin);
+  std::copy(points.x() + begin, points.x() + begin + size, px);
+  std::copy(points.y() + begin, points.y() + begin + size, py);
+  std::fill(px + size, px + kBatchBlock, px[size - 1]);
+  std::fill(py + size, py + kBatchBlock, py[size - 1]);
+}
+
+// Crossing count and boundary test of a block of points against the edge
+// (a, b), same tolerances as IsPointIn and LineSegment2d::IsPointIn.
+void CrossEdge(const Vec2d& a, const Vec2d& b, const double* __restrict px,
+               const double* __restrict py, double* __restrict crossings,
+               double* __restrict boundary) {
+  const double ax = a.x();
+  const double ay = a.y();
+  const double bx = b.x();
+  const double by = b.y();
+  const double sign = ay < by ? 1.0 : -1.0;
+  const double min_x = std::min(ax, bx) - 1e-10;
+  const double max_x = std::max(ax, bx) + 1e-10;
+  const double min_y = std::min(ay, by) - 1e-10;
+  const double max_y = std::max(ay, by) + 1e-10;
+  for (size_t k = 0; k < kBatchBlock; ++k) {
+    const double x = px[k];
+    const double y = py[k];
+    const double side = (ax - x) * (by - y) - (ay - y) * (bx - x);
+    const bool crosses = (ay > y) != (by > y);
+    crossings[k] += (crosses & (side * sign > 0.0)) ? 1.0 : 0.0;
+    const bool on_edge = (std::abs(side) <= 1e-10) & (x >= min_x) &
+                         (x <= max_x) & (y >= min_y) & (y <= max_y);
+    boundary[k] = on_edge ? 1.0 : boundary[k];
+  }
+}
+
+// Crossing count and squared distance of a block of points to the edge
+// (a, b).
+void DistanceEdge(const Vec2d& a, const Vec2d& b, const double* __restrict px,
+                  const double* __restrict py, double* __restrict crossings,
+                  double* __restrict distance_sqr) {
+  const double ax = a.x();
+  const double ay = a.y();
+  const double bx = b.x();
+  const double by = b.y();
+  const double dx = bx - ax;
+  const double dy = by - ay;
+  const double length_sqr = dx * dx + dy * dy;
+  const double inv_length_sqr = length_sqr > 0.0 ? 1.0 / length_sqr : 0.0;
+  const double sign = ay < by ? 1.0 : -1.0;
+  for (size_t k = 0; k < kBatchBlock; ++k) {
+    const double x = px[k];
+    const double y = py[k];
+    const double qx = x - ax;
+    const double qy = y - ay;
+    const double side = qy * (bx - x) - qx * (by - y);
+    const bool crosses = (ay > y) != (by > y);
+    crossings[k] += (crosses & (side * sign > 0.0)) ? 1.0 : 0.0;
+    // this operand order of the clamp is the one gcc turns into min/max
+    const double t =
+        std::max(0.0, std::min(1.0, (qx * dx + qy * dy) * inv_length_sqr));
+    const double ex = qx - t * dx;
+    const double ey = qy - t * dy;
+    const double sqr = ex * ex + ey * ey;
+    distance_sqr[k] = sqr < distance_sqr[k] ? sqr : distance_sqr[k];
+  }
+}
+
+bool IsOdd(const double count) { return static_cast<int64_t>(count) & 1; }
+
+// Every clip step adds at most one vertex for a convex input, so two convex
+// polygons with up to this many vertices in total clip on the stack.
+constexpr int kClipCapacity = 64;
+
+struct ClipBuffer {
+  double x[kClipCapacity];
+  double y[kClipCapacity];
+  int size;
+};
+
+// Sutherland-Hodgman clipping of the convex subject by every edge of the
+// counterclockwise convex clip polygon, with the same tolerances as
+// Polygon2d::ClipConvexHull. Returns the buffer holding the result, nullptr
+// if the overlap is degenerate or would not fit into the buffers.
+const ClipBuffer* ClipConvex(const std::vector<Vec2d>& clip,
+                             const std::vector<Vec2d>& subject,
+                             ClipBuffer* const buffers) {
+  ClipBuffer* in = &buffers[0];
+  ClipBuffer* out = &buffers[1];
+  if (subject.size() > static_cast<size_t>(kClipCapacity)) return nullptr;
+  in->size = static_cast<int>(subject.size());
+  for (int i = 0; i < in->size; ++i) {
+    in->x[i] = subject[i].x();
+    in->y[i] = subject[i].y();
+  }
+  double prod[kClipCapacity];
+  const size_t n = clip.size();
+  for (size_t e = 0; e < n; ++e) {
+    const Vec2d& start = clip[e];
+    const Vec2d& end = clip[e + 1 == n ? 0 : e + 1];
+    const double dx = end.x() - start.x();
+    const double dy = end.y() - start.y();
+    if (dx * dx + dy * dy <= 1e-20) continue;
+    for (int i = 0; i < in->size; ++i) {
+      prod[i] = dx * (in->y[i] - start.y()) - dy * (in->x[i] - start.x());
+    }
+    out->size = 0;
+    for (int i = 0; i < in->size; ++i) {
+      const int j = i + 1 == in->size ? 0 : i + 1;
+      const bool keep = prod[i] >= -1e-10;
+      const bool cross = (prod[i] > 1e-10 && prod[j] < -1e-10) ||
+                         (prod[i] < -1e-10 && prod[j] > 1e-10);
+      if (out->size + keep + cross > kClipCapacity) return nullptr;
+      if (keep) {
+        out->x[out->size] = in->x[i];
+        out->y[out->size++] = in->y[i];
+      }
+      if (cross) {
+        const double ratio = prod[j] / (prod[j] - prod[i]);
+        out->x[out->size] = in->x[i] * ratio + in->x[j] * (1.0 - ratio);
+        out->y[out->size++] = in->y[i] * ratio + in->y[j] * (1.0 - ratio);
+      }
+    }
+    if (out->size < 3) return nullptr;
+    std::swap(in, out);
+  }
+  return in;
+}
+
+}  // namespace
+
 Polygon2d::Polygon2d()
     : num_points_(0),
       is_convex_(false),
@@ -87,6 +305,9 @@ double Polygon2d::DistanceTo(const Box2d& box) const {
 }
 
 double Polygon2d::DistanceTo(const Polygon2d& polygon) const {
+  if (is_convex_ && polygon.is_convex()) {
+    return ConvexDistanceTo(polygon, std::numeric_limits<double>::infinity());
+  }
   if (IsPointIn(polygon.points()[0])) {
     return 0.0;
   }
@@ -132,14 +353,105 @@ bool Polygon2d::IsPointIn(const Vec2d& point) const {
   return c & 1;
 }
 
+void Polygon2d::IsPointIn(const Vec2dBatch& points,
+                          std::vector<uint8_t>* const inside) const {
+  const size_t n = points.size();
+  inside->resize(n);
+  double px[kBatchBlock];
+  double py[kBatchBlock];
+  double crossings[kBatchBlock];
+  double boundary[kBatchBlock];
+  for (size_t begin = 0; begin < n; begin += kBatchBlock) {
+    LoadBlock(points, begin, px, py);
+    std::fill(crossings, crossings + kBatchBlock, 0.0);
+    std::fill(boundary, boundary + kBatchBlock, 0.0);
+    int j = num_points_ - 1;
+    for (int i = 0; i < num_points_; ++i) {
+      CrossEdge(points_[i], points_[j], px, py, crossings, boundary);
+      j = i;
+    }
+    const size_t size = std::min(kBatchBlock, n - begin);
+    uint8_t* out = inside->data() + begin;
+    for (size_t k = 0; k < size; ++k) {
+      out[k] = boundary[k] > 0.0 || IsOdd(crossings[k]);
+    }
+  }
+}
+
+void Polygon2d::DistanceTo(const Vec2dBatch& points,
+                           std::vector<double>* const distances) const {
+  const size_t n = points.size();
+  distances->resize(n);
+  double px[kBatchBlock];
+  double py[kBatchBlock];
+  double crossings[kBatchBlock];
+  double distance_sqr[kBatchBlock];
+  for (size_t begin = 0; begin < n; begin += kBatchBlock) {
+    LoadBlock(points, begin, px, py);
+    std::fill(crossings, crossings + kBatchBlock, 0.0);
+    std::fill(distance_sqr, distance_sqr + kBatchBlock,
+              std::numeric_limits<double>::infinity());
+    int j = num_points_ - 1;
+    for (int i = 0; i < num_points_; ++i) {
+      DistanceEdge(points_[i], points_[j], px, py, crossings, distance_sqr);
+      j = i;
+    }
+    const size_t size = std::min(kBatchBlock, n - begin);
+    double* out = distances->data() + begin;
+    for (size_t k = 0; k < size; ++k) {
+      out[k] = IsOdd(crossings[k]) ? 0.0 : std::sqrt(distance_sqr[k]);
+    }
+  }
+}
+
 bool Polygon2d::HasOverlap(const Polygon2d& polygon) const {
   if (polygon.max_x() < min_x() || polygon.min_x() > max_x() ||
       polygon.max_y() < min_y() || polygon.min_y() > max_y()) {
     return false;
   }
+  if (is_convex_ && polygon.is_convex()) {
+    return ConvexDistanceTo(polygon, 1e-10) <= 1e-10;
+  }
   return DistanceTo(polygon) <= 1e-10;
 }
 
+double Polygon2d::ConvexDistanceTo(const Polygon2d& polygon,
+                                   const double stop_distance) const {
+  // GJK on the minkowski difference this - polygon, whose distance to the
+  // origin is the distance between the polygons.
+  const std::vector<Vec2d>& other_points = polygon.points();
+  Vec2d simplex[3];
+  simplex[0] = points_[0] - other_points[0];
+  int size = 1;
+  Vec2d closest = simplex[0];
+  const double stop_sqr = stop_distance * stop_distance;
+  // every step either adds a new difference vertex or terminates
+  const int max_iterations = num_points_ + polygon.num_points() + 3;
+  for (int i = 0; i < max_iterations; ++i) {
+    const double closest_sqr = closest.LengthSquare();
+    if (closest_sqr <= 1e-20) {
+      return 0.0;
+    }
+    const Vec2d w =
+        Support(points_, closest * -1.0) - Support(other_points, closest);
+    const double proj = closest.InnerProd(w);
+    // proj / |closest| is a lower bound of the distance
+    if (proj > 0.0 && proj * proj > stop_sqr * closest_sqr) {
+      return proj / std::sqrt(closest_sqr);
+    }
+    if (closest_sqr - proj <= 1e-10 * closest_sqr) {
+      return std::sqrt(closest_sqr);
+    }
+    simplex[size++] = w;
+    size = size == 2 ? ClosestOnSegment(simplex, &closest)
+                     : ClosestOnTriangle(simplex, &closest);
+    if (3 == size) {
+      return 0.0;
+    }
+  }
+  return closest.Length();
+}
+
 bool Polygon2d::Contains(const LineSegment2d& line_segment) const {
   if (line_segment.length() <= 1e-10) {
     return IsPointIn(line_segment.start());
@@ -315,6 +627,22 @@ bool Polygon2d::ClipConvexHull(const LineSegment2d& line_segment,
 
 bool Polygon2d::ComputeOverlap(const Polygon2d& other_polygon,
                                Polygon2d* const overlap_polygon) const {
+  if (other_polygon.max_x() < min_x_ || other_polygon.min_x() > max_x_ ||
+      other_polygon.max_y() < min_y_ || other_polygon.min_y() > max_y_) {
+    return false;
+  }
+  if (num_points_ + other_polygon.num_points() <= kClipCapacity) {
+    ClipBuffer buffers[2];
+    const ClipBuffer* clipped = ClipConvex(points_, other_polygon.points(),
+                                           buffers);
+    if (!clipped) return false;
+    std::vector<Vec2d> points;
+    points.reserve(clipped->size);
+    for (int i = 0; i < clipped->size; ++i) {
+      points.emplace_back(clipped->x[i], clipped->y[i]);
+    }
+    return ComputeConvexHull(points, overlap_polygon);
+  }
   std::vector<Vec2d> points = other_polygon.points();
   for (int i = 0; i < num_points_; ++i) {
     if (!ClipConvexHull(line_segments_[i], &points)) {
@@ -325,6 +653,25 @@ bool Polygon2d::ComputeOverlap(const Polygon2d& other_polygon,
 }
 
 double Polygon2d::ComputeIoU(const Polygon2d& other_polygon) const {
+  if (other_polygon.max_x() < min_x_ || other_polygon.min_x() > max_x_ ||
+      other_polygon.max_y() < min_y_ || other_polygon.min_y() > max_y_) {
+    return 0.0;
+  }
+  if (num_points_ + other_polygon.num_points() <= kClipCapacity) {
+    ClipBuffer buffers[2];
+    const ClipBuffer* clipped = ClipConvex(points_, other_polygon.points(),
+                                           buffers);
+    if (!clipped) return 0.0;
+    // shoelace straight on the clipped vertices, no hull is built
+    double intersection_area = 0.0;
+    for (int i = 0, j = clipped->size - 1; i < clipped->size; j = i++) {
+      intersection_area += clipped->x[j] * clipped->y[i] -
+                           clipped->x[i] * clipped->y[j];
+    }
+    intersection_area = std::max(0.0, 0.5 * intersection_area);
+    return intersection_area /
+           (area_ + other_polygon.area() - intersection_area);
+  }
   Polygon2d overlap_polygon;
   if (!ComputeOverlap(other_polygon, &overlap_polygon)) {
     return 0.0;
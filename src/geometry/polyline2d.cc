@@ -0,0 +1,194 @@
+#include "opendrive-engine/geometry/polyline2d.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace opendrive {
+namespace engine {
+namespace geometry {
+
+namespace {
+
+constexpr uint32_t kLeafSize = 8;
+
+}  // namespace
+
+Polyline2d::Polyline2d(const std::vector<Vec2d>& points) {
+  const size_t n = points.size();
+  x_.reserve(n);
+  y_.reserve(n);
+  s_.reserve(n);
+  for (const auto& point : points) {
+    x_.emplace_back(point.x());
+    y_.emplace_back(point.y());
+  }
+  if (n) s_.emplace_back(0.0);
+  if (n < 2) return;
+  unit_x_.reserve(n - 1);
+  unit_y_.reserve(n - 1);
+  length_.reserve(n - 1);
+  for (size_t i = 0; i + 1 < n; ++i) {
+    const double dx = x_[i + 1] - x_[i];
+    const double dy = y_[i + 1] - y_[i];
+    const double length = std::hypot(dx, dy);
+    const bool degenerate = length <= 1e-10;
+    unit_x_.emplace_back(degenerate ? 0.0 : dx / length);
+    unit_y_.emplace_back(degenerate ? 0.0 : dy / length);
+    length_.emplace_back(length);
+    s_.emplace_back(s_.back() + length);
+  }
+  nodes_.reserve(2 * (n - 1) / kLeafSize + 1);
+  Build(0, static_cast<uint32_t>(n - 1));
+}
+
+uint32_t Polyline2d::Build(uint32_t begin, uint32_t end) {
+  const uint32_t node_index = static_cast<uint32_t>(nodes_.size());
+  nodes_.emplace_back();
+  if (end - begin <= kLeafSize) {
+    // the segments [begin, end) span the points [begin, end]
+    Node node;
+    node.min_x = *std::min_element(&x_[begin], &x_[end] + 1);
+    node.max_x = *std::max_element(&x_[begin], &x_[end] + 1);
+    node.min_y = *std::min_element(&y_[begin], &y_[end] + 1);
+    node.max_y = *std::max_element(&y_[begin], &y_[end] + 1);
+    node.begin = begin;
+    node.end = end;
+    nodes_[node_index] = node;
+    return node_index;
+  }
+  // consecutive segments are spatially coherent, so halving the index range
+  // already gives tight boxes
+  const uint32_t mid = begin + (end - begin) / 2;
+  const uint32_t left = Build(begin, mid);
+  const uint32_t right = Build(mid, end);
+  Node node;
+  node.min_x = std::min(nodes_[left].min_x, nodes_[right].min_x);
+  node.max_x = std::max(nodes_[left].max_x, nodes_[right].max_x);
+  node.min_y = std::min(nodes_[left].min_y, nodes_[right].min_y);
+  node.max_y = std::max(nodes_[left].max_y, nodes_[right].max_y);
+  node.begin = right;
+  node.end = 0;
+  nodes_[node_index] = node;
+  return node_index;
+}
+
+void Polyline2d::NearestSegment(const Vec2d& point, int* const index,
+                                double* const distance_sqr) const {
+  *index = -1;
+  *distance_sqr = std::numeric_limits<double>::infinity();
+  if (nodes_.empty()) return;
+  const double px = point.x();
+  const double py = point.y();
+  auto box_distance_sqr = [px, py](const Node& node) {
+    const double dx = std::max(0.0, std::max(node.min_x - px, px - node.max_x));
+    const double dy = std::max(0.0, std::max(node.min_y - py, py - node.max_y));
+    return dx * dx + dy * dy;
+  };
+  uint32_t stack[64];
+  size_t stack_size = 0;
+  stack[stack_size++] = 0;
+  while (stack_size) {
+    const uint32_t node_index = stack[--stack_size];
+    const Node& node = nodes_[node_index];
+    if (box_distance_sqr(node) > *distance_sqr) continue;
+    if (node.end) {
+      for (uint32_t i = node.begin; i < node.end; ++i) {
+        const double x0 = px - x_[i];
+        const double y0 = py - y_[i];
+        const double t = std::max(
+            0.0, std::min(length_[i], x0 * unit_x_[i] + y0 * unit_y_[i]));
+        const double ex = x0 - t * unit_x_[i];
+        const double ey = y0 - t * unit_y_[i];
+        const double sqr = ex * ex + ey * ey;
+        // the first segment wins ties, as in a linear scan
+        if (sqr < *distance_sqr ||
+            (sqr == *distance_sqr && static_cast<int>(i) < *index)) {
+          *distance_sqr = sqr;
+          *index = static_cast<int>(i);
+        }
+      }
+      continue;
+    }
+    // visit the nearer child first, it tightens the bound for the other
+    const uint32_t left = node_index + 1;
+    const uint32_t right = node.begin;
+    if (box_distance_sqr(nodes_[left]) <= box_distance_sqr(nodes_[right])) {
+      stack[stack_size++] = right;
+      stack[stack_size++] = left;
+    } else {
+      stack[stack_size++] = left;
+      stack[stack_size++] = right;
+    }
+  }
+}
+
+int Polyline2d::GetProjection(const Vec2d& point, double* const accumulate_s,
+                              double* const lateral,
+                              double* const distance) const {
+  int index = -1;
+  double distance_sqr = 0.0;
+  NearestSegment(point, &index, &distance_sqr);
+  if (index < 0) return -1;
+  const double x0 = point.x() - x_[index];
+  const double y0 = point.y() - y_[index];
+  const double proj = x0 * unit_x_[index] + y0 * unit_y_[index];
+  *accumulate_s = s_[index] + std::max(0.0, std::min(length_[index], proj));
+  *lateral = unit_x_[index] * y0 - unit_y_[index] * x0;
+  if (distance) *distance = std::sqrt(distance_sqr);
+  return index;
+}
+
+double Polyline2d::DistanceTo(const Vec2d& point,
+                              Vec2d* const nearest_pt) const {
+  if (x_.empty()) return std::numeric_limits<double>::infinity();
+  if (1 == x_.size()) {
+    if (nearest_pt) *nearest_pt = Polyline2d::point(0);
+    return point.DistanceTo(Polyline2d::point(0));
+  }
+  int index = -1;
+  double distance_sqr = 0.0;
+  NearestSegment(point, &index, &distance_sqr);
+  if (index < 0) return std::numeric_limits<double>::infinity();
+  if (nearest_pt) {
+    const double x0 = point.x() - x_[index];
+    const double y0 = point.y() - y_[index];
+    const double proj = x0 * unit_x_[index] + y0 * unit_y_[index];
+    const double t = std::max(0.0, std::min(length_[index], proj));
+    *nearest_pt = Vec2d(x_[index] + t * unit_x_[index],
+                        y_[index] + t * unit_y_[index]);
+  }
+  return std::sqrt(distance_sqr);
+}
+
+int Polyline2d::GetSegmentIndex(double s) const {
+  if (length_.empty()) return -1;
+  const auto it = std::upper_bound(s_.begin(), s_.end(), s);
+  const int index = static_cast<int>(it - s_.begin()) - 1;
+  return std::max(0, std::min(static_cast<int>(length_.size()) - 1, index));
+}
+
+Vec2d Polyline2d::GetPoint(double s) const {
+  if (x_.empty()) return Vec2d();
+  const int index = GetSegmentIndex(s);
+  if (index < 0) return point(0);
+  const double t = std::max(0.0, std::min(length_[index], s - s_[index]));
+  return Vec2d(x_[index] + t * unit_x_[index], y_[index] + t * unit_y_[index]);
+}
+
+double Polyline2d::GetHeading(double s) const {
+  const int index = GetSegmentIndex(s);
+  if (index < 0) return 0.0;
+  return std::atan2(unit_y_[index], unit_x_[index]);
+}
+
+double Polyline2d::GetLateral(const Vec2d& point) const {
+  double accumulate_s = 0.0;
+  double lateral = 0.0;
+  GetProjection(point, &accumulate_s, &lateral);
+  return lateral;
+}
+
+}  // namespace geometry
+}  // namespace engine
+}  // namespace opendrive
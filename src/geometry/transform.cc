@@ -0,0 +1,96 @@
+#include "opendrive-engine/geometry/transform.h"
+
+#include <cmath>
+
+namespace opendrive {
+namespace engine {
+namespace geometry {
+
+Transform2d::Transform2d(double x, double y, double heading)
+    : cos_(std::cos(heading)), sin_(std::sin(heading)), x_(x), y_(y) {}
+
+Transform2d::Transform2d(const Point4D& pose)
+    : Transform2d(pose.x(), pose.y(), pose.heading()) {}
+
+Transform2d Transform2d::Inverse() const {
+  Transform2d inverse;
+  inverse.cos_ = cos_;
+  inverse.sin_ = -sin_;
+  inverse.x_ = -(cos_ * x_ + sin_ * y_);
+  inverse.y_ = sin_ * x_ - cos_ * y_;
+  return inverse;
+}
+
+Transform2d Transform2d::operator*(const Transform2d& other) const {
+  Transform2d composed;
+  composed.cos_ = cos_ * other.cos_ - sin_ * other.sin_;
+  composed.sin_ = sin_ * other.cos_ + cos_ * other.sin_;
+  composed.x_ = cos_ * other.x_ - sin_ * other.y_ + x_;
+  composed.y_ = sin_ * other.x_ + cos_ * other.y_ + y_;
+  return composed;
+}
+
+Transform3d::Transform3d() : r_{1, 0, 0, 0, 1, 0, 0, 0, 1}, t_(0, 0, 0) {}
+
+Transform3d::Transform3d(const Quaternion& rotation,
+                         const Point3D& translation)
+    : t_(translation) {
+  const double norm_sqr = rotation.w() * rotation.w() +
+                          rotation.x() * rotation.x() +
+                          rotation.y() * rotation.y() +
+                          rotation.z() * rotation.z();
+  if (norm_sqr <= 1e-20) {
+    *this = Transform3d();
+    t_ = translation;
+    return;
+  }
+  // scaling by 2 / |q|^2 normalizes the quaternion on the fly
+  const double s = 2.0 / norm_sqr;
+  const double w = rotation.w();
+  const double x = rotation.x();
+  const double y = rotation.y();
+  const double z = rotation.z();
+  r_[0] = 1.0 - s * (y * y + z * z);
+  r_[1] = s * (x * y - w * z);
+  r_[2] = s * (x * z + w * y);
+  r_[3] = s * (x * y + w * z);
+  r_[4] = 1.0 - s * (x * x + z * z);
+  r_[5] = s * (y * z - w * x);
+  r_[6] = s * (x * z - w * y);
+  r_[7] = s * (y * z + w * x);
+  r_[8] = 1.0 - s * (x * x + y * y);
+}
+
+Transform3d::Transform3d(const EulerAnglesZXY& rotation,
+                         const Point3D& translation)
+    : Transform3d(rotation.ToQuaternion(), translation) {}
+
+Transform3d Transform3d::Inverse() const {
+  // the inverse of a rotation matrix is its transpose
+  Transform3d inverse;
+  for (size_t row = 0; row < 3; ++row) {
+    for (size_t col = 0; col < 3; ++col) {
+      inverse.r_[row * 3 + col] = r_[col * 3 + row];
+    }
+  }
+  const Point3D t = inverse.Apply(t_);
+  inverse.t_ = Point3D(-t.x(), -t.y(), -t.z());
+  return inverse;
+}
+
+Transform3d Transform3d::operator*(const Transform3d& other) const {
+  Transform3d composed;
+  for (size_t row = 0; row < 3; ++row) {
+    for (size_t col = 0; col < 3; ++col) {
+      composed.r_[row * 3 + col] = r_[row * 3] * other.r_[col] +
+                                   r_[row * 3 + 1] * other.r_[3 + col] +
+                                   r_[row * 3 + 2] * other.r_[6 + col];
+    }
+  }
+  composed.t_ = Apply(other.t_);
+  return composed;
+}
+
+}  // namespace geometry
+}  // namespace engine
+}  // namespace opendrive
@@ -0,0 +1,274 @@
+#include "opendrive-engine/geometry/transverse_mercator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+
+namespace opendrive {
+namespace engine {
+namespace geometry {
+
+namespace {
+
+constexpr double kDegToRad = M_PI / 180.0;
+constexpr double kWgs84A = 6378137.0;
+constexpr double kWgs84F = 1.0 / 298.257223563;
+constexpr double kGrs80F = 1.0 / 298.257222101;
+
+bool ParseDouble(const std::string& text, double* const value) {
+  if (text.empty()) return false;
+  char* end = nullptr;
+  *value = std::strtod(text.c_str(), &end);
+  return end == text.c_str() + text.size() && std::isfinite(*value);
+}
+
+// sum of c[j] * sin(2 j zeta) for j = 1..order with zeta = xi + i eta,
+// evaluated by Clenshaw's recurrence from sin, cos (2 xi) and sinh, cosh
+// (2 eta) alone
+inline void ClenshawSin(const double* c, int order, double sin_xi,
+                        double cos_xi, double sinh_eta, double cosh_eta,
+                        double* const re, double* const im) {
+  // r = 2 cos(2 zeta)
+  const double r_re = 2.0 * cos_xi * cosh_eta;
+  const double r_im = -2.0 * sin_xi * sinh_eta;
+  double y1_re = 0.0;
+  double y1_im = 0.0;
+  double y2_re = 0.0;
+  double y2_im = 0.0;
+  for (int j = order; j > 0; --j) {
+    const double y0_re = r_re * y1_re - r_im * y1_im - y2_re + c[j];
+    const double y0_im = r_re * y1_im + r_im * y1_re - y2_im;
+    y2_re = y1_re;
+    y2_im = y1_im;
+    y1_re = y0_re;
+    y1_im = y0_im;
+  }
+  // sin(2 zeta) * y1
+  const double s_re = sin_xi * cosh_eta;
+  const double s_im = cos_xi * sinh_eta;
+  *re = s_re * y1_re - s_im * y1_im;
+  *im = s_re * y1_im + s_im * y1_re;
+}
+
+}  // namespace
+
+TransverseMercator::TransverseMercator() {
+  Init(0.0, 0.0, 1.0, 0.0, 0.0, kWgs84A, kWgs84F);
+}
+
+bool TransverseMercator::Init(const std::string& geo_reference) {
+  std::string proj = "tmerc";
+  double a = kWgs84A;
+  double f = kWgs84F;
+  double lat0 = 0.0;
+  double lon0 = 0.0;
+  double k0 = 1.0;
+  double false_easting = 0.0;
+  double false_northing = 0.0;
+  double zone = 0.0;
+  bool has_zone = false;
+  bool south = false;
+  std::istringstream tokens(geo_reference);
+  std::string token;
+  while (tokens >> token) {
+    if ('+' != token[0]) continue;
+    const size_t equal = token.find('=');
+    const std::string key = token.substr(1, equal - 1);
+    const std::string value =
+        std::string::npos == equal ? "" : token.substr(equal + 1);
+    bool ok = true;
+    if ("proj" == key) {
+      proj = value;
+    } else if ("ellps" == key || "datum" == key) {
+      if ("WGS84" == value) {
+        a = kWgs84A;
+        f = kWgs84F;
+      } else if ("GRS80" == value) {
+        a = kWgs84A;
+        f = kGrs80F;
+      } else {
+        ok = false;
+      }
+    } else if ("a" == key) {
+      ok = ParseDouble(value, &a) && a > 0;
+    } else if ("rf" == key) {
+      ok = ParseDouble(value, &f) && f > 1;
+      f = 1.0 / f;
+    } else if ("f" == key) {
+      ok = ParseDouble(value, &f) && f >= 0 && f < 1;
+    } else if ("lat_0" == key) {
+      ok = ParseDouble(value, &lat0);
+    } else if ("lon_0" == key) {
+      ok = ParseDouble(value, &lon0);
+    } else if ("k" == key || "k_0" == key) {
+      ok = ParseDouble(value, &k0) && k0 > 0;
+    } else if ("x_0" == key) {
+      ok = ParseDouble(value, &false_easting);
+    } else if ("y_0" == key) {
+      ok = ParseDouble(value, &false_northing);
+    } else if ("zone" == key) {
+      ok = ParseDouble(value, &zone) && zone >= 1 && zone <= 60;
+      has_zone = true;
+    } else if ("south" == key) {
+      south = true;
+    } else if ("units" == key) {
+      ok = "m" == value;
+    }
+    if (!ok) return false;
+  }
+  if ("utm" == proj) {
+    if (!has_zone) return false;
+    Init(0.0, 6.0 * std::floor(zone) - 183.0, 0.9996, 500000.0,
+         south ? 10000000.0 : 0.0, a, f);
+    return true;
+  }
+  if ("tmerc" != proj) return false;
+  Init(lat0, lon0, k0, false_easting, false_northing, a, f);
+  return true;
+}
+
+void TransverseMercator::Init(double lat0, double lon0, double k0,
+                              double false_easting, double false_northing,
+                              double a, double f) {
+  lat0_ = lat0;
+  lon0_ = lon0;
+  k0_ = k0;
+  false_easting_ = false_easting;
+  false_northing_ = false_northing;
+  e_ = std::sqrt(f * (2.0 - f));
+  e2m_ = 1.0 - e_ * e_;
+  // series in the third flattening, Karney 2011 eq. 14, 35 and 36
+  const double n = f / (2.0 - f);
+  const double n2 = n * n;
+  const double n3 = n2 * n;
+  const double n4 = n3 * n;
+  const double n5 = n4 * n;
+  const double n6 = n5 * n;
+  a1_ = k0 * a / (1.0 + n) * (1.0 + n2 / 4.0 + n4 / 64.0 + n6 / 256.0);
+  alpha_[0] = 0.0;
+  alpha_[1] = n / 2.0 - 2.0 * n2 / 3.0 + 5.0 * n3 / 16.0 +
+              41.0 * n4 / 180.0 - 127.0 * n5 / 288.0 +
+              7891.0 * n6 / 37800.0;
+  alpha_[2] = 13.0 * n2 / 48.0 - 3.0 * n3 / 5.0 + 557.0 * n4 / 1440.0 +
+              281.0 * n5 / 630.0 - 1983433.0 * n6 / 1935360.0;
+  alpha_[3] = 61.0 * n3 / 240.0 - 103.0 * n4 / 140.0 +
+              15061.0 * n5 / 26880.0 + 167603.0 * n6 / 181440.0;
+  alpha_[4] = 49561.0 * n4 / 161280.0 - 179.0 * n5 / 168.0 +
+              6601661.0 * n6 / 7257600.0;
+  alpha_[5] = 34729.0 * n5 / 80640.0 - 3418889.0 * n6 / 1995840.0;
+  alpha_[6] = 212378941.0 * n6 / 319334400.0;
+  beta_[0] = 0.0;
+  beta_[1] = n / 2.0 - 2.0 * n2 / 3.0 + 37.0 * n3 / 96.0 - n4 / 360.0 -
+             81.0 * n5 / 512.0 + 96199.0 * n6 / 604800.0;
+  beta_[2] = n2 / 48.0 + n3 / 15.0 - 437.0 * n4 / 1440.0 +
+             46.0 * n5 / 105.0 - 1118711.0 * n6 / 3870720.0;
+  beta_[3] = 17.0 * n3 / 480.0 - 37.0 * n4 / 840.0 - 209.0 * n5 / 4480.0 +
+             5569.0 * n6 / 90720.0;
+  beta_[4] = 4397.0 * n4 / 161280.0 - 11.0 * n5 / 504.0 -
+             830251.0 * n6 / 7257600.0;
+  beta_[5] = 4583.0 * n5 / 161280.0 - 108847.0 * n6 / 3991680.0;
+  beta_[6] = 20648693.0 * n6 / 638668800.0;
+  // on the central meridian eta vanishes and xi is the rectifying latitude
+  y0_ = 0.0;
+  double x = 0.0;
+  Forward(lat0, lon0, &x, &y0_);
+  y0_ -= false_northing_;
+}
+
+double TransverseMercator::ConformalTau(double tau) const {
+  // hypot is several times slower than sqrt, and tau stays far from
+  // overflowing when squared
+  const double tau1 = std::sqrt(1.0 + tau * tau);
+  const double sig = std::sinh(e_ * std::atanh(e_ * tau / tau1));
+  return std::sqrt(1.0 + sig * sig) * tau - sig * tau1;
+}
+
+void TransverseMercator::Forward(double lat, double lon, double* const x,
+                                 double* const y) const {
+  const double lam = std::remainder(lon - lon0_, 360.0) * kDegToRad;
+  const double phi = std::max(-90.0, std::min(90.0, lat)) * kDegToRad;
+  double xip = std::copysign(M_PI_2, phi);
+  double etap = 0.0;
+  // the double angle terms of the series follow algebraically from the
+  // ones of xi' and eta', which saves three transcendental calls
+  double sin_2xip = -0.0;
+  double cos_2xip = -1.0;
+  double sinh_2etap = 0.0;
+  double cosh_2etap = 1.0;
+  if (std::abs(phi) < M_PI_2) {
+    const double taup = ConformalTau(std::tan(phi));
+    const double sin_lam = std::sin(lam);
+    const double cos_lam = std::cos(lam);
+    const double h2 = taup * taup + cos_lam * cos_lam;
+    const double h = std::sqrt(h2);
+    xip = std::atan2(taup, cos_lam);
+    etap = std::asinh(sin_lam / h);
+    // sin(xi') = tau' / h, cos(xi') = cos(lam) / h, sinh(eta') = sin(lam) / h
+    // and cosh(eta') = sqrt(1 + tau'^2) / h
+    sin_2xip = 2.0 * taup * cos_lam / h2;
+    cos_2xip = (cos_lam * cos_lam - taup * taup) / h2;
+    sinh_2etap = 2.0 * sin_lam * std::sqrt(1.0 + taup * taup) / h2;
+    cosh_2etap = 1.0 + 2.0 * sin_lam * sin_lam / h2;
+  }
+  double re = 0.0;
+  double im = 0.0;
+  ClenshawSin(alpha_, kOrder, sin_2xip, cos_2xip, sinh_2etap, cosh_2etap, &re,
+              &im);
+  *x = a1_ * (etap + im) + false_easting_;
+  *y = a1_ * (xip + re) - y0_;
+}
+
+void TransverseMercator::Forward(const double* lat, const double* lon,
+                                 size_t size, double* const x,
+                                 double* const y) const {
+  for (size_t i = 0; i < size; ++i) {
+    Forward(lat[i], lon[i], x + i, y + i);
+  }
+}
+
+void TransverseMercator::Inverse(double x, double y, double* const lat,
+                                 double* const lon) const {
+  const double xi = (y + y0_) / a1_;
+  const double eta = (x - false_easting_) / a1_;
+  const double exp_eta = std::exp(2.0 * eta);
+  double re = 0.0;
+  double im = 0.0;
+  ClenshawSin(beta_, kOrder, std::sin(2.0 * xi), std::cos(2.0 * xi),
+              0.5 * (exp_eta - 1.0 / exp_eta), 0.5 * (exp_eta + 1.0 / exp_eta),
+              &re, &im);
+  const double xip = xi - re;
+  const double etap = eta - im;
+  const double sinh_etap = std::sinh(etap);
+  const double cos_xip = std::max(0.0, std::cos(xip));
+  const double r = std::sqrt(sinh_etap * sinh_etap + cos_xip * cos_xip);
+  *lon = lon0_ + std::atan2(sinh_etap, cos_xip) / kDegToRad;
+  if (r <= 0.0) {
+    *lat = std::copysign(90.0, xip);
+    return;
+  }
+  // invert the conformal latitude by newton's method, Karney 2011 eq. 19
+  const double taup = std::sin(xip) / r;
+  double tau = taup / e2m_;
+  for (int i = 0; i < 5; ++i) {
+    const double taupa = ConformalTau(tau);
+    const double dtau =
+        (taup - taupa) * (1.0 + e2m_ * tau * tau) /
+        (e2m_ * std::sqrt((1.0 + tau * tau) * (1.0 + taupa * taupa)));
+    tau += dtau;
+    if (std::abs(dtau) < 1e-14 * std::max(1.0, std::abs(tau))) break;
+  }
+  *lat = std::atan(tau) / kDegToRad;
+}
+
+void TransverseMercator::Inverse(const double* x, const double* y,
+                                 size_t size, double* const lat,
+                                 double* const lon) const {
+  for (size_t i = 0; i < size; ++i) {
+    Inverse(x[i], y[i], lat + i, lon + i);
+  }
+}
+
+}  // namespace geometry
+}  // namespace engine
+}  // namespace opendrive
@@ -0,0 +1,16 @@
+#include "opendrive-engine/geometry/vec2d_batch.h"
+
+namespace opendrive {
+namespace engine {
+namespace geometry {
+
+Vec2dBatch::Vec2dBatch(const std::vector<Vec2d>& points) {
+  reserve(points.size());
+  for (const auto& point : points) {
+    push_back(point);
+  }
+}
+
+}  // namespace geometry
+}  // namespace engine
+}  // namespace opendrive
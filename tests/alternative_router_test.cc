@@ -0,0 +1,233 @@
+#include "opendrive-engine/algo/route/alternative_router.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "grid_lanes.h"
+#include "opendrive-engine/algo/route/lane_graph.h"
+
+using opendrive::engine::geometry::Vec2d;
+using opendrive::engine::route::AlternativeRouteParam;
+using opendrive::engine::route::AlternativeRouter;
+using opendrive::engine::route::LaneEdgeType;
+using opendrive::engine::route::LaneGraph;
+using opendrive::engine::route::LaneGraphLanes;
+using opendrive::engine::route::LaneGraphParam;
+using opendrive::engine::route::Route;
+using opendrive::engine::route::Routes;
+using opendrive::engine::route::test::GridLanes;
+using opendrive::engine::route::test::kBlock;
+using opendrive::engine::route::test::MakeLane;
+
+namespace {
+
+constexpr int kGridSize = 8;
+
+// the cost of leaving a lane by an edge under some lane weights
+double Cost(const LaneGraph& graph, const std::vector<double>& weights,
+            uint32_t from, LaneEdgeType type) {
+  return LaneEdgeType::SUCCESSOR == type ? weights[from]
+                                         : graph.param().lane_change_cost;
+}
+
+// cheapest edge between two lanes, infinite if they are not connected
+double EdgeCost(const LaneGraph& graph, const std::vector<double>& weights,
+                uint32_t from, uint32_t to) {
+  double cost = std::numeric_limits<double>::infinity();
+  for (auto it = graph.out_begin(from); it != graph.out_end(from); ++it) {
+    if (it->lane == to) {
+      cost = std::min(cost, Cost(graph, weights, from, it->type));
+    }
+  }
+  return cost;
+}
+
+// plain Dijkstra over the same cost model; phase 1 are the lanes reached
+// from the start by lane changes alone, they are at the start position
+double ShortestCost(const LaneGraph& graph, const std::vector<double>& weights,
+                    uint32_t from, double from_s, uint32_t to, double to_s) {
+  const double from_offset = weights[from] * from_s / graph.lane(from).length;
+  const double to_offset = weights[to] * to_s / graph.lane(to).length;
+  const bool behind = to_s < from_s;
+  double best = std::numeric_limits<double>::infinity();
+  if (from == to && !behind) best = to_offset - from_offset;
+  std::vector<double> label(2 * graph.num_lanes(),
+                            std::numeric_limits<double>::infinity());
+  typedef std::pair<double, uint32_t> Entry;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+  auto relax = [&](uint32_t lane, bool phase, double cost) {
+    if (phase && lane == from) return;
+    const uint32_t node = 2 * lane + phase;
+    if (cost < label[node]) {
+      label[node] = cost;
+      queue.push({cost, node});
+    }
+  };
+  for (auto it = graph.out_begin(from); it != graph.out_end(from); ++it) {
+    relax(it->lane, LaneEdgeType::LANE_CHANGE == it->type,
+          Cost(graph, weights, from, it->type) - from_offset);
+  }
+  while (!queue.empty()) {
+    const Entry entry = queue.top();
+    queue.pop();
+    if (entry.first > label[entry.second]) continue;
+    const uint32_t lane = entry.second / 2;
+    const bool phase = entry.second % 2;
+    for (auto it = graph.out_begin(lane); it != graph.out_end(lane); ++it) {
+      relax(it->lane, phase && LaneEdgeType::LANE_CHANGE == it->type,
+            entry.first + Cost(graph, weights, lane, it->type));
+    }
+  }
+  best = std::min(best, label[2 * to] + to_offset);
+  if (!behind) best = std::min(best, label[2 * to + 1] + to_offset);
+  return best;
+}
+
+}  // namespace
+
+TEST(TestLaneGraph, TestConnections) {
+  // two sections in a row with two lanes each way
+  LaneGraphLanes lanes;
+  lanes.emplace_back(MakeLane("0_0", -1, Vec2d(0, 0), Vec2d(50, 0)));
+  lanes.emplace_back(MakeLane("0_0", -2, Vec2d(0, -3), Vec2d(50, -3)));
+  lanes.emplace_back(MakeLane("0_0", 1, Vec2d(50, 3), Vec2d(0, 3)));
+  lanes.emplace_back(MakeLane("0_1", -1, Vec2d(50.1, 0), Vec2d(90, 0)));
+  lanes.emplace_back(MakeLane("0_1", -2, Vec2d(50.1, -3), Vec2d(90, -3)));
+  lanes.emplace_back(MakeLane("0_1", 1, Vec2d(90, 3), Vec2d(50.1, 3)));
+  LaneGraph graph;
+  graph.Init(lanes);
+  ASSERT_EQ(6u, graph.num_lanes());
+  ASSERT_EQ(3, graph.FindLane("0_1_-1"));
+  ASSERT_EQ(-1, graph.FindLane("0_2_-1"));
+
+  auto edges_of = [&](uint32_t lane) {
+    std::vector<std::pair<uint32_t, LaneEdgeType>> edges;
+    for (auto it = graph.out_begin(lane); it != graph.out_end(lane); ++it) {
+      edges.emplace_back(it->lane, it->type);
+    }
+    return edges;
+  };
+  // straight on, and a lane change to the outer lane
+  const std::vector<std::pair<uint32_t, LaneEdgeType>> expected = {
+      {1, LaneEdgeType::LANE_CHANGE}, {3, LaneEdgeType::SUCCESSOR}};
+  ASSERT_EQ(expected, edges_of(0));
+  // the opposite direction only continues into its own lane
+  ASSERT_EQ((std::vector<std::pair<uint32_t, LaneEdgeType>>{
+                {2, LaneEdgeType::SUCCESSOR}}),
+            edges_of(5));
+  ASSERT_TRUE(edges_of(2).empty());
+  // the reverse rows hold the same edges
+  size_t in_edges = 0;
+  for (uint32_t i = 0; i < graph.num_lanes(); ++i) {
+    in_edges += graph.in_end(i) - graph.in_begin(i);
+  }
+  ASSERT_EQ(graph.num_edges(), in_edges);
+
+  // the graph weighs a lane by its length
+  ASSERT_EQ(6u, graph.weights().size());
+  ASSERT_EQ(graph.lane(3).length, graph.weight(3));
+}
+
+TEST(TestAlternativeRouter, TestRoutesOnGrid) {
+  LaneGraphParam graph_param;
+  graph_param.connect_heading = 2.0;  // turns, but no u-turns
+  auto graph = std::make_shared<LaneGraph>();
+  graph->Init(GridLanes(kGridSize), graph_param);
+  std::mt19937 rng(5);
+  std::uniform_real_distribution<double> factor(0.8, 1.5);
+  std::vector<double> weights(graph->num_lanes());
+  for (uint32_t i = 0; i < weights.size(); ++i) {
+    weights[i] = graph->lane(i).length * factor(rng);
+  }
+
+  AlternativeRouteParam param;
+  AlternativeRouter router;
+  router.Init(graph, param);
+  std::uniform_int_distribution<uint32_t> lane(
+      0, static_cast<uint32_t>(graph->num_lanes() - 1));
+  std::uniform_real_distribution<double> s(0, kBlock);
+  size_t alternatives = 0;
+  for (int query = 0; query < 100; ++query) {
+    const uint32_t from = lane(rng);
+    // every few queries stay on the start lane or its neighbour
+    const uint32_t to = 0 == query % 5   ? from
+                        : 1 == query % 5 ? from ^ 1
+                                         : lane(rng);
+    const double from_s = s(rng);
+    const double to_s = s(rng);
+    Routes routes;
+    ASSERT_TRUE(router.Search(from, from_s, to, to_s, 4, weights, &routes));
+    ASSERT_FALSE(routes.empty());
+    ASSERT_LE(routes.size(), 4u);
+    const double best =
+        ShortestCost(*graph, weights, from, from_s, to, to_s);
+    ASSERT_NEAR(best, routes[0].cost, 1e-6);
+    alternatives += routes.size() - 1;
+    for (size_t i = 0; i < routes.size(); ++i) {
+      const Route& route = routes[i];
+      ASSERT_EQ(from, route.lanes.front());
+      ASSERT_EQ(to, route.lanes.back());
+      if (i > 0) {
+        ASSERT_LE(routes[i - 1].cost, route.cost + 1e-9);
+        ASSERT_LE(route.cost, param.max_stretch * best + 1e-6);
+      }
+      // the reported cost is the cost of driving the lanes
+      double cost = weights[to] * to_s / graph->lane(to).length -
+                    weights[from] * from_s / graph->lane(from).length;
+      for (size_t k = 0; k + 1 < route.lanes.size(); ++k) {
+        cost +=
+            EdgeCost(*graph, weights, route.lanes[k], route.lanes[k + 1]);
+      }
+      ASSERT_NEAR(cost, route.cost, 1e-6);
+      for (size_t j = 0; j < i; ++j) {
+        ASSERT_NE(routes[j].lanes, route.lanes);
+      }
+    }
+  }
+  // a grid has plenty of detours
+  ASSERT_GT(alternatives, 100u);
+}
+
+TEST(TestAlternativeRouter, TestSameLane) {
+  LaneGraphParam graph_param;
+  graph_param.connect_heading = 2.0;
+  auto graph = std::make_shared<LaneGraph>();
+  graph->Init(GridLanes(kGridSize), graph_param);
+  AlternativeRouter router;
+  router.Init(graph);
+  Routes routes;
+  // ahead on the same lane
+  ASSERT_TRUE(router.Search(0, 10, 0, 60, 1, &routes));
+  ASSERT_EQ(1u, routes.size());
+  ASSERT_EQ(std::vector<uint32_t>{0}, routes[0].lanes);
+  ASSERT_NEAR(50, routes[0].cost, 1e-9);
+  ASSERT_NEAR(50, routes[0].length, 1e-9);
+  // behind needs a loop around a block, back onto the same lane
+  ASSERT_TRUE(router.Search(0, 60, 0, 10, 1, &routes));
+  ASSERT_EQ(0u, routes[0].lanes.front());
+  ASSERT_EQ(0u, routes[0].lanes.back());
+  ASSERT_NEAR(ShortestCost(*graph, graph->weights(), 0, 60, 0, 10),
+              routes[0].cost, 1e-6);
+  ASSERT_NEAR(routes[0].cost, routes[0].length, 1e-6);
+
+  // the neighbouring lane behind, changing lanes alone does not get there
+  ASSERT_TRUE(router.Search(0, 60, 1, 10, 1, &routes));
+  ASSERT_NEAR(ShortestCost(*graph, graph->weights(), 0, 60, 1, 10),
+              routes[0].cost, 1e-6);
+  ASSERT_GT(routes[0].lanes.size(), 2u);
+
+  ASSERT_FALSE(router.Search(0, 0, graph->num_lanes(), 0, 1, &routes));
+  ASSERT_FALSE(router.Search(0, 0, 1, 0, 0, &routes));
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
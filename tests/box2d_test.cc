@@ -0,0 +1,66 @@
+#include "opendrive-engine/geometry/box2d.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "opendrive-engine/geometry/box2d_batch.h"
+
+using opendrive::engine::geometry::Box2d;
+using opendrive::engine::geometry::Box2dBatch;
+
+namespace {
+
+std::vector<Box2d> RandomBoxes(std::mt19937& rng, int num, double range) {
+  std::uniform_real_distribution<double> position(-range, range);
+  std::uniform_real_distribution<double> heading(-M_PI, M_PI);
+  std::uniform_real_distribution<double> size(0.5, 5.0);
+  std::vector<Box2d> boxes;
+  for (int i = 0; i < num; ++i) {
+    boxes.emplace_back(Box2d({position(rng), position(rng)}, heading(rng),
+                             size(rng), size(rng)));
+  }
+  return boxes;
+}
+
+}  // namespace
+
+TEST(TestBox2d, BatchHasOverlap) {
+  std::mt19937 rng(5);
+  const auto boxes = RandomBoxes(rng, 1000, 30);
+  const Box2dBatch batch(boxes);
+  std::vector<uint8_t> overlaps;
+  for (const auto& box : RandomBoxes(rng, 50, 30)) {
+    batch.HasOverlap(box, &overlaps);
+    ASSERT_EQ(boxes.size(), overlaps.size());
+    for (size_t i = 0; i < boxes.size(); ++i) {
+      EXPECT_EQ(boxes[i].HasOverlap(box), static_cast<bool>(overlaps[i]));
+    }
+  }
+}
+
+TEST(TestBox2d, BatchFirstOverlap) {
+  std::mt19937 rng(9);
+  for (int round = 0; round < 50; ++round) {
+    const auto trajectory = RandomBoxes(rng, 150, 60);
+    const auto obstacles = RandomBoxes(rng, 20, 60);
+    int expected = -1;
+    for (size_t i = 0; i < trajectory.size() && expected < 0; ++i) {
+      for (const auto& obstacle : obstacles) {
+        if (trajectory[i].HasOverlap(obstacle)) {
+          expected = static_cast<int>(i);
+          break;
+        }
+      }
+    }
+    EXPECT_EQ(expected,
+              Box2dBatch(trajectory).FirstOverlap(Box2dBatch(obstacles)));
+  }
+  EXPECT_EQ(-1, Box2dBatch().FirstOverlap(Box2dBatch()));
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,214 @@
+#include "opendrive-engine/algo/route/customizable_router.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "grid_lanes.h"
+#include "opendrive-engine/algo/route/alternative_router.h"
+#include "opendrive-engine/algo/route/lane_graph.h"
+
+using opendrive::engine::route::AlternativeRouter;
+using opendrive::engine::route::CustomizableRouteParam;
+using opendrive::engine::route::CustomizableRouter;
+using opendrive::engine::route::LaneEdgeType;
+using opendrive::engine::route::LaneGraph;
+using opendrive::engine::route::LaneGraphParam;
+using opendrive::engine::route::Route;
+using opendrive::engine::route::Routes;
+using opendrive::engine::route::test::GridLanes;
+using opendrive::engine::route::test::kBlock;
+
+namespace {
+
+constexpr int kGridSize = 10;
+
+LaneGraph::Ptr GridGraph() {
+  LaneGraphParam param;
+  param.connect_heading = 2.0;  // turns, but no u-turns
+  auto graph = std::make_shared<LaneGraph>();
+  graph->Init(GridLanes(kGridSize), param);
+  return graph;
+}
+
+std::vector<double> RandomWeights(const LaneGraph& graph, std::mt19937* rng) {
+  std::uniform_real_distribution<double> factor(0.5, 3.0);
+  std::vector<double> weights(graph.num_lanes());
+  for (uint32_t i = 0; i < weights.size(); ++i) {
+    weights[i] = graph.lane(i).length * factor(*rng);
+  }
+  return weights;
+}
+
+// the cost of driving the lanes of a route under some weights
+double RouteCost(const LaneGraph& graph, const std::vector<double>& weights,
+                 const Route& route, double from_s, double to_s) {
+  const uint32_t from = route.lanes.front();
+  const uint32_t to = route.lanes.back();
+  double cost = weights[to] * to_s / graph.lane(to).length -
+                weights[from] * from_s / graph.lane(from).length;
+  for (size_t k = 0; k + 1 < route.lanes.size(); ++k) {
+    double edge = std::numeric_limits<double>::infinity();
+    const uint32_t lane = route.lanes[k];
+    for (auto it = graph.out_begin(lane); it != graph.out_end(lane); ++it) {
+      if (it->lane != route.lanes[k + 1]) continue;
+      edge = std::min(edge, LaneEdgeType::SUCCESSOR == it->type
+                                ? weights[lane]
+                                : graph.param().lane_change_cost);
+    }
+    cost += edge;
+  }
+  return cost;
+}
+
+// the reference, a plain Dijkstra of the alternative router
+double ReferenceCost(const AlternativeRouter& router,
+                     const std::vector<double>& weights, uint32_t from,
+                     double from_s, uint32_t to, double to_s) {
+  Routes routes;
+  if (!router.Search(from, from_s, to, to_s, 1, weights, &routes)) {
+    return std::numeric_limits<double>::infinity();
+  }
+  return routes[0].cost;
+}
+
+}  // namespace
+
+TEST(TestCustomizableRouter, TestRoutesOnGrid) {
+  auto graph = GridGraph();
+  std::mt19937 rng(7);
+  CustomizableRouter router;
+  router.Init(graph);
+  ASSERT_EQ(graph->weights(), router.metric()->weights);
+  ASSERT_EQ(graph->num_lanes(), router.metric()->weights.size());
+  ASSERT_GT(router.num_shortcuts(), graph->num_edges() / 2);
+  ASSERT_GT(router.num_levels(), 1u);
+  AlternativeRouter reference;
+  reference.Init(graph);
+
+  std::uniform_int_distribution<uint32_t> lane(
+      0, static_cast<uint32_t>(graph->num_lanes() - 1));
+  std::uniform_real_distribution<double> s(0, kBlock);
+  // the same queries under the initial and two customized metrics
+  for (int round = 0; round < 3; ++round) {
+    if (round > 0) {
+      ASSERT_TRUE(router.Customize(RandomWeights(*graph, &rng)));
+    }
+    const auto metric = router.metric();
+    for (int query = 0; query < 200; ++query) {
+      const uint32_t from = lane(rng);
+      const uint32_t to = 0 == query % 5   ? from
+                          : 1 == query % 5 ? from ^ 1
+                                           : lane(rng);
+      const double from_s = s(rng);
+      const double to_s = s(rng);
+      Route route;
+      ASSERT_TRUE(router.Search(from, from_s, to, to_s, &route));
+      ASSERT_NEAR(ReferenceCost(reference, metric->weights, from, from_s, to,
+                                to_s),
+                  route.cost, 1e-6);
+      ASSERT_EQ(from, route.lanes.front());
+      ASSERT_EQ(to, route.lanes.back());
+      ASSERT_NEAR(route.cost,
+                  RouteCost(*graph, metric->weights, route, from_s, to_s),
+                  1e-6);
+      ASSERT_GE(route.length, 0);
+    }
+  }
+}
+
+TEST(TestCustomizableRouter, TestPartialUpdate) {
+  auto graph = GridGraph();
+  CustomizableRouteParam param;
+  param.max_threads = 1;
+  CustomizableRouter router;
+  router.Init(graph, param);
+  Route route;
+  // ahead on the same lane
+  ASSERT_TRUE(router.Search(0, 10, 0, 60, &route));
+  ASSERT_EQ(std::vector<uint32_t>{0}, route.lanes);
+  ASSERT_NEAR(50, route.cost, 1e-9);
+  ASSERT_NEAR(50, route.length, 1e-9);
+
+  // closing the lanes of the shortest route moves it elsewhere, the grid
+  // has detours of the same length
+  ASSERT_TRUE(router.Search(0, 0, 200, 0, &route));
+  const double before = route.cost;
+  const auto old_metric = router.metric();
+  std::vector<std::pair<uint32_t, double>> changes;
+  for (size_t i = 1; i + 1 < route.lanes.size(); ++i) {
+    changes.emplace_back(route.lanes[i], 1e6);
+  }
+  ASSERT_FALSE(changes.empty());
+  ASSERT_TRUE(router.Customize(changes));
+  Route detour;
+  ASSERT_TRUE(router.Search(0, 0, 200, 0, &detour));
+  ASSERT_GE(detour.cost, before);
+  ASSERT_LT(detour.cost, 1e6);
+  for (const auto& change : changes) {
+    ASSERT_EQ(1e6, router.metric()->weights[change.first]);
+    ASSERT_EQ(detour.lanes.end(), std::find(detour.lanes.begin(),
+                                            detour.lanes.end(), change.first));
+  }
+  // the earlier metric is untouched
+  ASSERT_EQ(graph->weights(), old_metric->weights);
+
+  // invalid changes are rejected as a whole
+  const auto metric = router.metric();
+  typedef std::vector<std::pair<uint32_t, double>> Changes;
+  ASSERT_FALSE(router.Customize(Changes{{0, 1.0}, {1, -1.0}}));
+  ASSERT_FALSE(router.Customize(
+      Changes{{static_cast<uint32_t>(graph->num_lanes()), 1.0}}));
+  ASSERT_FALSE(router.Customize(std::vector<double>{1, 2, 3}));
+  ASSERT_EQ(metric, router.metric());
+  ASSERT_FALSE(router.Search(0, 0, graph->num_lanes(), 0, &route));
+}
+
+TEST(TestCustomizableRouter, TestQueriesDuringCustomization) {
+  auto graph = GridGraph();
+  CustomizableRouter router;
+  router.Init(graph);
+  AlternativeRouter reference;
+  reference.Init(graph);
+  std::mt19937 rng(11);
+  std::vector<std::vector<double>> metrics{graph->weights()};
+  for (int i = 0; i < 4; ++i) metrics.emplace_back(RandomWeights(*graph, &rng));
+
+  std::atomic<bool> done(false);
+  std::thread customizer([&]() {
+    for (int i = 1; i <= 20; ++i) router.Customize(metrics[i % 5]);
+    done = true;
+  });
+  // every answer belongs to one whole metric, never to a mix
+  std::uniform_int_distribution<uint32_t> lane(
+      0, static_cast<uint32_t>(graph->num_lanes() - 1));
+  size_t queries = 0;
+  while (!done || queries < 100) {
+    const uint32_t from = lane(rng);
+    const uint32_t to = lane(rng);
+    Route route;
+    ASSERT_TRUE(router.Search(from, 0, to, 0, &route));
+    bool matches = false;
+    for (const auto& weights : metrics) {
+      matches |= std::abs(RouteCost(*graph, weights, route, 0, 0) -
+                          route.cost) < 1e-6 &&
+                 std::abs(ReferenceCost(reference, weights, from, 0, to, 0) -
+                          route.cost) < 1e-6;
+    }
+    ASSERT_TRUE(matches);
+    ++queries;
+  }
+  customizer.join();
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,199 @@
+#include "opendrive-engine/algo/raster/distance_field.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using opendrive::engine::bvh::SegmentBVH;
+using opendrive::engine::bvh::SegmentIds;
+using opendrive::engine::bvh::Segments;
+using opendrive::engine::geometry::Vec2d;
+using opendrive::engine::raster::DistanceField;
+using opendrive::engine::raster::DistanceFieldParam;
+using opendrive::engine::raster::Polygon;
+using opendrive::engine::raster::Polygons;
+
+namespace {
+
+bool Inside(const Polygons& polygons, const Vec2d& point) {
+  for (const auto& polygon : polygons) {
+    bool inside = false;
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+      const Vec2d& a = polygon[j];
+      const Vec2d& b = polygon[i];
+      if ((a.y() > point.y()) != (b.y() > point.y()) &&
+          point.x() < a.x() + (point.y() - a.y()) * (b.x() - a.x()) /
+                                  (b.y() - a.y())) {
+        inside = !inside;
+      }
+    }
+    if (inside) return true;
+  }
+  return false;
+}
+
+class TestDistanceField : public testing::Test {
+ protected:
+  void SetUp() override {
+    // disjoint star shaped areas, their outlines are the edges
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> radius(4, 12);
+    for (int i = 0; i < 16; ++i) {
+      const Vec2d center(-90 + 60 * (i % 4), -90 + 60 * (i / 4));
+      Polygon polygon;
+      for (int v = 0; v < 7; ++v) {
+        const double angle = 2 * M_PI * v / 7;
+        const double r = radius(rng);
+        polygon.emplace_back(center.x() + r * std::cos(angle),
+                             center.y() + r * std::sin(angle));
+      }
+      areas_.emplace_back(polygon);
+    }
+    SegmentIds ids;
+    for (size_t i = 0; i < areas_.size(); ++i) {
+      const auto& polygon = areas_[i];
+      for (size_t v = 0; v < polygon.size(); ++v) {
+        segments_.emplace_back(polygon[v],
+                               polygon[(v + 1) % polygon.size()]);
+        ids.emplace_back(std::to_string(i));
+      }
+    }
+    auto edges = std::make_shared<SegmentBVH>();
+    edges->Init(segments_, ids);
+    edges_ = edges;
+  }
+
+  double BruteForce(const Vec2d& point, double max_distance) const {
+    double distance = max_distance;
+    for (const auto& segment : segments_) {
+      distance = std::min(distance, segment.DistanceTo(point));
+    }
+    return Inside(areas_, point) ? distance : -distance;
+  }
+
+  Polygons areas_;
+  Segments segments_;
+  SegmentBVH::ConstPtr edges_;
+};
+
+}  // namespace
+
+TEST_F(TestDistanceField, NodesMatchBruteForce) {
+  DistanceFieldParam param;
+  param.resolution = 0.25;
+  param.max_distance = 5.0;
+  DistanceField field;
+  field.Init(edges_, areas_, param);
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> node(-500, 500);
+  for (int i = 0; i < 2000; ++i) {
+    const Vec2d point((node(rng) + 0.5) * param.resolution,
+                      (node(rng) + 0.5) * param.resolution);
+    double distance = 0;
+    ASSERT_TRUE(field.Evaluate(point, &distance, nullptr));
+    ASSERT_NEAR(BruteForce(point, param.max_distance), distance, 1e-5);
+  }
+}
+
+TEST_F(TestDistanceField, InterpolatesBetweenNodes) {
+  DistanceFieldParam param;
+  param.resolution = 0.5;
+  DistanceField field;
+  field.Init(edges_, areas_, param);
+  std::mt19937 rng(13);
+  std::uniform_real_distribution<double> position(-110, 110);
+  std::vector<double> xs;
+  std::vector<double> ys;
+  for (int i = 0; i < 3000; ++i) {
+    xs.emplace_back(position(rng));
+    ys.emplace_back(position(rng));
+  }
+  std::vector<double> distances(xs.size());
+  std::vector<double> gradient_x(xs.size());
+  std::vector<double> gradient_y(xs.size());
+  ASSERT_TRUE(field.Evaluate(xs.data(), ys.data(), xs.size(),
+                             distances.data(), gradient_x.data(),
+                             gradient_y.data()));
+  const double res = param.resolution;
+  for (size_t i = 0; i < xs.size(); ++i) {
+    const Vec2d point(xs[i], ys[i]);
+    // the signed distance is 1-lipschitz, so is its bilinear interpolant
+    ASSERT_NEAR(BruteForce(point, param.max_distance), distances[i], res);
+    double single = 0;
+    Vec2d gradient;
+    ASSERT_TRUE(field.Evaluate(point, &single, &gradient));
+    ASSERT_EQ(distances[i], single);
+    ASSERT_EQ(gradient_x[i], gradient.x());
+    ASSERT_EQ(gradient_y[i], gradient.y());
+    EXPECT_LE(gradient.Length(), std::sqrt(2.0) + 1e-5);
+    // the gradient is exact for the interpolant inside a cell
+    const double u = xs[i] / res - 0.5;
+    const double v = ys[i] / res - 0.5;
+    const double h = 1e-4 * res;
+    if (u - std::floor(u) < 0.01 || u - std::floor(u) > 0.99 ||
+        v - std::floor(v) < 0.01 || v - std::floor(v) > 0.99) {
+      continue;
+    }
+    double dx0 = 0;
+    double dx1 = 0;
+    double dy0 = 0;
+    double dy1 = 0;
+    field.Evaluate({xs[i] - h, ys[i]}, &dx0, nullptr);
+    field.Evaluate({xs[i] + h, ys[i]}, &dx1, nullptr);
+    field.Evaluate({xs[i], ys[i] - h}, &dy0, nullptr);
+    field.Evaluate({xs[i], ys[i] + h}, &dy1, nullptr);
+    EXPECT_NEAR((dx1 - dx0) / (2 * h), gradient.x(), 1e-6);
+    EXPECT_NEAR((dy1 - dy0) / (2 * h), gradient.y(), 1e-6);
+  }
+}
+
+TEST_F(TestDistanceField, FarFromEdgesIsClamped) {
+  DistanceField field;
+  field.Init(edges_, areas_);
+  double distance = 0;
+  Vec2d gradient(1, 1);
+  ASSERT_TRUE(field.Evaluate({500, -700}, &distance, &gradient));
+  EXPECT_NEAR(-field.param().max_distance, distance, 1e-6);
+  EXPECT_NEAR(0, gradient.Length(), 1e-9);
+  // a point deep inside an area but still within reach points outwards
+  ASSERT_TRUE(field.Evaluate({-90.1, -90.1}, &distance, &gradient));
+  EXPECT_GT(distance, 2);
+}
+
+TEST_F(TestDistanceField, TilesAreCachedAndBounded) {
+  DistanceFieldParam param;
+  param.max_cached_tiles = 3;
+  DistanceField field;
+  field.Init(edges_, areas_, param);
+  const double side = DistanceField::kTileCells * param.resolution;
+  double distance = 0;
+  ASSERT_TRUE(field.Evaluate({1, 1}, &distance, nullptr));
+  ASSERT_TRUE(field.Evaluate({2, 3}, &distance, nullptr));
+  EXPECT_EQ(1, field.built_tiles());
+  for (int i = 1; i <= 5; ++i) {
+    ASSERT_TRUE(field.Evaluate({1 + i * side, 1}, &distance, nullptr));
+  }
+  EXPECT_EQ(6, field.built_tiles());
+  EXPECT_EQ(3, field.cached_tiles());
+  // the first tile was dropped and is built again
+  ASSERT_TRUE(field.Evaluate({1, 1}, &distance, nullptr));
+  EXPECT_EQ(7, field.built_tiles());
+}
+
+TEST_F(TestDistanceField, NoEdges) {
+  DistanceField field;
+  double distance = 0;
+  EXPECT_FALSE(field.Evaluate({0, 0}, &distance, nullptr));
+  field.Init(std::make_shared<SegmentBVH>(), areas_);
+  EXPECT_FALSE(field.Evaluate({0, 0}, &distance, nullptr));
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,192 @@
+#include "opendrive-engine/algo/raster/drivable_raster.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using opendrive::engine::geometry::AABox2d;
+using opendrive::engine::geometry::Vec2d;
+using opendrive::engine::raster::DrivableGrid;
+using opendrive::engine::raster::DrivableRaster;
+using opendrive::engine::raster::DrivableRasterParam;
+using opendrive::engine::raster::Polygon;
+using opendrive::engine::raster::Polygons;
+
+namespace {
+
+// even-odd test of a point against a polygon
+bool Inside(const Polygon& polygon, const Vec2d& point) {
+  bool inside = false;
+  for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+    const Vec2d& a = polygon[j];
+    const Vec2d& b = polygon[i];
+    if ((a.y() > point.y()) != (b.y() > point.y()) &&
+        point.x() <
+            a.x() + (point.y() - a.y()) * (b.x() - a.x()) / (b.y() - a.y())) {
+      inside = !inside;
+    }
+  }
+  return inside;
+}
+
+// star shaped polygons around random centers, some of them concave
+Polygons RandomPolygons(std::mt19937* rng, int count) {
+  std::uniform_real_distribution<double> position(-150, 150);
+  std::uniform_real_distribution<double> radius(2, 25);
+  Polygons polygons;
+  for (int i = 0; i < count; ++i) {
+    const Vec2d center(position(*rng), position(*rng));
+    const int vertices = 3 + i % 9;
+    Polygon polygon;
+    for (int v = 0; v < vertices; ++v) {
+      const double angle = 2 * M_PI * v / vertices;
+      const double r = radius(*rng);
+      polygon.emplace_back(center.x() + r * std::cos(angle),
+                           center.y() + r * std::sin(angle));
+    }
+    polygons.emplace_back(polygon);
+  }
+  return polygons;
+}
+
+void ExpectMatchesBruteForce(const Polygons& polygons,
+                             const DrivableGrid& grid) {
+  for (size_t row = 0; row < grid.height; ++row) {
+    for (size_t col = 0; col < grid.width; ++col) {
+      const Vec2d center(grid.min_x + (col + 0.5) * grid.resolution,
+                         grid.min_y + (row + 0.5) * grid.resolution);
+      bool expected = false;
+      for (const auto& polygon : polygons) {
+        expected = expected || Inside(polygon, center);
+      }
+      ASSERT_EQ(expected, 1 == grid.at(col, row))
+          << "cell " << col << ", " << row;
+    }
+  }
+}
+
+}  // namespace
+
+TEST(TestDrivableRaster, MatchesBruteForce) {
+  std::mt19937 rng(5);
+  const Polygons polygons = RandomPolygons(&rng, 60);
+  DrivableRaster raster;
+  raster.Init(polygons);
+  ASSERT_EQ(polygons.size(), raster.num_polygons());
+
+  std::uniform_real_distribution<double> position(-180, 120);
+  std::uniform_real_distribution<double> size(1, 60);
+  const double resolutions[] = {0.2, 0.5, 1.3};
+  DrivableGrid grid;
+  for (int i = 0; i < 30; ++i) {
+    const double x = position(rng);
+    const double y = position(rng);
+    const AABox2d window({x, y}, {x + size(rng), y + size(rng)});
+    const double resolution = resolutions[i % 3];
+    ASSERT_TRUE(raster.Rasterize(window, resolution, &grid));
+    EXPECT_LE(grid.min_x, window.min_x());
+    EXPECT_LE(grid.min_y, window.min_y());
+    EXPECT_GE(grid.min_x + grid.width * resolution, window.max_x() - 1e-9);
+    EXPECT_GE(grid.min_y + grid.height * resolution, window.max_y() - 1e-9);
+    ASSERT_EQ(grid.width * grid.height, grid.cells.size());
+    ExpectMatchesBruteForce(polygons, grid);
+  }
+}
+
+TEST(TestDrivableRaster, ContainsMatchesBruteForce) {
+  std::mt19937 rng(3);
+  const Polygons polygons = RandomPolygons(&rng, 60);
+  DrivableRaster raster;
+  raster.Init(polygons);
+  std::uniform_real_distribution<double> position(-180, 180);
+  size_t inside = 0;
+  for (int i = 0; i < 5000; ++i) {
+    const Vec2d point(position(rng), position(rng));
+    bool expected = false;
+    for (const auto& polygon : polygons) {
+      expected = expected || Inside(polygon, point);
+    }
+    ASSERT_EQ(expected, raster.Contains(point));
+    inside += expected;
+  }
+  ASSERT_GT(inside, 0u);
+  ASSERT_FALSE(raster.Contains(Vec2d(1e6, -1e6)));
+  ASSERT_FALSE(raster.Contains(Vec2d(NAN, 0)));
+}
+
+TEST(TestDrivableRaster, RollingWindowReusesTiles) {
+  std::mt19937 rng(9);
+  const Polygons polygons = RandomPolygons(&rng, 40);
+  DrivableRaster rolling;
+  rolling.Init(polygons);
+  const double resolution = 0.25;
+  const double side = DrivableRaster::kTileCells * resolution;
+
+  DrivableGrid grid;
+  DrivableGrid fresh_grid;
+  ASSERT_TRUE(rolling.Rasterize(AABox2d({-40, -40}, {-10, -10}), resolution,
+                                &grid));
+  const size_t first = rolling.rasterized_tiles();
+  EXPECT_EQ(first, rolling.cached_tiles());
+  for (int step = 1; step <= 20; ++step) {
+    const double x = -40 + step * 0.7;
+    const AABox2d window({x, -40}, {x + 30, -10});
+    ASSERT_TRUE(rolling.Rasterize(window, resolution, &grid));
+    DrivableRaster fresh;
+    fresh.Init(polygons);
+    ASSERT_TRUE(fresh.Rasterize(window, resolution, &fresh_grid));
+    EXPECT_EQ(fresh_grid.min_x, grid.min_x);
+    EXPECT_EQ(fresh_grid.width, grid.width);
+    EXPECT_EQ(fresh_grid.cells, grid.cells);
+  }
+  // the window moved 14 m right, only the newly touched tile columns were
+  // rasterized
+  const size_t columns = static_cast<size_t>(std::ceil(14.0 / side)) + 1;
+  const size_t rows = static_cast<size_t>(std::ceil(30.0 / side)) + 1;
+  EXPECT_LE(rolling.rasterized_tiles(), first + columns * rows);
+
+  // a cached window costs nothing
+  const size_t rasterized = rolling.rasterized_tiles();
+  ASSERT_TRUE(rolling.Rasterize(AABox2d({-30, -35}, {-20, -20}), resolution,
+                                &grid));
+  EXPECT_EQ(rasterized, rolling.rasterized_tiles());
+}
+
+TEST(TestDrivableRaster, CacheIsBounded) {
+  Polygons polygons = {{{0, 0}, {100, 0}, {100, 100}, {0, 100}}};
+  DrivableRasterParam param;
+  param.max_cached_tiles = 4;
+  param.max_threads = 2;
+  DrivableRaster raster;
+  raster.Init(polygons, param);
+  DrivableGrid grid;
+  ASSERT_TRUE(raster.Rasterize(AABox2d({10, 10}, {90, 90}), 0.1, &grid));
+  EXPECT_EQ(4, raster.cached_tiles());
+  for (uint8_t cell : grid.cells) ASSERT_EQ(1, cell);
+}
+
+TEST(TestDrivableRaster, RejectsInvalidRequests) {
+  Polygons polygons = {{{0, 0}, {10, 0}, {10, 10}}};
+  DrivableRasterParam param;
+  param.max_cells = 10000;
+  DrivableRaster raster;
+  raster.Init(polygons, param);
+  DrivableGrid grid;
+  const AABox2d window({0, 0}, {10, 10});
+  EXPECT_FALSE(raster.Rasterize(window, 0, &grid));
+  EXPECT_FALSE(raster.Rasterize(window, -1, &grid));
+  EXPECT_FALSE(raster.Rasterize(window, 0.01, &grid));
+  ASSERT_TRUE(raster.Rasterize(window, 0.1, &grid));
+  EXPECT_EQ(100, grid.width);
+  EXPECT_EQ(100, grid.height);
+  // below the diagonal only
+  EXPECT_EQ(1, grid.at(90, 10));
+  EXPECT_EQ(0, grid.at(10, 90));
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
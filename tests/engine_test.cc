@@ -4,6 +4,7 @@
 #include <tinyxml2.h>
 
 #include <cassert>
+#include <cmath>
 #include <cstdlib>
 #include <map>
 #include <memory>
@@ -33,6 +34,8 @@ class TestEmpty : public testing::Test {
     }
     return instance;
   }
+  // a driving lane outside junctions, long enough to query along
+  static opendrive::engine::core::Lane::ConstPtr GetTestLane();
   static std::string MAP_FILE;
 };
 
@@ -43,6 +46,21 @@ void TestEmpty::TearDownTestCase() {}
 void TestEmpty::TearDown() {}
 void TestEmpty::SetUp() {}
 
+opendrive::engine::core::Lane::ConstPtr TestEmpty::GetTestLane() {
+  auto engine = GetEngine();
+  for (const auto& item : engine->GetLanes()) {
+    auto section = engine->GetSectionById(item->parent_id());
+    auto road = engine->GetRoadById(section->parent_id());
+    if (opendrive::engine::core::Lane::Type::DRIVING == item->type() &&
+        item != section->center_lane() && road->junction_id().empty() &&
+        item->central_curve().pts().size() > 10 &&
+        item->central_curve().polyline().length() > 10) {
+      return item;
+    }
+  }
+  return nullptr;
+}
+
 TEST_F(TestEmpty, TestInit) {
   auto engine = TestEmpty::GetEngine();
   ASSERT_TRUE(engine->GetLanes().size() > 0);
@@ -94,6 +112,453 @@ TEST_F(TestEmpty, TestGetNearestPoint) {
   ASSERT_EQ("207_1_-1_17_2", search_ret.front().id);
 }
 
+TEST_F(TestEmpty, TestGetNearestLanesBatch) {
+  auto engine = TestEmpty::GetEngine();
+  ASSERT_TRUE(nullptr != engine);
+  std::vector<opendrive::engine::geometry::Point2D> points = {
+      {88.4121, -330.582}, {88.0, -330.0}, {150.0, -200.0}, {1e6, 1e6}};
+  auto lanes_list = engine->GetNearestLanes(points, 3);
+  ASSERT_EQ(points.size(), lanes_list.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    auto expected = engine->GetNearestLanes(points[i], 3);
+    ASSERT_EQ(expected.size(), lanes_list[i].size());
+    for (size_t j = 0; j < expected.size(); ++j) {
+      ASSERT_EQ(expected[j]->id(), lanes_list[i][j]->id());
+    }
+  }
+}
+
+TEST_F(TestEmpty, TestGetProjection) {
+  auto engine = TestEmpty::GetEngine();
+  ASSERT_TRUE(nullptr != engine);
+  auto lane = engine->GetLaneById("207_1_-1");
+  ASSERT_TRUE(nullptr != lane);
+  const auto& pts = lane->central_curve().pts();
+  ASSERT_GT(pts.size(), 18u);
+  // half way along segment 17, a little left of it
+  double s = 0;
+  for (size_t i = 0; i < 17; ++i) {
+    s += std::hypot(pts[i + 1].x() - pts[i].x(), pts[i + 1].y() - pts[i].y());
+  }
+  const double dx = pts[18].x() - pts[17].x();
+  const double dy = pts[18].y() - pts[17].y();
+  const double length = std::hypot(dx, dy);
+  ASSERT_GT(length, 0.1);
+  const double heading = std::atan2(dy, dx);
+  const double x = 0.5 * (pts[17].x() + pts[18].x()) - 0.2 * dy / length;
+  const double y = 0.5 * (pts[17].y() + pts[18].y()) + 0.2 * dx / length;
+
+  opendrive::engine::core::LaneProjection projection;
+  ASSERT_TRUE(engine->GetProjection(lane->id(), x, y, projection));
+  ASSERT_EQ(lane->id(), projection.lane_id);
+  ASSERT_NEAR(s + 0.5 * length, projection.s, 1e-6);
+  ASSERT_NEAR(0.2, projection.l, 1e-6);
+  ASSERT_NEAR(0.2, projection.dist, 1e-6);
+  ASSERT_NEAR(heading, projection.heading, 1e-9);
+  ASSERT_FALSE(engine->GetProjection("no_such_lane", x, y, projection));
+  ASSERT_FALSE(engine->GetProjection(lane->id(), std::nan(""), y, projection));
+}
+
+TEST_F(TestEmpty, TestGetNearestPointsApproximate) {
+  auto engine = TestEmpty::GetEngine();
+  ASSERT_TRUE(nullptr != engine);
+  opendrive::engine::kdtree::SearchParam param;
+  param.eps = 0.5;
+  auto exact = engine->GetNearestPoints(88.0, -330.0, 5);
+  auto approximate = engine->GetNearestPoints(88.0, -330.0, 5, param);
+  ASSERT_EQ(exact.size(), approximate.size());
+  for (size_t i = 0; i < exact.size(); ++i) {
+    ASSERT_LE(approximate[i].dist, 1.5 * exact[i].dist + 1e-9);
+  }
+  // far from the map nothing is within reach
+  param.max_distance = 10;
+  ASSERT_TRUE(engine->GetNearestPoints(1e6, 1e6, 5, param).empty());
+  ASSERT_TRUE(engine->GetNearestLanes(1e6, 1e6, 5, param).empty());
+  param.eps = 0;
+  param.max_distance = exact.back().dist + 1e-6;
+  auto limited = engine->GetNearestLanes(88.0, -330.0, 5, param);
+  ASSERT_EQ(engine->GetNearestLanes(88.0, -330.0, 5).size(), limited.size());
+}
+
+TEST_F(TestEmpty, TestGetNearestLanesInVehicleFrame) {
+  auto engine = TestEmpty::GetEngine();
+  ASSERT_TRUE(nullptr != engine);
+  const opendrive::engine::geometry::Point4D pose(88.4121, 17.3213, 0, 0.8);
+  std::vector<opendrive::engine::geometry::Point2D> vehicle_points = {
+      {0, 0}, {10, 0}, {5, -3.5}};
+  auto lanes_list = engine->GetNearestLanes(pose, vehicle_points, 1);
+  ASSERT_EQ(vehicle_points.size(), lanes_list.size());
+  for (size_t i = 0; i < vehicle_points.size(); ++i) {
+    const auto& point = vehicle_points[i];
+    const double x = pose.x() + point.x() * std::cos(pose.heading()) -
+                     point.y() * std::sin(pose.heading());
+    const double y = pose.y() + point.x() * std::sin(pose.heading()) +
+                     point.y() * std::cos(pose.heading());
+    auto expected = engine->GetNearestLanes(x, y, 1);
+    ASSERT_EQ(expected.size(), lanes_list[i].size());
+    for (size_t j = 0; j < expected.size(); ++j) {
+      ASSERT_EQ(expected[j]->id(), lanes_list[i][j]->id());
+    }
+  }
+}
+
+TEST_F(TestEmpty, TestGeodeticQueries) {
+  auto engine = TestEmpty::GetEngine();
+  ASSERT_TRUE(nullptr != engine);
+  // carla towns are referenced at +lat_0=49 +lon_0=8
+  ASSERT_FALSE(engine->GetHeader()->geo_reference().empty());
+  std::vector<opendrive::engine::geometry::Point2D> points = {
+      {88.4121, 17.3213}, {0, 0}, {-150.5, 320.25}};
+  std::vector<opendrive::engine::geometry::GeoPoint> geo_points;
+  ASSERT_TRUE(engine->MapToGeodetic(points, geo_points));
+  ASSERT_EQ(points.size(), geo_points.size());
+  std::vector<opendrive::engine::geometry::Point2D> back;
+  ASSERT_TRUE(engine->GeodeticToMap(geo_points, back));
+  for (size_t i = 0; i < points.size(); ++i) {
+    ASSERT_NEAR(points[i].x(), back[i].x(), 1e-6);
+    ASSERT_NEAR(points[i].y(), back[i].y(), 1e-6);
+  }
+  auto lanes_list = engine->GetNearestLanes(geo_points, 1);
+  auto expected_list = engine->GetNearestLanes(points, 1);
+  ASSERT_EQ(expected_list.size(), lanes_list.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    ASSERT_EQ(expected_list[i].size(), lanes_list[i].size());
+    for (size_t j = 0; j < expected_list[i].size(); ++j) {
+      ASSERT_EQ(expected_list[i][j]->id(), lanes_list[i][j]->id());
+    }
+  }
+}
+
+TEST_F(TestEmpty, TestCheckTrajectory) {
+  auto engine = TestEmpty::GetEngine();
+  ASSERT_TRUE(nullptr != engine);
+  auto lane = TestEmpty::GetTestLane();
+  ASSERT_TRUE(nullptr != lane);
+  // a small footprint following the lane center stays on the road
+  std::vector<opendrive::engine::geometry::Point4D> poses;
+  for (const auto& point : lane->central_curve().pts()) {
+    poses.emplace_back(point.x(), point.y(), 0, point.heading());
+  }
+  opendrive::engine::core::TrajectoryCollision collision;
+  ASSERT_TRUE(engine->CheckTrajectory(poses, 1.0, 0.5, collision));
+  ASSERT_EQ(-1, collision.index);
+  ASSERT_GT(collision.margin, 0);
+  ASSERT_LE(collision.margin, opendrive::engine::core::kMaxTrajectoryMargin);
+
+  // drifting sideways for 100 meters leaves the road
+  const auto& start = lane->central_curve().pts().front();
+  poses.clear();
+  for (int i = 0; i < 200; ++i) {
+    const double l = 0.5 * i;
+    poses.emplace_back(start.x() - l * std::sin(start.heading()),
+                       start.y() + l * std::cos(start.heading()), 0,
+                       start.heading());
+  }
+  ASSERT_TRUE(engine->CheckTrajectory(poses, 1.0, 0.5, collision));
+  ASSERT_GT(collision.index, 0);
+  ASSERT_EQ(0, collision.margin);
+  ASSERT_FALSE(collision.boundary_id.empty());
+
+  // starting off the road, far from any edge
+  poses = {{start.x() + 1e4, start.y() + 1e4, 0, start.heading()},
+           {start.x(), start.y(), 0, start.heading()}};
+  ASSERT_TRUE(engine->CheckTrajectory(poses, 1.0, 0.5, collision));
+  ASSERT_EQ(0, collision.index);
+  ASSERT_EQ(0, collision.margin);
+}
+
+TEST_F(TestEmpty, TestCheckTrajectoryTunneling) {
+  auto engine = TestEmpty::GetEngine();
+  ASSERT_TRUE(nullptr != engine);
+  auto lane = TestEmpty::GetTestLane();
+  ASSERT_TRUE(nullptr != lane);
+  const auto& pts = lane->central_curve().pts();
+  const auto& from = pts[pts.size() / 2];
+  const opendrive::engine::geometry::Point4D first(from.x(), from.y(), 0,
+                                                   from.heading());
+  opendrive::engine::core::TrajectoryCollision collision;
+  ASSERT_TRUE(engine->CheckTrajectory({first}, 1.0, 0.5, collision));
+  ASSERT_EQ(-1, collision.index);
+  // a pose on another lane with off road ground halfway there, each pose
+  // alone is on the road but the jump between them is not
+  opendrive::engine::raster::DrivableGrid grid;
+  bool found = false;
+  for (const auto& item : engine->GetLanes()) {
+    if (opendrive::engine::core::Lane::Type::DRIVING != item->type()) {
+      continue;
+    }
+    const auto& item_pts = item->central_curve().pts();
+    if (item_pts.empty()) continue;
+    const auto& to = item_pts[item_pts.size() / 2];
+    const double mid_x = 0.5 * (from.x() + to.x());
+    const double mid_y = 0.5 * (from.y() + to.y());
+    ASSERT_TRUE(engine->RasterizeDrivable(
+        opendrive::engine::geometry::AABox2d({mid_x - 0.05, mid_y - 0.05},
+                                             {mid_x + 0.05, mid_y + 0.05}),
+        0.1, grid));
+    bool off_road = true;
+    for (uint8_t cell : grid.cells) off_road = off_road && 0 == cell;
+    if (!off_road) continue;
+    const opendrive::engine::geometry::Point4D second(to.x(), to.y(), 0,
+                                                      to.heading());
+    ASSERT_TRUE(engine->CheckTrajectory({second}, 1.0, 0.5, collision));
+    if (-1 != collision.index) continue;
+    ASSERT_TRUE(engine->CheckTrajectory({first, second}, 1.0, 0.5, collision));
+    ASSERT_EQ(1, collision.index);
+    ASSERT_EQ(0, collision.margin);
+    found = true;
+    break;
+  }
+  ASSERT_TRUE(found);
+}
+
+TEST_F(TestEmpty, TestRaycast) {
+  auto engine = TestEmpty::GetEngine();
+  ASSERT_TRUE(nullptr != engine);
+  auto lane = TestEmpty::GetTestLane();
+  ASSERT_TRUE(nullptr != lane);
+  // sideways from the lane center the first boundary is one of the lane's
+  const auto& pts = lane->central_curve().pts();
+  const auto& center = pts[pts.size() / 2];
+  const opendrive::engine::geometry::Point2D origin(center.x(), center.y());
+  std::vector<double> headings = {center.heading() + M_PI / 2,
+                                  center.heading() - M_PI / 2};
+  opendrive::engine::core::RaycastHits hits;
+  ASSERT_TRUE(engine->Raycast(origin, headings, 50, hits));
+  ASSERT_EQ(2, hits.size());
+  for (const auto& hit : hits) {
+    ASSERT_TRUE(hit.hit);
+    ASSERT_EQ(lane->id(), hit.lane_id);
+    ASSERT_LT(hit.distance, 10);
+  }
+  ASSERT_NE(hits[0].side, hits[1].side);
+
+  opendrive::engine::core::RaycastHit hit;
+  ASSERT_FALSE(engine->Raycast(origin, {0, 0}, 50, hit));
+  ASSERT_TRUE(engine->Raycast(origin, {std::cos(headings[0]),
+                                       std::sin(headings[0])},
+                              50, hit));
+  ASSERT_NEAR(hits[0].distance, hit.distance, 1e-9);
+}
+
+TEST_F(TestEmpty, TestRasterizeDrivable) {
+  auto engine = TestEmpty::GetEngine();
+  ASSERT_TRUE(nullptr != engine);
+  auto lane = TestEmpty::GetTestLane();
+  ASSERT_TRUE(nullptr != lane);
+  const auto& pts = lane->central_curve().pts();
+  const auto& center = pts[pts.size() / 2];
+  const opendrive::engine::geometry::AABox2d window(
+      {center.x() - 10, center.y() - 10}, {center.x() + 10, center.y() + 10});
+  opendrive::engine::raster::DrivableGrid grid;
+  ASSERT_FALSE(engine->RasterizeDrivable(window, 0, grid));
+  ASSERT_TRUE(engine->RasterizeDrivable(window, 0.2, grid));
+  ASSERT_EQ(grid.width * grid.height, grid.cells.size());
+  const size_t col =
+      static_cast<size_t>((center.x() - grid.min_x) / grid.resolution);
+  const size_t row =
+      static_cast<size_t>((center.y() - grid.min_y) / grid.resolution);
+  ASSERT_EQ(1, grid.at(col, row));
+}
+
+TEST_F(TestEmpty, TestGetEdgeDistance) {
+  auto engine = TestEmpty::GetEngine();
+  ASSERT_TRUE(nullptr != engine);
+  auto lane = TestEmpty::GetTestLane();
+  ASSERT_TRUE(nullptr != lane);
+  const auto& pts = lane->central_curve().pts();
+  const auto& center = pts[pts.size() / 2];
+  std::vector<opendrive::engine::geometry::Point2D> points = {
+      {center.x(), center.y()}, {center.x() + 1e4, center.y() + 1e4}};
+  opendrive::engine::core::EdgeDistances distances;
+  ASSERT_TRUE(engine->GetEdgeDistance(points, distances));
+  ASSERT_EQ(2, distances.size());
+  ASSERT_GT(distances[0].distance, 0);
+  ASSERT_LT(distances[1].distance, 0);
+  ASSERT_NEAR(0, distances[1].gradient_x, 1e-9);
+}
+
+TEST_F(TestEmpty, TestGetNearestBoundary) {
+  auto engine = TestEmpty::GetEngine();
+  ASSERT_TRUE(nullptr != engine);
+  auto lane = TestEmpty::GetTestLane();
+  ASSERT_TRUE(nullptr != lane);
+  std::vector<opendrive::engine::geometry::Point2D> points;
+  for (const auto& pt : lane->central_curve().pts()) {
+    points.emplace_back(pt.x(), pt.y());
+  }
+  opendrive::engine::core::NearestBoundaries boundaries;
+  ASSERT_TRUE(engine->GetNearestBoundary(points, boundaries));
+  ASSERT_EQ(points.size(), boundaries.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    opendrive::engine::core::NearestBoundary boundary;
+    ASSERT_TRUE(
+        engine->GetNearestBoundary(points[i].x(), points[i].y(), boundary));
+    ASSERT_TRUE(boundary.found);
+    ASSERT_TRUE(boundaries[i].found);
+    ASSERT_NEAR(boundary.distance, boundaries[i].distance, 1e-9);
+    ASSERT_NEAR(boundary.distance,
+                std::hypot(points[i].x() - boundary.x,
+                           points[i].y() - boundary.y),
+                1e-6);
+    // the lane's own boundaries are at most half a lane width away
+    ASSERT_LT(boundary.distance, 10);
+  }
+  // driving lanes of the map are separated by painted road marks
+  size_t marked = 0;
+  for (const auto& item : engine->GetLanes()) {
+    const auto& pts = item->left_boundary().curve().pts();
+    if (opendrive::engine::core::Lane::Type::DRIVING != item->type() ||
+        pts.empty()) {
+      continue;
+    }
+    const auto& pt = pts[pts.size() / 2];
+    opendrive::engine::core::NearestBoundary boundary;
+    ASSERT_TRUE(engine->GetNearestBoundary(pt.x(), pt.y(), boundary));
+    ASSERT_TRUE(boundary.found);
+    if (opendrive::RoadMarkType::NONE != boundary.type) ++marked;
+  }
+  ASSERT_GT(marked, 0);
+}
+
+TEST_F(TestEmpty, TestGetNearestBoundaryLeftLane) {
+  auto engine = TestEmpty::GetEngine();
+  ASSERT_TRUE(nullptr != engine);
+  // a lane a little inside from its boundary, on the middle sample
+  auto inside = [](const opendrive::engine::core::Lane::ConstPtr& lane,
+                   bool inner, double* const x, double* const y) {
+    const auto& from = inner ? lane->left_boundary().curve().pts()
+                             : lane->right_boundary().curve().pts();
+    const auto& to = inner ? lane->right_boundary().curve().pts()
+                           : lane->left_boundary().curve().pts();
+    if (from.size() < 3 || from.size() != to.size()) return false;
+    const size_t mid = from.size() / 2;
+    const double dx = to[mid].x() - from[mid].x();
+    const double dy = to[mid].y() - from[mid].y();
+    const double width = std::hypot(dx, dy);
+    if (width < 1.0) return false;
+    *x = from[mid].x() + 0.3 * dx / width;
+    *y = from[mid].y() + 0.3 * dy / width;
+    return true;
+  };
+  // left of the reference line the innermost lane's inner boundary is the
+  // reference line, the outermost lane's outer one is the road edge
+  size_t checked = 0;
+  for (const auto& section : engine->GetSections()) {
+    auto road = engine->GetRoadById(section->parent_id());
+    if (!road->junction_id().empty() || section->left_lanes().empty()) {
+      continue;
+    }
+    double x = 0;
+    double y = 0;
+    opendrive::engine::core::NearestBoundary boundary;
+    const auto innermost = section->left_lanes().front();
+    if (inside(innermost, true, &x, &y)) {
+      ASSERT_TRUE(engine->GetNearestBoundary(x, y, boundary));
+      ASSERT_TRUE(boundary.found);
+      ASSERT_NEAR(0.3, boundary.distance, 0.1);
+      // shared with the innermost right lane, inner to both
+      ASSERT_EQ(opendrive::engine::core::BoundarySide::INNER, boundary.side);
+      ++checked;
+    }
+    const auto outermost = section->left_lanes().back();
+    if (inside(outermost, false, &x, &y)) {
+      ASSERT_TRUE(engine->GetNearestBoundary(x, y, boundary));
+      ASSERT_TRUE(boundary.found);
+      ASSERT_EQ(outermost->id(), boundary.lane_id);
+      ASSERT_EQ(opendrive::engine::core::BoundarySide::OUTER, boundary.side);
+      ASSERT_TRUE(boundary.road_edge);
+      ++checked;
+    }
+  }
+  ASSERT_GT(checked, 0u);
+}
+
+TEST_F(TestEmpty, TestGetNearestRoadsAndSections) {
+  auto engine = TestEmpty::GetEngine();
+  ASSERT_TRUE(nullptr != engine);
+  auto lane = TestEmpty::GetTestLane();
+  ASSERT_TRUE(nullptr != lane);
+  const auto section = engine->GetSectionById(lane->parent_id());
+  const auto& pts = lane->central_curve().pts();
+  const auto& center = pts[pts.size() / 2];
+  const auto projections =
+      engine->GetNearestProjections(center.x(), center.y(), 3);
+  ASSERT_FALSE(projections.empty());
+  ASSERT_EQ(lane->id(), projections[0].lane_id);
+  ASSERT_NEAR(0, projections[0].dist, 1e-6);
+  for (size_t i = 1; i < projections.size(); ++i) {
+    ASSERT_LE(projections[i - 1].dist, projections[i].dist);
+  }
+  const auto sections = engine->GetNearestSections(center.x(), center.y(), 2);
+  ASSERT_FALSE(sections.empty());
+  ASSERT_EQ(section->id(), sections[0]->id());
+  const auto roads = engine->GetNearestRoads(center.x(), center.y(), 2);
+  ASSERT_FALSE(roads.empty());
+  ASSERT_EQ(section->parent_id(), roads[0]->id());
+}
+
+TEST_F(TestEmpty, TestGetRoutes) {
+  auto engine = TestEmpty::GetEngine();
+  ASSERT_TRUE(nullptr != engine);
+  auto lane = TestEmpty::GetTestLane();
+  ASSERT_TRUE(nullptr != lane);
+  const double length = lane->central_curve().polyline().length();
+  // one of the two is ahead in the driving direction, reached in place
+  opendrive::engine::core::RoutingPaths forward;
+  opendrive::engine::core::RoutingPaths backward;
+  engine->GetRoutes(lane->id(), 0.25 * length, lane->id(), 0.75 * length, 3,
+                    forward);
+  engine->GetRoutes(lane->id(), 0.75 * length, lane->id(), 0.25 * length, 3,
+                    backward);
+  const auto& paths = !forward.empty() && 1 == forward[0].path.size()
+                          ? forward
+                          : backward;
+  ASSERT_FALSE(paths.empty());
+  ASSERT_EQ(opendrive::engine::core::Path{lane->id()}, paths[0].path);
+  ASSERT_NEAR(0.5 * length, paths[0].length, 1e-6);
+  ASSERT_NEAR(0.5 * length, paths[0].cost, 1e-6);
+  for (size_t i = 1; i < paths.size(); ++i) {
+    ASSERT_LE(paths[i - 1].cost, paths[i].cost);
+  }
+
+  opendrive::engine::core::RoutingPaths none;
+  ASSERT_FALSE(engine->GetRoutes("no_such_lane", 0, lane->id(), 0, 1, none));
+  ASSERT_TRUE(none.empty());
+}
+
+TEST_F(TestEmpty, TestSetLaneWeights) {
+  auto engine = TestEmpty::GetEngine();
+  ASSERT_TRUE(nullptr != engine);
+  auto lane = TestEmpty::GetTestLane();
+  ASSERT_TRUE(nullptr != lane);
+  const double length = lane->central_curve().polyline().length();
+  opendrive::engine::core::RoutingPath forward;
+  opendrive::engine::core::RoutingPath backward;
+  engine->GetRoute(lane->id(), 0.25 * length, lane->id(), 0.75 * length,
+                   forward);
+  engine->GetRoute(lane->id(), 0.75 * length, lane->id(), 0.25 * length,
+                   backward);
+  const bool ahead = 1 == forward.path.size();
+  const auto& path = ahead ? forward : backward;
+  ASSERT_EQ(opendrive::engine::core::Path{lane->id()}, path.path);
+  ASSERT_NEAR(0.5 * length, path.cost, 1e-6);
+
+  // twice the weight, twice the cost of the same route
+  ASSERT_TRUE(engine->SetLaneWeights({{lane->id(), 2 * length}}));
+  opendrive::engine::core::RoutingPath weighted;
+  ASSERT_TRUE(engine->GetRoute(lane->id(), (ahead ? 0.25 : 0.75) * length,
+                               lane->id(), (ahead ? 0.75 : 0.25) * length,
+                               weighted));
+  ASSERT_NEAR(length, weighted.cost, 1e-6);
+  ASSERT_NEAR(0.5 * length, weighted.length, 1e-6);
+  ASSERT_TRUE(engine->SetLaneWeights({{lane->id(), length}}));
+
+  ASSERT_FALSE(engine->SetLaneWeights({{"no_such_lane", 1.0}}));
+  ASSERT_FALSE(engine->SetLaneWeights({{lane->id(), -1.0}}));
+  ASSERT_FALSE(engine->GetRoute("no_such_lane", 0, lane->id(), 0, weighted));
+}
+
 int main(int argc, char* argv[]) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,61 @@
+#ifndef OPENDRIVE_ENGINE_TESTS_GRID_LANES_H_
+#define OPENDRIVE_ENGINE_TESTS_GRID_LANES_H_
+
+#include <cmath>
+#include <string>
+
+#include "opendrive-engine/algo/route/lane_graph.h"
+
+namespace opendrive {
+namespace engine {
+namespace route {
+namespace test {
+
+constexpr double kBlock = 100.0;  // distance between neighbouring crossings
+
+inline LaneGraphLane MakeLane(const std::string& section, int index,
+                              const geometry::Vec2d& a,
+                              const geometry::Vec2d& b) {
+  LaneGraphLane lane;
+  lane.id = section + "_" + std::to_string(index);
+  lane.section_id = section;
+  lane.index = index;
+  lane.length = a.DistanceTo(b);
+  lane.entry = a;
+  lane.exit = b;
+  lane.entry_heading = lane.exit_heading = std::atan2(b.y() - a.y(),
+                                                      b.x() - a.x());
+  return lane;
+}
+
+// a grid of size x size crossings with streets of two lanes each way
+// between neighbouring ones
+inline LaneGraphLanes GridLanes(int size) {
+  LaneGraphLanes lanes;
+  int section = 0;
+  for (int i = 0; i < size; ++i) {
+    for (int j = 0; j < size; ++j) {
+      const geometry::Vec2d node(i * kBlock, j * kBlock);
+      const geometry::Vec2d neighbours[] = {
+          geometry::Vec2d((i + 1) * kBlock, j * kBlock),
+          geometry::Vec2d(i * kBlock, (j + 1) * kBlock)};
+      const bool valid[] = {i + 1 < size, j + 1 < size};
+      for (int k = 0; k < 2; ++k) {
+        if (!valid[k]) continue;
+        const std::string id = std::to_string(section++);
+        lanes.emplace_back(MakeLane(id, -1, node, neighbours[k]));
+        lanes.emplace_back(MakeLane(id, -2, node, neighbours[k]));
+        lanes.emplace_back(MakeLane(id, 1, neighbours[k], node));
+        lanes.emplace_back(MakeLane(id, 2, neighbours[k], node));
+      }
+    }
+  }
+  return lanes;
+}
+
+}  // namespace test
+}  // namespace route
+}  // namespace engine
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_ENGINE_TESTS_GRID_LANES_H_
@@ -5,10 +5,13 @@
 #include <opendrive-engine/engine.h>
 #include <tinyxml2.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <cstdlib>
 #include <map>
 #include <memory>
+#include <random>
 #include <string>
 #include <utility>
 #include <vector>
@@ -66,6 +69,112 @@ TEST_F(TestKDTree, TestKDTreeAll) {
   ASSERT_DOUBLE_EQ(0, knn_ret.front().dist);
 }
 
+TEST_F(TestKDTree, TestShardedMatchesBruteForce) {
+  opendrive::engine::kdtree::SamplePoints samples;
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<double> position(-500, 500);
+  for (int i = 0; i < 5000; i++) {
+    opendrive::engine::kdtree::SamplePoint point(position(rng), position(rng));
+    point.mutable_id() = std::to_string(i);
+    samples.emplace_back(point);
+  }
+  opendrive::engine::kdtree::KDTreeParam param;
+  param.max_shard_size = 300;
+  param.max_threads = 3;
+  opendrive::engine::kdtree::KDTree kdtree;
+  kdtree.Init(samples, param);
+  ASSERT_EQ(32, kdtree.num_shards());
+  for (int q = 0; q < 200; q++) {
+    const double x = position(rng) * 1.2;
+    const double y = position(rng) * 1.2;
+    std::vector<double> dists;
+    for (const auto& point : samples) {
+      dists.emplace_back(std::hypot(point.x() - x, point.y() - y));
+    }
+    std::sort(dists.begin(), dists.end());
+    auto knn_ret = kdtree.Query(x, y, 5);
+    ASSERT_EQ(5, knn_ret.size());
+    for (size_t i = 0; i < knn_ret.size(); i++) {
+      ASSERT_NEAR(dists[i], knn_ret[i].dist, 1e-9);
+      const auto& point = samples.at(std::stoi(knn_ret[i].id));
+      ASSERT_DOUBLE_EQ(point.x(), knn_ret[i].x);
+      ASSERT_DOUBLE_EQ(point.y(), knn_ret[i].y);
+    }
+  }
+  ASSERT_TRUE(kdtree.Query(0.0, 0.0, 5001).empty());
+}
+
+TEST_F(TestKDTree, TestApproximateWithinBound) {
+  opendrive::engine::kdtree::SamplePoints samples;
+  std::mt19937 rng(11);
+  std::uniform_real_distribution<double> position(-500, 500);
+  for (int i = 0; i < 5000; i++) {
+    opendrive::engine::kdtree::SamplePoint point(position(rng), position(rng));
+    point.mutable_id() = std::to_string(i);
+    samples.emplace_back(point);
+  }
+  opendrive::engine::kdtree::KDTreeParam param;
+  param.max_shard_size = 1000;
+  opendrive::engine::kdtree::KDTree kdtree;
+  kdtree.Init(samples, param);
+  opendrive::engine::kdtree::SearchParam search_param;
+  search_param.eps = 0.5;
+  search_param.max_distance = 20;
+  for (int q = 0; q < 200; q++) {
+    const double x = position(rng) * 1.2;
+    const double y = position(rng) * 1.2;
+    std::vector<double> dists;
+    for (const auto& point : samples) {
+      dists.emplace_back(std::hypot(point.x() - x, point.y() - y));
+    }
+    std::sort(dists.begin(), dists.end());
+    auto knn_ret = kdtree.Query(x, y, 5, search_param);
+    ASSERT_LE(knn_ret.size(), 5);
+    for (size_t i = 0; i < knn_ret.size(); i++) {
+      ASSERT_LE(knn_ret[i].dist, 20);
+      ASSERT_LE(knn_ret[i].dist, 1.5 * dists[i] + 1e-9);
+    }
+    // nothing beyond the cutoff, so the first sample within it is found
+    if (dists[0] <= 20 / 1.5) {
+      ASSERT_FALSE(knn_ret.empty());
+    }
+    if (dists[0] > 20) {
+      ASSERT_TRUE(knn_ret.empty());
+    }
+  }
+}
+
+TEST_F(TestKDTree, TestBatchMatchesSingle) {
+  opendrive::engine::kdtree::SamplePoints samples;
+  std::mt19937 rng(13);
+  std::uniform_real_distribution<double> position(-500, 500);
+  for (int i = 0; i < 3000; i++) {
+    opendrive::engine::kdtree::SamplePoint point(position(rng), position(rng));
+    point.mutable_id() = std::to_string(i);
+    samples.emplace_back(point);
+  }
+  opendrive::engine::kdtree::KDTreeParam param;
+  param.max_shard_size = 500;
+  opendrive::engine::kdtree::KDTree kdtree;
+  kdtree.Init(samples, param);
+  std::vector<opendrive::engine::kdtree::SamplePoint> queries;
+  for (int q = 0; q < 500; q++) {
+    queries.emplace_back(position(rng) * 1.2, position(rng) * 1.2);
+  }
+  auto batch = kdtree.Query(queries, 3);
+  ASSERT_EQ(queries.size(), batch.size());
+  for (size_t q = 0; q < queries.size(); q++) {
+    auto single = kdtree.Query(queries[q], 3);
+    ASSERT_EQ(single.size(), batch[q].size());
+    for (size_t i = 0; i < single.size(); i++) {
+      ASSERT_EQ(single[i].id, batch[q][i].id);
+      ASSERT_DOUBLE_EQ(single[i].dist, batch[q][i].dist);
+    }
+  }
+  queries.clear();
+  ASSERT_TRUE(kdtree.Query(queries, 3).empty());
+}
+
 int main(int argc, char* argv[]) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,45 @@
+#include "opendrive-engine/geometry/line_segment2d.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+using opendrive::engine::geometry::LineSegment2d;
+using opendrive::engine::geometry::Vec2d;
+
+// the arithmetic is usable in constant expressions
+static_assert((Vec2d(1, 2) + Vec2d(3, 4) * 2.0).y() == 10.0, "");
+static_assert(Vec2d::CrossProd({0, 0}, {1, 0}, {0, 1}) == 1.0, "");
+static_assert(Vec2d(1, 2).InnerProd({7, 10}) == 27.0, "");
+
+TEST(TestLineSegment2d, BatchDistanceSquare) {
+  std::mt19937 rng(17);
+  std::uniform_real_distribution<double> dist(-10, 10);
+  std::vector<double> x;
+  std::vector<double> y;
+  // odd count, so the tail after the full blocks is covered too
+  for (int i = 0; i < 1001; ++i) {
+    x.push_back(dist(rng));
+    y.push_back(dist(rng));
+  }
+  const std::vector<LineSegment2d> segments = {
+      LineSegment2d({-3, 1}, {4, 2}),
+      LineSegment2d({5, 5}, {5, -5}),
+      LineSegment2d({1, 1}, {1, 1}),  // degenerate
+  };
+  std::vector<double> distance_sqr(x.size());
+  for (const auto& segment : segments) {
+    segment.DistanceSquareTo(x.data(), y.data(), x.size(),
+                             distance_sqr.data());
+    for (size_t i = 0; i < x.size(); ++i) {
+      EXPECT_NEAR(segment.DistanceSquareTo({x[i], y[i]}), distance_sqr[i],
+                  1e-9);
+    }
+  }
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,132 @@
+#include "opendrive-engine/geometry/polygon2d.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+using opendrive::engine::geometry::Box2d;
+using opendrive::engine::geometry::LineSegment2d;
+using opendrive::engine::geometry::Polygon2d;
+using opendrive::engine::geometry::Vec2d;
+using opendrive::engine::geometry::Vec2dBatch;
+
+namespace {
+
+// the per-edge distance used for non-convex polygons
+double EdgeDistance(const Polygon2d& lhs, const Polygon2d& rhs) {
+  if (lhs.IsPointIn(rhs.points()[0]) || rhs.IsPointIn(lhs.points()[0])) {
+    return 0.0;
+  }
+  double distance = std::numeric_limits<double>::infinity();
+  for (const auto& segment : lhs.line_segments()) {
+    distance = std::min(distance, rhs.DistanceTo(segment));
+  }
+  return distance;
+}
+
+Polygon2d RandomConvex(std::mt19937& rng, double cx, double cy,
+                       double radius) {
+  std::uniform_real_distribution<double> dist(-radius, radius);
+  std::uniform_int_distribution<int> num(3, 40);
+  std::vector<Vec2d> points;
+  const int n = num(rng);
+  for (int i = 0; i < n; ++i) {
+    points.emplace_back(cx + dist(rng), cy + dist(rng));
+  }
+  Polygon2d polygon;
+  Polygon2d::ComputeConvexHull(points, &polygon);
+  return polygon;
+}
+
+}  // namespace
+
+TEST(TestPolygon2d, ConvexDistance) {
+  const Polygon2d box1(Box2d({0, 0}, 0, 2, 2));
+  const Polygon2d box2(Box2d({5, 0}, 0, 2, 2));
+  const Polygon2d box3(Box2d({5, 4}, M_PI_4, 2, 2));
+  EXPECT_NEAR(3.0, box1.DistanceTo(box2), 1e-9);
+  EXPECT_NEAR(3.0, box2.DistanceTo(box1), 1e-9);
+  EXPECT_NEAR(EdgeDistance(box1, box3), box1.DistanceTo(box3), 1e-9);
+  EXPECT_FALSE(box1.HasOverlap(box2));
+  // touching edges and containment
+  const Polygon2d box4(Box2d({2, 0}, 0, 2, 2));
+  const Polygon2d box5(Box2d({0, 0}, 0.3, 0.5, 0.5));
+  EXPECT_NEAR(0.0, box1.DistanceTo(box4), 1e-9);
+  EXPECT_TRUE(box1.HasOverlap(box4));
+  EXPECT_EQ(0.0, box1.DistanceTo(box5));
+  EXPECT_TRUE(box5.HasOverlap(box1));
+}
+
+TEST(TestPolygon2d, ConvexDistanceRandom) {
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> center(-20, 20);
+  std::uniform_real_distribution<double> radius(0.5, 8);
+  for (int i = 0; i < 2000; ++i) {
+    const Polygon2d lhs = RandomConvex(rng, 0, 0, radius(rng));
+    const Polygon2d rhs =
+        RandomConvex(rng, center(rng), center(rng), radius(rng));
+    ASSERT_TRUE(lhs.is_convex() && rhs.is_convex());
+    const double expected = EdgeDistance(lhs, rhs);
+    EXPECT_NEAR(expected, lhs.DistanceTo(rhs), 1e-6);
+    EXPECT_EQ(expected <= 1e-10, lhs.HasOverlap(rhs));
+  }
+}
+
+TEST(TestPolygon2d, ConvexIoU) {
+  const Polygon2d square({{0, 0}, {1, 0}, {1, 1}, {0, 1}});
+  const Polygon2d shifted({{0.5, 0}, {1.5, 0}, {1.5, 1}, {0.5, 1}});
+  EXPECT_NEAR(1.0 / 3.0, square.ComputeIoU(shifted), 1e-12);
+  EXPECT_NEAR(1.0, square.ComputeIoU(square), 1e-12);
+  const Polygon2d far({{3, 3}, {4, 3}, {4, 4}, {3, 4}});
+  EXPECT_EQ(0.0, square.ComputeIoU(far));
+
+  // shoelace on the clipped vertices against the overlap polygon area
+  std::mt19937 rng(9);
+  std::uniform_real_distribution<double> center(-6, 6);
+  std::uniform_real_distribution<double> radius(0.5, 8);
+  for (int i = 0; i < 2000; ++i) {
+    const Polygon2d lhs = RandomConvex(rng, 0, 0, radius(rng));
+    const Polygon2d rhs =
+        RandomConvex(rng, center(rng), center(rng), radius(rng));
+    Polygon2d overlap;
+    double expected = 0.0;
+    if (lhs.ComputeOverlap(rhs, &overlap)) {
+      expected = overlap.area() / (lhs.area() + rhs.area() - overlap.area());
+    }
+    EXPECT_NEAR(expected, lhs.ComputeIoU(rhs), 1e-9);
+  }
+}
+
+TEST(TestPolygon2d, BatchPointIn) {
+  // non-convex, with a collinear vertex
+  const Polygon2d polygon({{0, 0}, {4, 0}, {4, 4}, {2, 1}, {0, 4}, {0, 2}});
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<double> dist(-1, 5);
+  Vec2dBatch points;
+  for (int i = 0; i < 1000; ++i) {
+    points.emplace_back(dist(rng), dist(rng));
+  }
+  for (const auto& vertex : polygon.points()) {
+    points.push_back(vertex);
+  }
+  points.emplace_back(2, 0);
+  points.emplace_back(3, 2.5);
+  std::vector<uint8_t> inside;
+  std::vector<double> distances;
+  polygon.IsPointIn(points, &inside);
+  polygon.DistanceTo(points, &distances);
+  ASSERT_EQ(points.size(), inside.size());
+  ASSERT_EQ(points.size(), distances.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    EXPECT_EQ(polygon.IsPointIn(points[i]), static_cast<bool>(inside[i]));
+    EXPECT_NEAR(polygon.DistanceTo(points[i]), distances[i], 1e-9);
+  }
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
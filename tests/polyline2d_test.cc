@@ -0,0 +1,83 @@
+#include "opendrive-engine/geometry/polyline2d.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "opendrive-engine/geometry/line_segment2d.h"
+
+using opendrive::engine::geometry::LineSegment2d;
+using opendrive::engine::geometry::Polyline2d;
+using opendrive::engine::geometry::Vec2d;
+
+TEST(TestPolyline2d, ProjectionMatchesScan) {
+  std::mt19937 rng(23);
+  std::uniform_real_distribution<double> jitter(-0.3, 0.3);
+  std::vector<Vec2d> points;
+  for (int i = 0; i < 3000; ++i) {
+    points.emplace_back(0.5 * i, 20 * std::sin(0.004 * i) + jitter(rng));
+    if (0 == i % 500) points.push_back(points.back());  // degenerate segment
+  }
+  const Polyline2d polyline(points);
+  ASSERT_EQ(points.size(), polyline.num_points());
+  ASSERT_EQ(points.size() - 1, polyline.num_segments());
+
+  std::vector<LineSegment2d> segments;
+  for (size_t i = 0; i + 1 < points.size(); ++i) {
+    segments.emplace_back(points[i], points[i + 1]);
+  }
+  std::uniform_real_distribution<double> x(-100, 1600);
+  std::uniform_real_distribution<double> y(-60, 60);
+  for (int i = 0; i < 2000; ++i) {
+    const Vec2d point(x(rng), y(rng));
+    double expected = std::numeric_limits<double>::max();
+    for (const auto& segment : segments) {
+      expected = std::min(expected, segment.DistanceTo(point));
+    }
+    double s = 0;
+    double l = 0;
+    double distance = 0;
+    const int index = polyline.GetProjection(point, &s, &l, &distance);
+    ASSERT_GE(index, 0);
+    EXPECT_NEAR(expected, distance, 1e-9);
+    EXPECT_NEAR(expected, polyline.DistanceTo(point), 1e-9);
+    // the projection lies on the nearest segment
+    EXPECT_NEAR(distance, point.DistanceTo(polyline.GetPoint(s)), 1e-6);
+  }
+}
+
+TEST(TestPolyline2d, NaNPoint) {
+  const Polyline2d polyline({{0, 0}, {3, 4}, {3, 10}});
+  const Vec2d point(std::nan(""), 1.0);
+  double s = 0;
+  double l = 0;
+  double distance = 0;
+  EXPECT_EQ(-1, polyline.GetProjection(point, &s, &l, &distance));
+  Vec2d nearest(7, 7);
+  EXPECT_TRUE(std::isinf(polyline.DistanceTo(point, &nearest)));
+  EXPECT_EQ(7, nearest.x());
+  EXPECT_EQ(7, nearest.y());
+}
+
+TEST(TestPolyline2d, ArcLength) {
+  const Polyline2d polyline({{0, 0}, {3, 4}, {3, 4}, {3, 10}});
+  EXPECT_DOUBLE_EQ(11.0, polyline.length());
+  EXPECT_EQ(0, polyline.GetSegmentIndex(-1));
+  EXPECT_EQ(0, polyline.GetSegmentIndex(2.5));
+  EXPECT_EQ(2, polyline.GetSegmentIndex(5.0));
+  EXPECT_EQ(2, polyline.GetSegmentIndex(20));
+  EXPECT_NEAR(1.5, polyline.GetPoint(2.5).x(), 1e-12);
+  EXPECT_NEAR(2.0, polyline.GetPoint(2.5).y(), 1e-12);
+  EXPECT_NEAR(7.0, polyline.GetPoint(8.0).y(), 1e-12);
+  EXPECT_NEAR(M_PI / 2, polyline.GetHeading(8.0), 1e-12);
+  EXPECT_NEAR(-1.0, polyline.GetLateral({4, 8}), 1e-12);
+  EXPECT_NEAR(1.0, polyline.GetLateral({2, 8}), 1e-12);
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
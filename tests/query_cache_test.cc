@@ -0,0 +1,115 @@
+#include "opendrive-engine/common/query_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using opendrive::engine::common::QueryCache;
+using opendrive::engine::common::QueryCacheKey;
+
+namespace {
+
+QueryCacheKey Key(int64_t x, int64_t y, uint32_t k = 3) {
+  QueryCacheKey key;
+  key.x = x;
+  key.y = y;
+  key.k = k;
+  key.eps = 0;
+  key.max_distance = 0;
+  return key;
+}
+
+}  // namespace
+
+TEST(QueryCacheTest, HitsOnlyTheSameKeyAndVersion) {
+  QueryCache cache;
+  cache.Init(1000);
+  ASSERT_EQ(1024, cache.capacity());
+  uint32_t values[QueryCache::kMaxValues];
+  size_t count = 0;
+  ASSERT_FALSE(cache.Lookup(Key(1, 2), 1, values, &count));
+
+  const uint32_t inserted[] = {7, 3, 5};
+  cache.Insert(Key(1, 2), 1, inserted, 3);
+  ASSERT_TRUE(cache.Lookup(Key(1, 2), 1, values, &count));
+  ASSERT_EQ(3, count);
+  for (size_t i = 0; i < count; ++i) ASSERT_EQ(inserted[i], values[i]);
+
+  ASSERT_FALSE(cache.Lookup(Key(1, 3), 1, values, &count));
+  ASSERT_FALSE(cache.Lookup(Key(1, 2, 4), 1, values, &count));
+  QueryCacheKey filtered = Key(1, 2);
+  filtered.eps = 42;
+  ASSERT_FALSE(cache.Lookup(filtered, 1, values, &count));
+  // parameters that would hash alike still have to be identical
+  filtered = Key(1, 2);
+  filtered.eps = 1;
+  filtered.max_distance = -31;
+  ASSERT_FALSE(cache.Lookup(filtered, 1, values, &count));
+  // a reloaded map has another version
+  ASSERT_FALSE(cache.Lookup(Key(1, 2), 2, values, &count));
+
+  // the same size keeps the slots, entries are still version checked
+  cache.Init(1024);
+  ASSERT_TRUE(cache.Lookup(Key(1, 2), 1, values, &count));
+  ASSERT_FALSE(cache.Lookup(Key(1, 2), 2, values, &count));
+}
+
+TEST(QueryCacheTest, DisabledAndOversized) {
+  QueryCache cache;
+  uint32_t values[QueryCache::kMaxValues + 1] = {};
+  size_t count = 0;
+  cache.Insert(Key(0, 0), 1, values, 1);
+  ASSERT_FALSE(cache.Lookup(Key(0, 0), 1, values, &count));
+  cache.Init(16);
+  cache.Insert(Key(0, 0), 1, values, QueryCache::kMaxValues + 1);
+  ASSERT_FALSE(cache.Lookup(Key(0, 0), 1, values, &count));
+}
+
+TEST(QueryCacheTest, ConcurrentReadersSeeWholeEntries) {
+  // every entry holds its key in every value, a torn read would mix keys
+  QueryCache cache;
+  cache.Init(64);
+  std::atomic<bool> stop(false);
+  std::atomic<size_t> hits(0);
+  std::atomic<size_t> torn(0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 2; ++t) {
+    threads.emplace_back([&, t]() {
+      uint32_t values[QueryCache::kMaxValues];
+      for (uint32_t i = 0; !stop; ++i) {
+        const uint32_t key = (i * 7 + t) % 512;
+        for (auto& value : values) value = key;
+        cache.Insert(Key(key, 0, 8), 1, values, QueryCache::kMaxValues);
+      }
+    });
+  }
+  for (int t = 0; t < 2; ++t) {
+    threads.emplace_back([&, t]() {
+      uint32_t values[QueryCache::kMaxValues];
+      size_t count = 0;
+      for (uint32_t i = 0; i < 200000; ++i) {
+        const uint32_t key = (i * 13 + t) % 512;
+        if (!cache.Lookup(Key(key, 0, 8), 1, values, &count)) continue;
+        ++hits;
+        for (size_t k = 0; k < count; ++k) {
+          if (values[k] != key) ++torn;
+        }
+      }
+    });
+  }
+  threads[2].join();
+  threads[3].join();
+  stop = true;
+  threads[0].join();
+  threads[1].join();
+  ASSERT_EQ(0, torn.load());
+  ASSERT_LT(0, hits.load());
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,168 @@
+#include "opendrive-engine/algo/bvh/road_index.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using opendrive::engine::bvh::RoadIndex;
+using opendrive::engine::bvh::RoadIndexLane;
+using opendrive::engine::bvh::RoadIndexLanes;
+using opendrive::engine::bvh::RoadIndexLevel;
+using opendrive::engine::bvh::RoadIndexParam;
+using opendrive::engine::bvh::RoadIndexResults;
+using opendrive::engine::geometry::Polyline2d;
+using opendrive::engine::geometry::Vec2d;
+
+namespace {
+
+class TestRoadIndex : public testing::Test {
+ protected:
+  void SetUp() override {
+    // wiggly roads of a few sections with two to four parallel lanes each
+    std::mt19937 rng(19);
+    std::uniform_real_distribution<double> position(-500, 500);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::uniform_int_distribution<int> count(2, 4);
+    for (int road = 0; road < 120; ++road) {
+      Vec2d start(position(rng), position(rng));
+      double heading = angle(rng);
+      const int sections = count(rng) - 1;
+      for (int section = 0; section < sections; ++section) {
+        const int lanes = count(rng);
+        const double turn = 0.02 * angle(rng) / M_PI;
+        for (int lane = 0; lane < lanes; ++lane) {
+          std::vector<Vec2d> points;
+          Vec2d point = start + Vec2d::CreateUnitVec2d(heading - M_PI / 2) *
+                                    (3.5 * lane);
+          double h = heading;
+          for (int i = 0; i < 40; ++i) {
+            points.emplace_back(point);
+            point += Vec2d::CreateUnitVec2d(h);
+            h += turn;
+          }
+          curves_.emplace_back(points);
+          names_.push_back({std::to_string(road),
+                            std::to_string(road) + "_" +
+                                std::to_string(section),
+                            std::to_string(road) + "_" +
+                                std::to_string(section) + "_" +
+                                std::to_string(-lane - 1)});
+        }
+        for (int i = 0; i < 40; ++i) {
+          start += Vec2d::CreateUnitVec2d(heading);
+          heading += turn;
+        }
+      }
+    }
+    // shuffled, the index groups the lanes itself
+    std::vector<size_t> order(curves_.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::shuffle(order.begin(), order.end(), rng);
+    for (size_t i = 0; i < names_.size(); ++i) lane_index_[names_[i][2]] = i;
+    for (size_t i : order) {
+      lanes_.push_back({names_[i][0], names_[i][1], names_[i][2], &curves_[i]});
+    }
+  }
+
+  // the distance of every road, section or lane, nearest first
+  std::vector<std::pair<double, std::string>> BruteForce(
+      const Vec2d& point, RoadIndexLevel level) const {
+    std::map<std::string, double> nearest;
+    for (size_t i = 0; i < curves_.size(); ++i) {
+      double s = 0;
+      double lateral = 0;
+      double distance = 0;
+      curves_[i].GetProjection(point, &s, &lateral, &distance);
+      const std::string& id = names_[i][static_cast<int>(level)];
+      if (!nearest.count(id) || distance < nearest[id]) nearest[id] = distance;
+    }
+    std::vector<std::pair<double, std::string>> sorted;
+    for (const auto& item : nearest) {
+      sorted.emplace_back(item.second, item.first);
+    }
+    std::sort(sorted.begin(), sorted.end());
+    return sorted;
+  }
+
+  std::vector<Polyline2d> curves_;
+  std::vector<std::vector<std::string>> names_;
+  std::map<std::string, size_t> lane_index_;
+  RoadIndexLanes lanes_;
+};
+
+}  // namespace
+
+TEST_F(TestRoadIndex, MatchesBruteForceOnEveryLevel) {
+  RoadIndexParam param;
+  param.max_threads = 3;
+  RoadIndex index;
+  index.Init(lanes_, param);
+  ASSERT_EQ(120, index.num_roads());
+  ASSERT_EQ(curves_.size(), index.num_lanes());
+
+  std::mt19937 rng(2);
+  std::uniform_real_distribution<double> position(-600, 600);
+  RoadIndexResults results;
+  for (int i = 0; i < 200; ++i) {
+    const Vec2d point(position(rng), position(rng));
+    for (auto level : {RoadIndexLevel::ROAD, RoadIndexLevel::SECTION,
+                       RoadIndexLevel::LANE}) {
+      const auto expected = BruteForce(point, level);
+      const size_t k = 1 + i % 7;
+      index.Search(point, level, k, &results);
+      ASSERT_EQ(std::min(k, expected.size()), results.size());
+      for (size_t j = 0; j < results.size(); ++j) {
+        EXPECT_NEAR(expected[j].first, results[j].distance, 1e-9);
+        EXPECT_EQ(expected[j].second, results[j].id);
+        // the nearest lane is reported along with its projection
+        const auto& lane_id = results[j].lane_id;
+        EXPECT_EQ(0, lane_id.find(results[j].id));
+        const auto& curve = curves_[lane_index_.at(lane_id)];
+        double s = 0;
+        double lateral = 0;
+        const int segment = curve.GetProjection(point, &s, &lateral);
+        EXPECT_EQ(s, results[j].s);
+        EXPECT_EQ(lateral, results[j].lateral);
+        const Vec2d direction =
+            curve.point(segment + 1) - curve.point(segment);
+        EXPECT_NEAR(direction.Angle(), results[j].heading, 1e-12);
+      }
+    }
+  }
+}
+
+TEST_F(TestRoadIndex, MaxDistanceLimitsResults) {
+  RoadIndex index;
+  index.Init(lanes_);
+  const Vec2d point(0, 0);
+  const auto expected = BruteForce(point, RoadIndexLevel::LANE);
+  const double max_distance = 0.5 * (expected[2].first + expected[3].first);
+  RoadIndexResults results;
+  index.Search(point, RoadIndexLevel::LANE, 10, &results, max_distance);
+  ASSERT_EQ(3, results.size());
+  index.Search(point, RoadIndexLevel::LANE, 0, &results);
+  EXPECT_TRUE(results.empty());
+}
+
+TEST_F(TestRoadIndex, SkipsEmptyCurves) {
+  Polyline2d empty;
+  RoadIndexLanes lanes = {{"a", "a_0", "a_0_1", &empty},
+                          {"b", "b_0", "b_0_1", nullptr}};
+  RoadIndex index;
+  index.Init(lanes);
+  EXPECT_EQ(0, index.num_roads());
+  RoadIndexResults results;
+  index.Search({0, 0}, RoadIndexLevel::ROAD, 3, &results);
+  EXPECT_TRUE(results.empty());
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
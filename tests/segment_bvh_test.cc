@@ -0,0 +1,157 @@
+#include "opendrive-engine/algo/bvh/segment_bvh.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using opendrive::engine::bvh::SegmentBVH;
+using opendrive::engine::bvh::SegmentIds;
+using opendrive::engine::bvh::SegmentIndices;
+using opendrive::engine::bvh::SegmentTags;
+using opendrive::engine::bvh::Segments;
+using opendrive::engine::geometry::AABox2d;
+using opendrive::engine::geometry::LineSegment2d;
+using opendrive::engine::geometry::Vec2d;
+
+TEST(TestSegmentBVH, QueryMatchesBruteForce) {
+  std::mt19937 rng(11);
+  std::uniform_real_distribution<double> position(-200, 200);
+  std::uniform_real_distribution<double> offset(-3, 3);
+  Segments segments;
+  SegmentIds ids;
+  for (int i = 0; i < 5000; ++i) {
+    const Vec2d start(position(rng), position(rng));
+    segments.emplace_back(start, start + Vec2d(offset(rng), offset(rng)));
+    ids.emplace_back(std::to_string(i));
+  }
+  SegmentBVH bvh;
+  bvh.Init(segments, ids);
+  ASSERT_EQ(segments.size(), bvh.size());
+
+  SegmentIndices indices;
+  std::uniform_real_distribution<double> size(0.1, 40);
+  for (int i = 0; i < 200; ++i) {
+    const AABox2d box({position(rng), position(rng)}, size(rng), size(rng));
+    bvh.Query(box, &indices);
+    std::vector<std::string> found;
+    for (size_t index : indices) found.emplace_back(bvh.id(index));
+    std::vector<std::string> expected;
+    for (size_t j = 0; j < segments.size(); ++j) {
+      const AABox2d bound(segments[j].start(), segments[j].end());
+      if (bound.HasOverlap(box)) expected.emplace_back(ids[j]);
+    }
+    std::sort(found.begin(), found.end());
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(expected, found);
+  }
+}
+
+TEST(TestSegmentBVH, RaycastMatchesBruteForce) {
+  std::mt19937 rng(23);
+  std::uniform_real_distribution<double> position(-200, 200);
+  std::uniform_real_distribution<double> offset(-5, 5);
+  std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+  Segments segments;
+  SegmentIds ids;
+  SegmentTags tags;
+  for (int i = 0; i < 5000; ++i) {
+    const Vec2d start(position(rng), position(rng));
+    segments.emplace_back(start, start + Vec2d(offset(rng), offset(rng)));
+    ids.emplace_back(std::to_string(i));
+    tags.emplace_back(i % 2);
+  }
+  SegmentBVH bvh;
+  bvh.Init(segments, ids, tags);
+  ASSERT_EQ(segments.size(), bvh.size());
+
+  const double max_range = 80;
+  int hits = 0;
+  for (int i = 0; i < 500; ++i) {
+    const Vec2d origin(position(rng), position(rng));
+    const Vec2d direction = Vec2d::CreateUnitVec2d(angle(rng));
+    const LineSegment2d ray(origin, origin + max_range * direction);
+    double expected = std::numeric_limits<double>::infinity();
+    Vec2d point;
+    for (const auto& segment : segments) {
+      if (segment.GetIntersect(ray, &point)) {
+        expected = std::min(expected, origin.DistanceTo(point));
+      }
+    }
+    double distance = 0;
+    const int index = bvh.Raycast(origin, direction, max_range, &distance);
+    if (std::isinf(expected)) {
+      EXPECT_EQ(-1, index);
+      continue;
+    }
+    ++hits;
+    ASSERT_GE(index, 0);
+    EXPECT_NEAR(expected, distance, 1e-6);
+    EXPECT_EQ(std::stoi(bvh.id(index)) % 2, static_cast<int>(bvh.tag(index)));
+  }
+  EXPECT_GT(hits, 100);
+}
+
+TEST(TestSegmentBVH, NearestMatchesBruteForce) {
+  std::mt19937 rng(31);
+  std::uniform_real_distribution<double> position(-200, 200);
+  std::uniform_real_distribution<double> offset(-5, 5);
+  Segments segments;
+  SegmentIds ids;
+  for (int i = 0; i < 3000; ++i) {
+    const Vec2d start(position(rng), position(rng));
+    segments.emplace_back(start, start + Vec2d(offset(rng), offset(rng)));
+    ids.emplace_back(std::to_string(i));
+  }
+  SegmentBVH bvh;
+  bvh.Init(segments, ids);
+
+  std::uniform_real_distribution<double> query(-250, 250);
+  for (int i = 0; i < 500; ++i) {
+    const Vec2d point(query(rng), query(rng));
+    double expected = std::numeric_limits<double>::infinity();
+    for (const auto& segment : segments) {
+      expected = std::min(expected, segment.DistanceTo(point));
+    }
+    double distance = -1;
+    const int index = bvh.Nearest(
+        point, std::numeric_limits<double>::infinity(), &distance);
+    ASSERT_GE(index, 0);
+    EXPECT_NEAR(expected, distance, 1e-9);
+    EXPECT_NEAR(expected, bvh.segment(index).DistanceTo(point), 1e-9);
+    // a bound at the answer still finds it, a tighter one finds nothing
+    ASSERT_EQ(index, bvh.Nearest(point, distance, &distance));
+    ASSERT_EQ(-1, bvh.Nearest(point, 0.99 * expected, &distance));
+  }
+  SegmentBVH empty;
+  double distance = 0;
+  EXPECT_EQ(-1, empty.Nearest({0, 0}, 10, &distance));
+}
+
+TEST(TestSegmentBVH, RaycastPrefersExitingSegment) {
+  // two boundaries on the same line, one per side of a lane border
+  Segments segments = {LineSegment2d({0, -1}, {0, 1}),
+                       LineSegment2d({0, 1}, {0, -1})};
+  SegmentIds ids = {"up", "down"};
+  SegmentBVH bvh;
+  bvh.Init(segments, ids);
+  double distance = 0;
+  // the ray runs along +x, leaving the left side of the first segment
+  int index = bvh.Raycast({-2, 0}, {1, 0}, 10, &distance);
+  ASSERT_GE(index, 0);
+  EXPECT_EQ("up", bvh.id(index));
+  EXPECT_NEAR(2.0, distance, 1e-12);
+  index = bvh.Raycast({2, 0}, {-1, 0}, 10, &distance);
+  ASSERT_GE(index, 0);
+  EXPECT_EQ("down", bvh.id(index));
+  EXPECT_EQ(-1, bvh.Raycast({-2, 0}, {1, 0}, 1.5, &distance));
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,125 @@
+#include "opendrive-engine/geometry/transform.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using opendrive::engine::geometry::EulerAnglesZXY;
+using opendrive::engine::geometry::Point3D;
+using opendrive::engine::geometry::Point4D;
+using opendrive::engine::geometry::Quaternion;
+using opendrive::engine::geometry::Transform2d;
+using opendrive::engine::geometry::Transform3d;
+using opendrive::engine::geometry::Vec2d;
+using opendrive::engine::geometry::Vec2dBatch;
+
+TEST(TestTransform2d, ApplyAndInverse) {
+  const Transform2d transform(Point4D(10, -5, 0, M_PI_2));
+  const Vec2d point = transform.Apply({1, 0});
+  EXPECT_NEAR(10, point.x(), 1e-12);
+  EXPECT_NEAR(-4, point.y(), 1e-12);
+  const Vec2d back = transform.Inverse().Apply(point);
+  EXPECT_NEAR(1, back.x(), 1e-12);
+  EXPECT_NEAR(0, back.y(), 1e-12);
+
+  const Transform2d other(3, 4, 0.3);
+  const Vec2d composed = (transform * other).Apply({2, 7});
+  const Vec2d sequential = transform.Apply(other.Apply({2, 7}));
+  EXPECT_NEAR(sequential.x(), composed.x(), 1e-12);
+  EXPECT_NEAR(sequential.y(), composed.y(), 1e-12);
+}
+
+TEST(TestTransform2d, BatchMatchesScalar) {
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<double> position(-50, 50);
+  const Transform2d transform(120.5, -33.25, 2.1);
+  // a size that leaves a tail after the full blocks
+  Vec2dBatch batch;
+  std::vector<Vec2d> points;
+  for (int i = 0; i < 1003; ++i) {
+    points.emplace_back(position(rng), position(rng));
+    batch.push_back(points.back());
+  }
+  transform.Apply(&batch);
+  ASSERT_EQ(points.size(), batch.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    const Vec2d expected = transform.Apply(points[i]);
+    EXPECT_DOUBLE_EQ(expected.x(), batch[i].x());
+    EXPECT_DOUBLE_EQ(expected.y(), batch[i].y());
+  }
+}
+
+TEST(TestTransform3d, MatchesEulerAngles) {
+  // a pure yaw equals the planar transform
+  const Transform3d yaw(EulerAnglesZXY(0.7), Point3D(1, 2, 3));
+  const Transform2d planar(1, 2, 0.7);
+  const Point3D point = yaw.Apply(Point3D(4, -1, 2));
+  const Vec2d expected = planar.Apply({4, -1});
+  EXPECT_NEAR(expected.x(), point.x(), 1e-12);
+  EXPECT_NEAR(expected.y(), point.y(), 1e-12);
+  EXPECT_NEAR(5, point.z(), 1e-12);
+
+  // a scaled quaternion gives the same rotation
+  const EulerAnglesZXY euler(0.1, -0.2, 1.3);
+  const Quaternion q = euler.ToQuaternion();
+  const Transform3d unit(q, Point3D());
+  const Transform3d scaled(Quaternion(2 * q.w(), 2 * q.x(), 2 * q.y(),
+                                      2 * q.z()),
+                           Point3D());
+  for (size_t row = 0; row < 3; ++row) {
+    for (size_t col = 0; col < 3; ++col) {
+      EXPECT_NEAR(unit.rotation(row, col), scaled.rotation(row, col), 1e-12);
+    }
+  }
+  // the rotation recovers the euler angles it was built from
+  const EulerAnglesZXY recovered(q);
+  EXPECT_NEAR(euler.roll(), recovered.roll(), 1e-12);
+  EXPECT_NEAR(euler.pitch(), recovered.pitch(), 1e-12);
+  EXPECT_NEAR(euler.yaw(), recovered.yaw(), 1e-12);
+}
+
+TEST(TestTransform3d, BatchAndInverse) {
+  std::mt19937 rng(9);
+  std::uniform_real_distribution<double> position(-50, 50);
+  const Transform3d transform(EulerAnglesZXY(0.05, -0.03, 2.4),
+                              Point3D(500, -20, 1.5));
+  const Transform3d inverse = transform.Inverse();
+  std::vector<double> x;
+  std::vector<double> y;
+  std::vector<double> z;
+  for (int i = 0; i < 517; ++i) {
+    x.emplace_back(position(rng));
+    y.emplace_back(position(rng));
+    z.emplace_back(position(rng));
+  }
+  std::vector<double> out_x(x.size());
+  std::vector<double> out_y(x.size());
+  std::vector<double> out_z(x.size());
+  transform.Apply(x.data(), y.data(), z.data(), x.size(), out_x.data(),
+                  out_y.data(), out_z.data());
+  for (size_t i = 0; i < x.size(); ++i) {
+    const Point3D expected = transform.Apply(Point3D(x[i], y[i], z[i]));
+    EXPECT_DOUBLE_EQ(expected.x(), out_x[i]);
+    EXPECT_DOUBLE_EQ(expected.y(), out_y[i]);
+    EXPECT_DOUBLE_EQ(expected.z(), out_z[i]);
+  }
+  // in place, back to the original frame
+  inverse.Apply(out_x.data(), out_y.data(), out_z.data(), x.size(),
+                out_x.data(), out_y.data(), out_z.data());
+  for (size_t i = 0; i < x.size(); ++i) {
+    EXPECT_NEAR(x[i], out_x[i], 1e-9);
+    EXPECT_NEAR(y[i], out_y[i], 1e-9);
+    EXPECT_NEAR(z[i], out_z[i], 1e-9);
+  }
+  const Point3D identity = (inverse * transform).Apply(Point3D(1, 2, 3));
+  EXPECT_NEAR(1, identity.x(), 1e-9);
+  EXPECT_NEAR(2, identity.y(), 1e-9);
+  EXPECT_NEAR(3, identity.z(), 1e-9);
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
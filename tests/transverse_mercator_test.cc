@@ -0,0 +1,95 @@
+#include "opendrive-engine/geometry/transverse_mercator.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+using opendrive::engine::geometry::TransverseMercator;
+
+TEST(TestTransverseMercator, ParseGeoReference) {
+  TransverseMercator projection;
+  ASSERT_TRUE(projection.Init(
+      "+proj=tmerc +lat_0=4.9000000000000000e+1 +lon_0=8.0000000000000000e+0 "
+      "+k=1 +x_0=0 +y_0=0 +datum=WGS84 +units=m +geoidgrids=egm96_15.gtx "
+      "+vunits=m +no_defs"));
+  EXPECT_DOUBLE_EQ(49.0, projection.lat0());
+  EXPECT_DOUBLE_EQ(8.0, projection.lon0());
+  double x = 1;
+  double y = 1;
+  projection.Forward(49.0, 8.0, &x, &y);
+  EXPECT_NEAR(0, x, 1e-9);
+  EXPECT_NEAR(0, y, 1e-9);
+
+  // no +proj is read as tmerc
+  ASSERT_TRUE(projection.Init("+lat_0=4.9e+1 +lon_0=8"));
+  EXPECT_DOUBLE_EQ(8.0, projection.lon0());
+
+  ASSERT_TRUE(projection.Init("+proj=utm +zone=32 +ellps=WGS84 +units=m"));
+  EXPECT_DOUBLE_EQ(9.0, projection.lon0());
+  EXPECT_DOUBLE_EQ(0.9996, projection.k0());
+
+  EXPECT_FALSE(projection.Init("+proj=merc +lon_0=8"));
+  EXPECT_FALSE(projection.Init("+proj=utm +ellps=WGS84"));
+  EXPECT_FALSE(projection.Init("+proj=tmerc +ellps=bessel"));
+  EXPECT_FALSE(projection.Init("+proj=tmerc +lat_0=abc"));
+  // a failed init keeps the previous projection
+  EXPECT_DOUBLE_EQ(9.0, projection.lon0());
+}
+
+TEST(TestTransverseMercator, ForwardUtm) {
+  // reference values from the USGS (Snyder) series, good to a millimeter
+  // this close to the central meridian
+  TransverseMercator projection;
+  double x = 0;
+  double y = 0;
+  ASSERT_TRUE(projection.Init("+proj=utm +zone=31 +datum=WGS84"));
+  projection.Forward(48.8583, 2.2945, &x, &y);
+  EXPECT_NEAR(448251.898, x, 1e-2);
+  EXPECT_NEAR(5411943.794, y, 1e-2);
+  ASSERT_TRUE(projection.Init("+proj=utm +zone=18 +datum=WGS84"));
+  projection.Forward(40.6892, -74.0445, &x, &y);
+  EXPECT_NEAR(580735.871, x, 1e-2);
+  EXPECT_NEAR(4504695.165, y, 1e-2);
+  ASSERT_TRUE(projection.Init("+proj=utm +zone=56 +south +datum=WGS84"));
+  projection.Forward(-33.8568, 151.2153, &x, &y);
+  EXPECT_NEAR(334900.570, x, 1e-2);
+  EXPECT_NEAR(6252288.753, y, 1e-2);
+}
+
+TEST(TestTransverseMercator, BatchRoundTrip) {
+  TransverseMercator projection;
+  ASSERT_TRUE(projection.Init("+proj=tmerc +lat_0=31.2 +lon_0=121.4"));
+  std::mt19937 rng(17);
+  std::uniform_real_distribution<double> lat(-80, 80);
+  std::uniform_real_distribution<double> lon(121.4 - 20, 121.4 + 20);
+  const size_t size = 1000;
+  std::vector<double> lats(size);
+  std::vector<double> lons(size);
+  for (size_t i = 0; i < size; ++i) {
+    lats[i] = lat(rng);
+    lons[i] = lon(rng);
+  }
+  std::vector<double> x(size);
+  std::vector<double> y(size);
+  projection.Forward(lats.data(), lons.data(), size, x.data(), y.data());
+  std::vector<double> back_lat(size);
+  std::vector<double> back_lon(size);
+  projection.Inverse(x.data(), y.data(), size, back_lat.data(),
+                     back_lon.data());
+  for (size_t i = 0; i < size; ++i) {
+    double scalar_x = 0;
+    double scalar_y = 0;
+    projection.Forward(lats[i], lons[i], &scalar_x, &scalar_y);
+    EXPECT_DOUBLE_EQ(scalar_x, x[i]);
+    EXPECT_DOUBLE_EQ(scalar_y, y[i]);
+    // 1e-9 degrees is about 0.1 millimeter
+    EXPECT_NEAR(lats[i], back_lat[i], 1e-9);
+    EXPECT_NEAR(lons[i], back_lon[i], 1e-9);
+  }
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -8,7 +8,32 @@ namespace opendrive {
 namespace engine {
 namespace server {
 
-RequestBase::RequestBase() { engine_ = GlobalData::Instance()->GetEngine(); }
+RequestBase::RequestBase(const std::string& endpoint) {
+  engine_ = GlobalData::Instance()->GetEngine();
+  metrics_ = Metrics::Instance()->Register(endpoint);
+  worker_pool_ = GlobalData::Instance()->GetWorkerPool();
+  queue_ = worker_pool_->Queue(endpoint);
+}
+
+std::string RequestBase::Dispatch(const std::function<std::string()>& handle) {
+  RequestTimer timer(metrics_);
+  // the worker copies its thread local buffer out, the http thread blocks
+  // here since typhoon responds from inside the handler call. Param checks
+  // that the lower priority queues can not hold every http thread.
+  std::promise<std::string> promise;
+  auto future = promise.get_future();
+  if (!worker_pool_->Submit(queue_, [&handle, &promise]() {
+        try {
+          promise.set_value(handle());
+        } catch (...) {
+          promise.set_exception(std::current_exception());
+        }
+      })) {
+    metrics_->RecordRejected();
+    return SetResponse(HttpStatusCode::BUSY, "server busy, retry later");
+  }
+  return future.get();
+}
 
 bool RequestBase::CheckRequestData(const RequiredKeys& keys,
                                    const std::string& data, Json& data_out) {
@@ -44,58 +69,142 @@ bool RequestBase::IsNumberType(const Json& value) const {
   return false;
 }
 
-std::string RequestBase::SetResponse(const Json& data, HttpStatusCode code,
-                                     const std::string& msg) {
-  Json response;
-  response["code"] = code;
-  response["msg"] = msg;
-  response["results"] = data;
-  return response.dump(0);
+JsonWriter& RequestBase::StartResponse(HttpStatusCode code,
+                                       const std::string& msg) {
+  JsonWriter& writer = JsonWriter::ThreadLocal();
+  writer.StartObject();
+  writer.Key("code").Value(static_cast<int>(code));
+  writer.Key("msg").Value(msg);
+  writer.Key("results");
+  return writer;
+}
+
+const std::string& RequestBase::EndResponse(JsonWriter& writer) {
+  writer.EndObject();
+  metrics_->RecordBytes(writer.str().size());
+  return writer.str();
+}
+
+const std::string& RequestBase::SetResponse(HttpStatusCode code,
+                                            const std::string& msg) {
+  JsonWriter& writer = StartResponse(code, msg);
+  writer.Null();
+  return EndResponse(writer);
 }
 
 void OkApi::Get(typhoon::Application* app, typhoon::Connection* conn) {
+  RequestTimer timer(metrics_);
   Response(app, conn, "ok get");
 }
 
 void OkApi::Post(typhoon::Application* app, typhoon::Connection* conn) {
+  RequestTimer timer(metrics_);
   Response(app, conn, "ok post");
 }
 
 void GlobalMapApi::Get(typhoon::Application* app, typhoon::Connection* conn) {
   ELOG_INFO("Http Request GlobalMapApi Get");
-  Json response;
-  Json line_json;
+  Response(app, conn, Dispatch([this]() { return Handle(); }));
+}
+
+std::string GlobalMapApi::Handle() {
+  JsonWriter& writer = StartResponse(HttpStatusCode::SUCCESS, "ok");
+  writer.StartArray();
   for (const auto& lane : engine_->GetLanes()) {
-    ConvertLaneToSimplePts(lane, response);
+    ConvertLaneToSimplePts(lane, writer);
   }
-  Response(app, conn, SetResponse(response, HttpStatusCode::SUCCESS, "ok"));
+  writer.EndArray();
+  return EndResponse(writer);
 }
 
 void NearestLane::Post(typhoon::Application* app, typhoon::Connection* conn) {
   ELOG_INFO("Http Request NearestLane Post");
-  Json response;
   std::string req_data = typhoon::RequestHandler::GetRequestData(conn);
   ELOG_INFO("Request Data: " << req_data);
+  Response(app, conn, Dispatch([this, &req_data]() {
+             return Handle(req_data);
+           }));
+}
+
+std::string NearestLane::Handle(const std::string& req_data) {
   nlohmann::json data_json;
   if (!CheckRequestData(required_keys_, req_data, data_json)) {
-    typhoon::RequestHandler::Response(
-        app, conn,
-        SetResponse(nlohmann::json(), HttpStatusCode::PARAM,
-                    "Request数据异常"));
-    return;
+    return SetResponse(HttpStatusCode::PARAM, "Request数据异常");
   }
   auto lanes = engine_->GetNearestLanes(data_json["x"], data_json["y"], 1);
   if (1 != lanes.size()) {
-    typhoon::RequestHandler::Response(
-        app, conn,
-        SetResponse(nlohmann::json(), HttpStatusCode::FAILED,
-                    "Query Nearest Lanes Fault."));
+    return SetResponse(HttpStatusCode::FAILED, "Query Nearest Lanes Fault.");
   }
   auto lane = lanes.front();
   ELOG_INFO("Nearest Lane Id: " << lane->id());
-  ConvertLaneToSimplePts(lane, response);
-  Response(app, conn,
-           SetResponse(response, HttpStatusCode::SUCCESS, "get nearest lane"));
+  JsonWriter& writer =
+      StartResponse(HttpStatusCode::SUCCESS, "get nearest lane");
+  writer.StartArray();
+  ConvertLaneToSimplePts(lane, writer);
+  writer.EndArray();
+  return EndResponse(writer);
+}
+
+bool MapMatchApi::ParsePoses(const Json& poses_json, MatchPoses& poses) const {
+  poses.clear();
+  poses.reserve(poses_json.size());
+  MatchPose pose;
+  for (const auto& item : poses_json) {
+    if (!item.is_object() || !item.contains("x") || !item.contains("y") ||
+        !IsNumberType(item["x"]) || !IsNumberType(item["y"])) {
+      return false;
+    }
+    pose.x = item["x"];
+    pose.y = item["y"];
+    pose.has_heading =
+        item.contains("heading") && IsNumberType(item["heading"]);
+    pose.heading = pose.has_heading ? item["heading"].get<double>() : 0;
+    poses.emplace_back(pose);
+  }
+  return true;
+}
+
+void MapMatchApi::Post(typhoon::Application* app, typhoon::Connection* conn) {
+  std::string req_data = typhoon::RequestHandler::GetRequestData(conn);
+  Response(app, conn, Dispatch([this, &req_data]() {
+             return Handle(req_data);
+           }));
+}
+
+std::string MapMatchApi::Handle(const std::string& req_data) {
+  Json data_json;
+  MatchPoses poses;
+  if (!CheckRequestData(required_keys_, req_data, data_json) ||
+      !ParsePoses(data_json["poses"], poses)) {
+    return SetResponse(HttpStatusCode::PARAM, "Request数据异常");
+  }
+  auto param = GlobalData::Instance()->GetParam();
+  auto matcher = sessions_.Get(data_json["session"], engine_, param->match());
+  MatchResults results;
+  matcher->Match(poses, results);
+
+  JsonWriter& writer = StartResponse(HttpStatusCode::SUCCESS, "ok");
+  writer.StartArray();
+  for (const auto& result : results) {
+    if (!result.matched) {
+      writer.Null();
+      continue;
+    }
+    // distance and heading let clients judge how well the pose matched
+    writer.StartObject();
+    writer.Key("dist").Value(result.projection.dist);
+    writer.Key("heading").Value(result.projection.heading);
+    writer.Key("l").Value(result.projection.l);
+    writer.Key("lane_id").Value(result.projection.lane_id);
+    writer.Key("s").Value(result.projection.s);
+    writer.EndObject();
+  }
+  writer.EndArray();
+  return EndResponse(writer);
+}
+
+void MetricsApi::Get(typhoon::Application* app, typhoon::Connection* conn) {
+  Response(app, conn, Metrics::Instance()->Serialize(engine_->GetStats()));
 }
 
 }  // namespace server
@@ -2,11 +2,17 @@
 #define OPENDRIVE_ENGINE_SERVER_API_H_
 #include <typhoon/typhoon.h>
 
+#include <functional>
+#include <future>
 #include <nlohmann/json.hpp>
+#include <string>
 
 #include "global_data.h"
 #include "log.h"
+#include "map_match.h"
+#include "metrics.h"
 #include "util.h"
+#include "worker_pool.h"
 
 namespace opendrive {
 namespace engine {
@@ -16,25 +22,39 @@ enum class HttpStatusCode {
   SUCCESS = 1000,
   FAILED,
   PARAM,
+  BUSY,  // endpoint queue is full
 };
 
 class RequestBase {
  public:
-  RequestBase();
+  explicit RequestBase(const std::string& endpoint);
   virtual ~RequestBase() = default;
 
  protected:
+  // runs handle on the endpoint queue of the worker pool and returns the
+  // response body, or a BUSY response when the queue is full.
+  virtual std::string Dispatch(
+      const std::function<std::string()>& handle) final;
   virtual bool CheckRequestData(const RequiredKeys& keys,
                                 const std::string& data, Json& data_out) final;
   virtual bool IsNumberType(const Json& value) const final;
-  virtual std::string SetResponse(const Json& data,
-                                  HttpStatusCode code = HttpStatusCode::SUCCESS,
-                                  const std::string& msg = "ok") final;
+  // writes the envelope up to "results":, the caller appends the results
+  virtual JsonWriter& StartResponse(
+      HttpStatusCode code = HttpStatusCode::SUCCESS,
+      const std::string& msg = "ok") final;
+  virtual const std::string& EndResponse(JsonWriter& writer) final;
+  // response with null results
+  virtual const std::string& SetResponse(HttpStatusCode code,
+                                         const std::string& msg) final;
   engine::Engine::Ptr engine_;
+  EndpointMetrics* metrics_;
+  WorkerPool::Ptr worker_pool_;
+  size_t queue_;
 };
 
 class OkApi : public typhoon::RequestHandler, public RequestBase {
  public:
+  OkApi() : RequestBase("ok") {}
   virtual void Get(typhoon::Application* app,
                    typhoon::Connection* conn) override;
   virtual void Post(typhoon::Application* app,
@@ -43,22 +63,51 @@ class OkApi : public typhoon::RequestHandler, public RequestBase {
 
 class GlobalMapApi : public typhoon::RequestHandler, public RequestBase {
  public:
+  GlobalMapApi() : RequestBase("map") {}
   virtual void Get(typhoon::Application* app,
                    typhoon::Connection* conn) override;
+
+ private:
+  std::string Handle();
 };
 
 class NearestLane : public typhoon::RequestHandler, public RequestBase {
  public:
+  NearestLane() : RequestBase("nearest_lane") {}
   virtual void Post(typhoon::Application* app,
                     typhoon::Connection* conn) override;
 
  private:
+  std::string Handle(const std::string& req_data);
   RequiredKeys required_keys_{
       std::make_pair("x", nlohmann::json::value_t::number_float),
       std::make_pair("y", nlohmann::json::value_t::number_float),
   };
 };
 
+class MapMatchApi : public typhoon::RequestHandler, public RequestBase {
+ public:
+  MapMatchApi() : RequestBase("map_match") {}
+  virtual void Post(typhoon::Application* app,
+                    typhoon::Connection* conn) override;
+
+ private:
+  std::string Handle(const std::string& req_data);
+  bool ParsePoses(const Json& poses_json, MatchPoses& poses) const;
+  MatchSessions sessions_;
+  RequiredKeys required_keys_{
+      std::make_pair("session", nlohmann::json::value_t::string),
+      std::make_pair("poses", nlohmann::json::value_t::array),
+  };
+};
+
+class MetricsApi : public typhoon::RequestHandler, public RequestBase {
+ public:
+  MetricsApi() : RequestBase("metrics") {}
+  virtual void Get(typhoon::Application* app,
+                   typhoon::Connection* conn) override;
+};
+
 }  // namespace server
 }  // namespace engine
 }  // namespace opendrive
@@ -26,6 +26,7 @@ int GlobalData::Init(const std::string& yaml_path) {
     std::cerr << engine_status.msg << std::endl;
     return -1;
   }
+  worker_pool_ = std::make_shared<WorkerPool>(param_->worker());
   std::cout << "GlobalData Init End." << std::endl;
   return 0;
 }
@@ -34,6 +35,8 @@ Param::Ptr GlobalData::GetParam() { return param_; }
 
 engine::Engine::Ptr GlobalData::GetEngine() { return engine_; }
 
+WorkerPool::Ptr GlobalData::GetWorkerPool() { return worker_pool_; }
+
 }  // namespace server
 }  // namespace engine
 }  // namespace opendrive
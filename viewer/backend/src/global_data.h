@@ -10,6 +10,7 @@
 
 #include "opendrive-engine/common/param.h"
 #include "param.h"
+#include "worker_pool.h"
 
 namespace opendrive {
 namespace engine {
@@ -20,10 +21,12 @@ class GlobalData {
   int Init(const std::string& yaml_path);
   Param::Ptr GetParam();
   engine::Engine::Ptr GetEngine();
+  WorkerPool::Ptr GetWorkerPool();
 
  private:
   engine::Engine::Ptr engine_;
   Param::Ptr param_;
+  WorkerPool::Ptr worker_pool_;
   CACTUS_DECLARE_SINGLETON(GlobalData)  // 注册单例
 };
 
@@ -0,0 +1,186 @@
+#include "json_writer.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace opendrive {
+namespace engine {
+namespace server {
+
+JsonWriter& JsonWriter::ThreadLocal() {
+  thread_local JsonWriter writer;
+  writer.Clear();
+  return writer;
+}
+
+void JsonWriter::Clear() {
+  buffer_.clear();  // keeps capacity
+  first_.clear();
+  after_key_ = false;
+}
+
+void JsonWriter::Separator() {
+  if (after_key_) {
+    after_key_ = false;
+    return;
+  }
+  if (first_.empty()) return;
+  if (first_.back()) {
+    first_.back() = false;
+  } else {
+    buffer_.push_back(',');
+  }
+}
+
+JsonWriter& JsonWriter::StartObject() {
+  Separator();
+  buffer_.push_back('{');
+  first_.push_back(true);
+  return *this;
+}
+
+JsonWriter& JsonWriter::EndObject() {
+  buffer_.push_back('}');
+  first_.pop_back();
+  return *this;
+}
+
+JsonWriter& JsonWriter::StartArray() {
+  Separator();
+  buffer_.push_back('[');
+  first_.push_back(true);
+  return *this;
+}
+
+JsonWriter& JsonWriter::EndArray() {
+  buffer_.push_back(']');
+  first_.pop_back();
+  return *this;
+}
+
+JsonWriter& JsonWriter::Key(const std::string& key) {
+  Separator();
+  Escape(key);
+  buffer_.push_back(':');
+  after_key_ = true;
+  return *this;
+}
+
+int JsonWriter::FormatDouble(double d, char* buffer) {
+  for (int precision = 15; precision < 17; ++precision) {
+    const int n = std::snprintf(buffer, 32, "%.*g", precision, d);
+    if (std::strtod(buffer, nullptr) == d) return n;
+  }
+  return std::snprintf(buffer, 32, "%.17g", d);
+}
+
+JsonWriter& JsonWriter::Value(double d) {
+  Separator();
+  if (!std::isfinite(d)) {
+    buffer_.append("null");
+    return *this;
+  }
+  char tmp[32];
+  buffer_.append(tmp, FormatDouble(d, tmp));
+  return *this;
+}
+
+JsonWriter& JsonWriter::Value(int64_t i) {
+  Separator();
+  buffer_.append(std::to_string(i));
+  return *this;
+}
+
+JsonWriter& JsonWriter::Value(const std::string& s) {
+  Separator();
+  Escape(s);
+  return *this;
+}
+
+JsonWriter& JsonWriter::Null() {
+  Separator();
+  buffer_.append("null");
+  return *this;
+}
+
+JsonWriter& JsonWriter::Coordinate(double d) {
+  Separator();
+  if (!std::isfinite(d)) {
+    buffer_.append("null");
+    return *this;
+  }
+  char tmp[32];
+  const double abs_d = std::abs(d);
+  if (abs_d >= 1e12) {
+    buffer_.append(tmp, FormatDouble(d, tmp));
+    return *this;
+  }
+  uint64_t scaled = static_cast<uint64_t>(std::llround(abs_d * 1e6));
+  uint64_t integer = scaled / 1000000;
+  uint64_t fraction = scaled % 1000000;
+  char* end = tmp + sizeof(tmp);
+  char* p = end;
+  if (fraction) {
+    int digits = 6;
+    while (0 == fraction % 10) {
+      fraction /= 10;
+      --digits;
+    }
+    while (digits--) {
+      *--p = static_cast<char>('0' + fraction % 10);
+      fraction /= 10;
+    }
+    *--p = '.';
+  }
+  do {
+    *--p = static_cast<char>('0' + integer % 10);
+    integer /= 10;
+  } while (integer);
+  if (d < 0 && scaled) *--p = '-';
+  buffer_.append(p, end - p);
+  return *this;
+}
+
+JsonWriter& JsonWriter::Point(double x, double y) {
+  StartArray();
+  Coordinate(x);
+  Coordinate(y);
+  return EndArray();
+}
+
+void JsonWriter::Escape(const std::string& s) {
+  buffer_.push_back('"');
+  for (char c : s) {
+    switch (c) {
+      case '"':
+        buffer_.append("\\\"");
+        break;
+      case '\\':
+        buffer_.append("\\\\");
+        break;
+      case '\n':
+        buffer_.append("\\n");
+        break;
+      case '\r':
+        buffer_.append("\\r");
+        break;
+      case '\t':
+        buffer_.append("\\t");
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char tmp[8];
+          std::snprintf(tmp, sizeof(tmp), "\\u%04x", c);
+          buffer_.append(tmp);
+        } else {
+          buffer_.push_back(c);
+        }
+    }
+  }
+  buffer_.push_back('"');
+}
+
+}  // namespace server
+}  // namespace engine
+}  // namespace opendrive
@@ -0,0 +1,67 @@
+#ifndef OPENDRIVE_ENGINE_SERVER_JSON_WRITER_H_
+#define OPENDRIVE_ENGINE_SERVER_JSON_WRITER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace opendrive {
+namespace engine {
+namespace server {
+
+/**
+ * @class JsonWriter
+ * @brief Appends json tokens straight into a string buffer, no dom is built.
+ *        Commas are inserted automatically, the caller is responsible for
+ *        balancing Start/End calls.
+ */
+class JsonWriter {
+ public:
+  JsonWriter() = default;
+
+  /**
+   * @brief Per-thread writer whose buffer keeps its capacity between
+   *        requests. The returned writer is cleared.
+   */
+  static JsonWriter& ThreadLocal();
+
+  void Clear();
+  JsonWriter& StartObject();
+  JsonWriter& EndObject();
+  JsonWriter& StartArray();
+  JsonWriter& EndArray();
+  JsonWriter& Key(const std::string& key);
+  // exact, the shortest form that reads back as d
+  JsonWriter& Value(double d);
+  JsonWriter& Value(int64_t i);
+  JsonWriter& Value(int i) { return Value(static_cast<int64_t>(i)); }
+  JsonWriter& Value(const std::string& s);
+  JsonWriter& Value(const char* s) { return Value(std::string(s)); }
+  JsonWriter& Null();
+  // map coordinates in meters, rounded to micrometers, which is much
+  // cheaper than an exact conversion
+  JsonWriter& Coordinate(double d);
+  // writes [x, y] as coordinates
+  JsonWriter& Point(double x, double y);
+  const std::string& str() const { return buffer_; }
+
+  /**
+   * @brief Format a double with the fewest of 15 to 17 significant digits
+   *        that convert back to the same value.
+   * @return The number of characters written, buffer needs 32.
+   */
+  static int FormatDouble(double d, char* buffer);
+
+ private:
+  void Separator();
+  void Escape(const std::string& s);
+  std::string buffer_;
+  std::vector<bool> first_;  // first element of each open container
+  bool after_key_ = false;
+};
+
+}  // namespace server
+}  // namespace engine
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_ENGINE_SERVER_JSON_WRITER_H_
@@ -0,0 +1,131 @@
+#include "map_match.h"
+
+#include <opendrive-engine/math/math.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <unordered_set>
+
+namespace opendrive {
+namespace engine {
+namespace server {
+
+namespace {
+
+// Lanes with a positive id drive against the reference line.
+double TravelHeading(const core::LaneProjection& projection) {
+  auto pos = projection.lane_id.find_last_of('_');
+  if (std::string::npos != pos &&
+      std::atoi(projection.lane_id.c_str() + pos + 1) > 0) {
+    return math::NormalizeAngle(projection.heading + M_PI);
+  }
+  return projection.heading;
+}
+
+}  // namespace
+
+MapMatcher::MapMatcher(engine::Engine::Ptr engine, const MatchConfig& config)
+    : engine_(engine), config_(config), has_last_(false) {}
+
+double MapMatcher::Cost(const MatchPose& pose,
+                        const core::LaneProjection& projection) const {
+  double cost = projection.dist;
+  if (pose.has_heading) {
+    cost += config_.heading_weight *
+            std::abs(math::AngleDiff(pose.heading, TravelHeading(projection)));
+  }
+  if (has_last_ && last_.lane_id != projection.lane_id) {
+    cost += config_.switch_penalty;
+  }
+  return cost;
+}
+
+void MapMatcher::Match(const MatchPoses& poses, MatchResults& results) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  results.clear();
+  results.resize(poses.size());
+  if (poses.empty()) return;
+
+  // one engine round trip for the whole tick
+  std::vector<geometry::Point2D> points;
+  points.reserve(poses.size());
+  for (const auto& pose : poses) {
+    points.emplace_back(pose.x, pose.y);
+  }
+  auto candidates_list = engine_->GetNearestLanes(
+      points, static_cast<size_t>(config_.candidate_num));
+
+  core::LaneProjection projection;
+  std::unordered_set<core::Id> visited;
+  for (size_t i = 0; i < poses.size(); ++i) {
+    const auto& pose = poses.at(i);
+    double min_cost = std::numeric_limits<double>::max();
+    visited.clear();
+    // the previous lane always competes, even if it fell out of the top-k
+    if (has_last_) {
+      visited.insert(last_.lane_id);
+      if (engine_->GetProjection(last_.lane_id, pose.x, pose.y, projection)) {
+        min_cost = Cost(pose, projection);
+        results[i].matched = true;
+        results[i].projection = projection;
+      }
+    }
+    for (const auto& lane : candidates_list.at(i)) {
+      if (!lane || !visited.insert(lane->id()).second) continue;
+      if (!engine_->GetProjection(lane->id(), pose.x, pose.y, projection)) {
+        continue;
+      }
+      const double cost = Cost(pose, projection);
+      if (cost < min_cost) {
+        min_cost = cost;
+        results[i].matched = true;
+        results[i].projection = projection;
+      }
+    }
+    if (results[i].matched) {
+      last_ = results[i].projection;
+      has_last_ = true;
+    }
+  }
+}
+
+MapMatcher::Ptr MatchSessions::Get(const std::string& session,
+                                   engine::Engine::Ptr engine,
+                                   const MatchConfig& config) {
+  auto now = MapMatcher::Clock::now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  Expire(now, config.session_timeout);
+  auto it = sessions_.find(session);
+  if (it != sessions_.end()) {
+    lru_.splice(lru_.begin(), lru_, it->second.lru);
+    it->second.last_active = now;
+    return it->second.matcher;
+  }
+  // clients that keep opening sessions must not grow the server unbounded
+  while (!lru_.empty() &&
+         sessions_.size() >= static_cast<size_t>(config.max_sessions)) {
+    sessions_.erase(lru_.back());
+    lru_.pop_back();
+  }
+  lru_.push_front(session);
+  auto matcher = std::make_shared<MapMatcher>(engine, config);
+  sessions_[session] = Session{matcher, now, lru_.begin()};
+  return matcher;
+}
+
+void MatchSessions::Expire(MapMatcher::Clock::time_point now,
+                           double timeout) {
+  // least recently used last, so the idle ones are at the back
+  while (!lru_.empty()) {
+    const auto it = sessions_.find(lru_.back());
+    std::chrono::duration<double> idle = now - it->second.last_active;
+    if (idle.count() <= timeout) break;
+    sessions_.erase(it);
+    lru_.pop_back();
+  }
+}
+
+}  // namespace server
+}  // namespace engine
+}  // namespace opendrive
@@ -0,0 +1,87 @@
+#ifndef OPENDRIVE_ENGINE_SERVER_MAP_MATCH_H_
+#define OPENDRIVE_ENGINE_SERVER_MAP_MATCH_H_
+
+#include <opendrive-engine/engine.h>
+
+#include <chrono>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "param.h"
+
+namespace opendrive {
+namespace engine {
+namespace server {
+
+struct MatchPose {
+  MatchPose() : x(0), y(0), heading(0), has_heading(false) {}
+  double x;
+  double y;
+  double heading;
+  bool has_heading;
+};
+typedef std::vector<MatchPose> MatchPoses;
+
+struct MatchResult {
+  MatchResult() : matched(false) {}
+  bool matched;
+  core::LaneProjection projection;
+};
+typedef std::vector<MatchResult> MatchResults;
+
+/**
+ * @class MapMatcher
+ * @brief Per-session matcher, keeps the previous match so that consecutive
+ *        poses stick to the same lane instead of jumping between overlapping
+ *        candidates.
+ */
+class MapMatcher {
+ public:
+  typedef std::shared_ptr<MapMatcher> Ptr;
+  typedef std::chrono::steady_clock Clock;
+  MapMatcher(engine::Engine::Ptr engine, const MatchConfig& config);
+  void Match(const MatchPoses& poses, MatchResults& results);
+
+ private:
+  double Cost(const MatchPose& pose,
+              const core::LaneProjection& projection) const;
+  std::mutex mutex_;  // one tick at a time per session
+  engine::Engine::Ptr engine_;
+  MatchConfig config_;
+  core::LaneProjection last_;
+  bool has_last_;
+};
+
+/**
+ * @class MatchSessions
+ * @brief Matchers by session id, least recently used first out: idle ones
+ *        expire after the session timeout, and a new session beyond
+ *        max_sessions evicts the least recently used one.
+ */
+class MatchSessions {
+ public:
+  MatchSessions() = default;
+  MapMatcher::Ptr Get(const std::string& session, engine::Engine::Ptr engine,
+                      const MatchConfig& config);
+
+ private:
+  struct Session {
+    MapMatcher::Ptr matcher;
+    MapMatcher::Clock::time_point last_active;
+    std::list<std::string>::iterator lru;
+  };
+  void Expire(MapMatcher::Clock::time_point now, double timeout);
+  std::mutex mutex_;
+  std::unordered_map<std::string, Session> sessions_;
+  std::list<std::string> lru_;  // most recently used first
+};
+
+}  // namespace server
+}  // namespace engine
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_ENGINE_SERVER_MAP_MATCH_H_
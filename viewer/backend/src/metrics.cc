@@ -0,0 +1,155 @@
+#include "metrics.h"
+
+#include <sstream>
+
+#include "json_writer.h"
+
+namespace opendrive {
+namespace engine {
+namespace server {
+
+namespace {
+
+// upper bounds in seconds
+const double kLatencyBuckets[EndpointMetrics::kBucketNum] = {
+    0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025,
+    0.05,   0.1,   0.25,   0.5,   1.0,  2.5};
+
+void AppendHeader(const std::string& name, const std::string& type,
+                  const std::string& help, std::ostringstream& out) {
+  out << "# HELP " << name << " " << help << "\n";
+  out << "# TYPE " << name << " " << type << "\n";
+}
+
+// the default stream precision of 6 digits would drop most of a large sum
+std::string Number(double value) {
+  char buffer[32];
+  return std::string(buffer, JsonWriter::FormatDouble(value, buffer));
+}
+
+}  // namespace
+
+constexpr size_t EndpointMetrics::kBucketNum;
+
+EndpointMetrics::EndpointMetrics(const std::string& name) : name_(name) {}
+
+void EndpointMetrics::RecordLatency(uint64_t nanoseconds) {
+  requests_.Add();
+  latency_ns_.Add(nanoseconds);
+  const double seconds = nanoseconds * 1e-9;
+  size_t bucket = 0;
+  while (bucket < kBucketNum && seconds > kLatencyBuckets[bucket]) {
+    ++bucket;
+  }
+  buckets_[bucket].Add();
+}
+
+void EndpointMetrics::RecordBytes(size_t bytes) {
+  responses_.Add();
+  bytes_.Add(bytes);
+}
+
+Metrics::Metrics() {}
+
+EndpointMetrics* Metrics::Register(const std::string& endpoint) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& item : endpoints_) {
+    if (endpoint == item->name()) return item.get();
+  }
+  endpoints_.emplace_back(new EndpointMetrics(endpoint));
+  return endpoints_.back().get();
+}
+
+std::string Metrics::Serialize(const common::Stats& engine_stats) {
+  std::ostringstream stream;
+  {
+    // one family after another, as the exposition format requires
+    std::lock_guard<std::mutex> lock(mutex_);
+    AppendHeader("engine_server_requests_total", "counter",
+                 "Requests handled per endpoint.", stream);
+    for (const auto& item : endpoints_) {
+      stream << "engine_server_requests_total{endpoint=\"" << item->name()
+             << "\"} " << item->requests() << "\n";
+    }
+    AppendHeader("engine_server_request_duration_seconds", "histogram",
+                 "Handler latency per endpoint.", stream);
+    for (const auto& item : endpoints_) {
+      const std::string label = "{endpoint=\"" + item->name() + "\"";
+      uint64_t cumulative = 0;
+      for (size_t i = 0; i < EndpointMetrics::kBucketNum; ++i) {
+        cumulative += item->bucket(i);
+        stream << "engine_server_request_duration_seconds_bucket" << label
+               << ",le=\"" << Number(kLatencyBuckets[i]) << "\"} "
+               << cumulative << "\n";
+      }
+      cumulative += item->bucket(EndpointMetrics::kBucketNum);
+      stream << "engine_server_request_duration_seconds_bucket" << label
+             << ",le=\"+Inf\"} " << cumulative << "\n";
+      stream << "engine_server_request_duration_seconds_sum" << label << "} "
+             << Number(item->latency_seconds()) << "\n";
+      stream << "engine_server_request_duration_seconds_count" << label
+             << "} " << cumulative << "\n";
+    }
+    AppendHeader("engine_server_responses_total", "counter",
+                 "Responses serialized per endpoint.", stream);
+    for (const auto& item : endpoints_) {
+      stream << "engine_server_responses_total{endpoint=\"" << item->name()
+             << "\"} " << item->responses() << "\n";
+    }
+    AppendHeader("engine_server_response_bytes_total", "counter",
+                 "Response body bytes per endpoint.", stream);
+    for (const auto& item : endpoints_) {
+      stream << "engine_server_response_bytes_total{endpoint=\""
+             << item->name() << "\"} " << item->bytes() << "\n";
+    }
+    AppendHeader("engine_server_rejected_total", "counter",
+                 "Requests rejected by a full worker queue.", stream);
+    for (const auto& item : endpoints_) {
+      stream << "engine_server_rejected_total{endpoint=\"" << item->name()
+             << "\"} " << item->rejected() << "\n";
+    }
+  }
+
+  AppendHeader("opendrive_engine_map_elements", "gauge",
+               "Loaded map elements by kind.", stream);
+  stream << "opendrive_engine_map_elements{kind=\"road\"} "
+         << engine_stats.road_num << "\n";
+  stream << "opendrive_engine_map_elements{kind=\"section\"} "
+         << engine_stats.section_num << "\n";
+  stream << "opendrive_engine_map_elements{kind=\"lane\"} "
+         << engine_stats.lane_num << "\n";
+  stream << "opendrive_engine_map_elements{kind=\"sample\"} "
+         << engine_stats.sample_num << "\n";
+  AppendHeader("opendrive_engine_map_memory_bytes", "gauge",
+               "Estimated memory of the loaded map.", stream);
+  stream << "opendrive_engine_map_memory_bytes " << engine_stats.memory_bytes
+         << "\n";
+  const std::vector<std::pair<std::string, common::QueryStats>> queries{
+      {"nearest_points", engine_stats.nearest_points},
+      {"nearest_lanes", engine_stats.nearest_lanes},
+      {"nearest_lanes_cached", engine_stats.nearest_lanes_cached},
+      {"projection", engine_stats.projection},
+  };
+  AppendHeader("opendrive_engine_queries_total", "counter",
+               "Engine queries by kind.", stream);
+  for (const auto& query : queries) {
+    stream << "opendrive_engine_queries_total{query=\"" << query.first
+           << "\"} " << query.second.count << "\n";
+  }
+  AppendHeader("opendrive_engine_query_seconds_total", "counter",
+               "Accumulated engine query latency by kind.", stream);
+  for (const auto& query : queries) {
+    stream << "opendrive_engine_query_seconds_total{query=\"" << query.first
+           << "\"} " << Number(query.second.seconds) << "\n";
+  }
+  AppendHeader("opendrive_engine_query_cache_misses_total", "counter",
+               "Cacheable engine queries not found in the cache.", stream);
+  stream << "opendrive_engine_query_cache_misses_total"
+         << "{query=\"nearest_lanes\"} "
+         << engine_stats.nearest_lanes_cache_misses << "\n";
+  return stream.str();
+}
+
+}  // namespace server
+}  // namespace engine
+}  // namespace opendrive
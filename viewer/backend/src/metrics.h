@@ -0,0 +1,88 @@
+#ifndef OPENDRIVE_ENGINE_SERVER_METRICS_H_
+#define OPENDRIVE_ENGINE_SERVER_METRICS_H_
+
+#include <cactus/cactus.h>
+#include <cactus/macros.h>
+#include <opendrive-engine/common/counter.h>
+#include <opendrive-engine/common/stats.h>
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace opendrive {
+namespace engine {
+namespace server {
+
+/**
+ * @class EndpointMetrics
+ * @brief Request count, latency histogram and response size of one endpoint.
+ *        Recording is lock free, see common::Counter.
+ */
+class EndpointMetrics {
+ public:
+  static constexpr size_t kBucketNum = 12;
+  explicit EndpointMetrics(const std::string& name);
+  void RecordLatency(uint64_t nanoseconds);
+  void RecordBytes(size_t bytes);
+  void RecordRejected() { rejected_.Add(); }
+  const std::string& name() const { return name_; }
+  uint64_t requests() const { return requests_.Value(); }
+  uint64_t bucket(size_t i) const { return buckets_[i].Value(); }
+  double latency_seconds() const { return latency_ns_.Value() * 1e-9; }
+  uint64_t responses() const { return responses_.Value(); }
+  uint64_t bytes() const { return bytes_.Value(); }
+  uint64_t rejected() const { return rejected_.Value(); }
+
+ private:
+  std::string name_;
+  common::Counter requests_;
+  common::Counter latency_ns_;
+  common::Counter responses_;
+  common::Counter bytes_;
+  common::Counter rejected_;
+  std::array<common::Counter, kBucketNum + 1> buckets_;  // last is +Inf
+};
+
+/**
+ * @class RequestTimer
+ * @brief Records the handler scope as one request of the endpoint.
+ */
+class RequestTimer {
+ public:
+  explicit RequestTimer(EndpointMetrics* metrics)
+      : metrics_(metrics), start_(std::chrono::steady_clock::now()) {}
+  ~RequestTimer() {
+    if (!metrics_) return;
+    metrics_->RecordLatency(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start_)
+            .count());
+  }
+
+ private:
+  EndpointMetrics* metrics_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+class Metrics {
+ public:
+  // endpoints are registered while the server is built, before serving.
+  EndpointMetrics* Register(const std::string& endpoint);
+  // prometheus text exposition format
+  std::string Serialize(const common::Stats& engine_stats);
+
+ private:
+  std::mutex mutex_;  // guards registration against scraping only
+  std::vector<std::unique_ptr<EndpointMetrics>> endpoints_;
+  CACTUS_DECLARE_SINGLETON(Metrics)
+};
+
+}  // namespace server
+}  // namespace engine
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_ENGINE_SERVER_METRICS_H_
@@ -1,6 +1,7 @@
 #include "param.h"
 
 #include <algorithm>
+#include <limits>
 
 #include "cactus/cactus.h"
 
@@ -31,19 +32,93 @@ int Param::Load(const std::string& yaml_path) {
       http_.thread_num = std::max(6, foo.second.as<int>());
     }
   }
+  for (auto foo : yaml_node["match"]) {
+    std::string key = foo.first.as<std::string>();
+    if ("candidate_num" == key) {
+      match_.candidate_num = std::max(1, foo.second.as<int>());
+    } else if ("session_timeout" == key) {
+      match_.session_timeout = std::max(1.0, foo.second.as<double>());
+    } else if ("max_sessions" == key) {
+      match_.max_sessions = std::max(1, foo.second.as<int>());
+    } else if ("heading_weight" == key) {
+      match_.heading_weight = std::max(0.0, foo.second.as<double>());
+    } else if ("switch_penalty" == key) {
+      match_.switch_penalty = std::max(0.0, foo.second.as<double>());
+    }
+  }
+  for (auto foo : yaml_node["worker"]) {
+    std::string key = foo.first.as<std::string>();
+    if ("thread_num" == key) {
+      worker_.thread_num = std::max(1, foo.second.as<int>());
+    } else if ("queues" == key) {
+      for (auto queue : foo.second) {
+        QueueConfig& config = worker_.queues[queue.first.as<std::string>()];
+        for (auto item : queue.second) {
+          std::string name = item.first.as<std::string>();
+          if ("priority" == name) {
+            config.priority = item.second.as<int>();
+          } else if ("capacity" == name) {
+            config.capacity = std::max(1, item.second.as<int>());
+          } else if ("max_running" == name) {
+            config.max_running = std::max(0, item.second.as<int>());
+          }
+        }
+      }
+    }
+  }
+  if (!CheckWorker()) {
+    return -1;
+  }
   return 0;
 }
 
+bool Param::CheckWorker() const {
+  // an http thread waits until a worker answers its request, so queued and
+  // running requests of the lower priority endpoints must leave http threads
+  // for the top priority ones
+  int top = std::numeric_limits<int>::min();
+  for (const auto& item : worker_.queues) {
+    top = std::max(top, item.second.priority);
+  }
+  int held = 0;
+  for (const auto& item : worker_.queues) {
+    const QueueConfig& config = item.second;
+    if (top == config.priority) continue;
+    const int running = config.max_running > 0
+                            ? std::min(config.max_running, worker_.thread_num)
+                            : worker_.thread_num;
+    held += config.capacity + running;
+  }
+  if (held >= http_.thread_num) {
+    std::cerr << "param worker queues below the top priority hold up to "
+              << held << " http threads, http thread_num must exceed that"
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
 void Param::Print() {
   std::cout << "param engine file: " << engine_param_.map_file << std::endl;
   std::cout << "param engine step: " << engine_param_.step << std::endl;
   std::cout << "param http addr: " << http_.addr << std::endl;
   std::cout << "param http port: " << http_.port << std::endl;
   std::cout << "param http thread_num: " << http_.thread_num << std::endl;
+  std::cout << "param match candidate_num: " << match_.candidate_num
+            << std::endl;
+  std::cout << "param match session_timeout: " << match_.session_timeout
+            << std::endl;
+  std::cout << "param match max_sessions: " << match_.max_sessions
+            << std::endl;
+  std::cout << "param worker thread_num: " << worker_.thread_num << std::endl;
 }
 
 const HttpConfig& Param::http() const { return http_; }
 
+const MatchConfig& Param::match() const { return match_; }
+
+const WorkerConfig& Param::worker() const { return worker_; }
+
 const common::Param& Param::engine_param() const { return engine_param_; }
 
 }  // namespace server
@@ -5,6 +5,8 @@
 
 #include <iostream>
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 #include "opendrive-engine/common/param.h"
 
@@ -18,6 +20,25 @@ struct HttpConfig {
   int thread_num;
 };
 
+struct MatchConfig {
+  int candidate_num = 5;        // nearest lanes considered per pose
+  double session_timeout = 60;  // seconds, idle sessions are dropped
+  int max_sessions = 1024;      // the least recently used one makes room
+  double heading_weight = 2.0;  // cost per radian of heading difference
+  double switch_penalty = 1.0;  // cost of leaving the previous lane
+};
+
+struct QueueConfig {
+  int priority = 0;     // higher runs first
+  int capacity = 64;    // pending requests before rejecting
+  int max_running = 0;  // workers the endpoint may hold, 0 for all
+};
+
+struct WorkerConfig {
+  int thread_num = 4;
+  std::unordered_map<std::string, QueueConfig> queues;  // by endpoint
+};
+
 class Param {
  public:
   typedef std::shared_ptr<Param> Ptr;
@@ -26,10 +47,15 @@ class Param {
   int Load(const std::string& yaml_path);
   void Print();
   const HttpConfig& http() const;
+  const MatchConfig& match() const;
+  const WorkerConfig& worker() const;
   const common::Param& engine_param() const;
 
  private:
+  bool CheckWorker() const;
   HttpConfig http_;
+  MatchConfig match_;
+  WorkerConfig worker_;
   common::Param engine_param_;
 };
 
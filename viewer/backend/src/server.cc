@@ -13,6 +13,8 @@ int Server::Init() {
   ok_ = std::make_shared<server::OkApi>();
   global_map_ = std::make_shared<server::GlobalMapApi>();
   nearest_lane_ = std::make_shared<server::NearestLane>();
+  map_match_ = std::make_shared<server::MapMatchApi>();
+  metrics_ = std::make_shared<server::MetricsApi>();
   return 0;
 }
 
@@ -21,6 +23,8 @@ int Server::Start() {
   server.AddHandle("/opendrive/engine/ok/", ok_);
   server.AddHandle("/opendrive/engine/map/", global_map_);
   server.AddHandle("/opendrive/engine/nearest_lane/", nearest_lane_);
+  server.AddHandle("/opendrive/engine/map_match/", map_match_);
+  server.AddHandle("/metrics", metrics_);
   server.Spin();
   return 0;
 }
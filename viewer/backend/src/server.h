@@ -25,6 +25,8 @@ class Server {
   std::shared_ptr<server::OkApi> ok_;
   std::shared_ptr<server::GlobalMapApi> global_map_;
   std::shared_ptr<server::NearestLane> nearest_lane_;
+  std::shared_ptr<server::MapMatchApi> map_match_;
+  std::shared_ptr<server::MetricsApi> metrics_;
 };
 
 }  // namespace engine
@@ -6,51 +6,49 @@ namespace opendrive {
 namespace engine {
 namespace server {
 
-bool ConvertLineToPts(const core::Curve& line, Json& line_json) {
-  line_json.clear();
-  for (int i = 0; i < line.pts().size(); i++) {
-    line_json[i][0] = line.pts().at(i).x();
-    line_json[i][1] = line.pts().at(i).y();
+bool ConvertLineToPts(const core::Curve& line, JsonWriter& writer) {
+  writer.StartArray();
+  for (const auto& pt : line.pts()) {
+    writer.Point(pt.x(), pt.y());
   }
+  writer.EndArray();
   return true;
 }
 
-bool ConvertLaneToPts(core::Lane::ConstPtr lane, Json& data) {
-  Json left_line;
-  Json right_line;
-  int pts_size =
+bool ConvertLaneToPts(core::Lane::ConstPtr lane, JsonWriter& writer) {
+  const auto& left_pts = lane->left_boundary().curve().pts();
+  const auto& right_pts = lane->right_boundary().curve().pts();
+  size_t pts_size =
       std::min(lane->central_curve().pts().size(),
-               std::min(lane->left_boundary().curve().pts().size(),
-                        lane->right_boundary().curve().pts().size()));
-  for (int i = 0; i < pts_size; i++) {
-    left_line[i][0] = lane->left_boundary().curve().pts().at(i).x();
-    left_line[i][1] = lane->left_boundary().curve().pts().at(i).y();
-    right_line[i][0] = lane->right_boundary().curve().pts().at(i).x();
-    right_line[i][1] = lane->right_boundary().curve().pts().at(i).y();
+               std::min(left_pts.size(), right_pts.size()));
+  writer.StartArray();
+  for (size_t i = 0; i < pts_size; i++) {
+    writer.Point(left_pts[i].x(), left_pts[i].y());
   }
-  data.emplace_back(left_line);
-  data.emplace_back(right_line);
+  writer.EndArray();
+  writer.StartArray();
+  for (size_t i = 0; i < pts_size; i++) {
+    writer.Point(right_pts[i].x(), right_pts[i].y());
+  }
+  writer.EndArray();
   return true;
 }
 
-bool ConvertLaneToSimplePts(core::Lane::ConstPtr lane, Json& data) {
-  Json left_line;
-  Json right_line;
+bool ConvertLaneToSimplePts(core::Lane::ConstPtr lane, JsonWriter& writer) {
   if (common::IsLineGeometry(lane)) {
     // 只取头尾两个点
-    left_line[0][0] = lane->left_boundary().curve().pts().front().x();
-    left_line[0][1] = lane->left_boundary().curve().pts().front().y();
-    left_line[1][0] = lane->left_boundary().curve().pts().back().x();
-    left_line[1][1] = lane->left_boundary().curve().pts().back().y();
-
-    right_line[0][0] = lane->right_boundary().curve().pts().front().x();
-    right_line[0][1] = lane->right_boundary().curve().pts().front().y();
-    right_line[1][0] = lane->right_boundary().curve().pts().back().x();
-    right_line[1][1] = lane->right_boundary().curve().pts().back().y();
-    data.emplace_back(left_line);
-    data.emplace_back(right_line);
+    const auto& left_pts = lane->left_boundary().curve().pts();
+    const auto& right_pts = lane->right_boundary().curve().pts();
+    writer.StartArray()
+        .Point(left_pts.front().x(), left_pts.front().y())
+        .Point(left_pts.back().x(), left_pts.back().y())
+        .EndArray();
+    writer.StartArray()
+        .Point(right_pts.front().x(), right_pts.front().y())
+        .Point(right_pts.back().x(), right_pts.back().y())
+        .EndArray();
   } else {
-    ConvertLaneToPts(lane, data);
+    ConvertLaneToPts(lane, writer);
   }
   return true;
 }
@@ -9,6 +9,8 @@
 #include <memory>
 #include <nlohmann/json.hpp>
 
+#include "json_writer.h"
+
 namespace opendrive {
 namespace engine {
 namespace server {
@@ -18,11 +20,11 @@ typedef nlohmann::json::value_t JsonValueType;
 typedef std::string Data;
 typedef std::unordered_map<std::string, JsonValueType> RequiredKeys;
 
-bool ConvertLineToPts(const core::Curve& line, Json& line_json);
+bool ConvertLineToPts(const core::Curve& line, JsonWriter& writer);
 
-bool ConvertLaneToPts(core::Lane::ConstPtr lane, Json& data);
+bool ConvertLaneToPts(core::Lane::ConstPtr lane, JsonWriter& writer);
 
-bool ConvertLaneToSimplePts(core::Lane::ConstPtr lane, Json& data);
+bool ConvertLaneToSimplePts(core::Lane::ConstPtr lane, JsonWriter& writer);
 
 }  // namespace server
 }  // namespace engine
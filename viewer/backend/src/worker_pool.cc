@@ -0,0 +1,100 @@
+#include "worker_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace opendrive {
+namespace engine {
+namespace server {
+
+WorkerPool::WorkerPool(const WorkerConfig& config) : config_(config) {
+  workers_.reserve(config_.thread_num);
+  for (int i = 0; i < config_.thread_num; ++i) {
+    workers_.emplace_back(&WorkerPool::Run, this);
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    stop_ = true;
+  }
+  cond_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+size_t WorkerPool::Queue(const std::string& endpoint) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  for (size_t i = 0; i < queues_.size(); ++i) {
+    if (endpoint == queues_[i]->name) return i;
+  }
+  std::unique_ptr<TaskQueue> queue(new TaskQueue);
+  queue->name = endpoint;
+  auto iter = config_.queues.find(endpoint);
+  if (iter != config_.queues.end()) {
+    queue->config = iter->second;
+  }
+  if (queue->config.max_running <= 0 ||
+      queue->config.max_running > config_.thread_num) {
+    queue->config.max_running = config_.thread_num;
+  }
+  order_.emplace_back(queue.get());
+  std::stable_sort(order_.begin(), order_.end(),
+                   [](const TaskQueue* lhs, const TaskQueue* rhs) {
+                     return lhs->config.priority > rhs->config.priority;
+                   });
+  queues_.emplace_back(std::move(queue));
+  return queues_.size() - 1;
+}
+
+bool WorkerPool::Submit(size_t queue, Task task) {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto& target = queues_.at(queue);
+    if (stop_ ||
+        target->tasks.size() >= static_cast<size_t>(target->config.capacity)) {
+      return false;
+    }
+    target->tasks.emplace_back(std::move(task));
+  }
+  cond_.notify_one();
+  return true;
+}
+
+WorkerPool::TaskQueue* WorkerPool::Pick() {
+  for (auto queue : order_) {
+    if (!queue->tasks.empty() &&
+        queue->running < queue->config.max_running) {
+      return queue;
+    }
+  }
+  return nullptr;
+}
+
+void WorkerPool::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    TaskQueue* queue = nullptr;
+    cond_.wait(lock, [this, &queue] {
+      queue = Pick();
+      return stop_ || queue;
+    });
+    if (!queue) return;  // stopped and drained
+    Task task = std::move(queue->tasks.front());
+    queue->tasks.pop_front();
+    ++queue->running;
+    const bool capped = queue->running == queue->config.max_running;
+    lock.unlock();
+    task();
+    lock.lock();
+    --queue->running;
+    // a capped queue may have work that every idle worker skipped
+    if (capped && !queue->tasks.empty()) cond_.notify_one();
+  }
+}
+
+}  // namespace server
+}  // namespace engine
+}  // namespace opendrive
@@ -0,0 +1,63 @@
+#ifndef OPENDRIVE_ENGINE_SERVER_WORKER_POOL_H_
+#define OPENDRIVE_ENGINE_SERVER_WORKER_POOL_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "param.h"
+
+namespace opendrive {
+namespace engine {
+namespace server {
+
+/**
+ * @class WorkerPool
+ * @brief Fixed set of threads running engine queries off the http threads.
+ *        Every endpoint owns a bounded queue. Idle workers take from the
+ *        highest priority queue that is not empty and still below its
+ *        max_running, so a few slow full-map requests can never occupy all
+ *        workers. Submit fails instead of blocking when a queue is full.
+ */
+class WorkerPool {
+ public:
+  typedef std::shared_ptr<WorkerPool> Ptr;
+  typedef std::function<void()> Task;
+  explicit WorkerPool(const WorkerConfig& config);
+  ~WorkerPool();
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+  // returns the queue index of the endpoint, created on first use
+  size_t Queue(const std::string& endpoint);
+  // false when the queue is full, the task is dropped
+  bool Submit(size_t queue, Task task);
+
+ private:
+  struct TaskQueue {
+    std::string name;
+    QueueConfig config;
+    std::deque<Task> tasks;
+    int running = 0;
+  };
+  void Run();
+  TaskQueue* Pick();
+  WorkerConfig config_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::vector<std::unique_ptr<TaskQueue>> queues_;  // by index
+  std::vector<TaskQueue*> order_;                   // by priority
+  std::vector<std::thread> workers_;
+  bool stop_ = false;
+};
+
+}  // namespace server
+}  // namespace engine
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_ENGINE_SERVER_WORKER_POOL_H_
@@ -0,0 +1,128 @@
+// Full-map response: nlohmann dom + dump(0) versus the streaming JsonWriter.
+// usage: engine_server_json_benchmark xxx.xodr [rounds]
+#include <opendrive-engine/common/common.h>
+#include <opendrive-engine/engine.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "src/json_writer.h"
+#include "src/util.h"
+
+namespace {
+
+using opendrive::engine::core::Lane;
+using opendrive::engine::server::Json;
+using opendrive::engine::server::JsonWriter;
+
+// the dom conversion the viewer used before the streaming writer
+void DomLaneToPts(Lane::ConstPtr lane, Json& data) {
+  const auto& left_pts = lane->left_boundary().curve().pts();
+  const auto& right_pts = lane->right_boundary().curve().pts();
+  Json left_line;
+  Json right_line;
+  if (opendrive::engine::common::IsLineGeometry(lane)) {
+    left_line[0][0] = left_pts.front().x();
+    left_line[0][1] = left_pts.front().y();
+    left_line[1][0] = left_pts.back().x();
+    left_line[1][1] = left_pts.back().y();
+    right_line[0][0] = right_pts.front().x();
+    right_line[0][1] = right_pts.front().y();
+    right_line[1][0] = right_pts.back().x();
+    right_line[1][1] = right_pts.back().y();
+  } else {
+    size_t pts_size =
+        std::min(lane->central_curve().pts().size(),
+                 std::min(left_pts.size(), right_pts.size()));
+    for (size_t i = 0; i < pts_size; i++) {
+      left_line[i][0] = left_pts[i].x();
+      left_line[i][1] = left_pts[i].y();
+      right_line[i][0] = right_pts[i].x();
+      right_line[i][1] = right_pts[i].y();
+    }
+  }
+  data.emplace_back(left_line);
+  data.emplace_back(right_line);
+}
+
+std::string DomResponse(const Lane::ConstPtrs& lanes) {
+  Json results;
+  for (const auto& lane : lanes) {
+    DomLaneToPts(lane, results);
+  }
+  Json response;
+  response["code"] = 0;
+  response["msg"] = "ok";
+  response["results"] = results;
+  return response.dump(0);
+}
+
+const std::string& WriterResponse(const Lane::ConstPtrs& lanes) {
+  JsonWriter& writer = JsonWriter::ThreadLocal();
+  writer.StartObject();
+  writer.Key("code").Value(0);
+  writer.Key("msg").Value("ok");
+  writer.Key("results").StartArray();
+  for (const auto& lane : lanes) {
+    opendrive::engine::server::ConvertLaneToSimplePts(lane, writer);
+  }
+  writer.EndArray();
+  writer.EndObject();
+  return writer.str();
+}
+
+template <typename Func>
+double Measure(int rounds, size_t& bytes, Func func) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < rounds; ++i) {
+    bytes = func().size();
+  }
+  std::chrono::duration<double, std::milli> cost =
+      std::chrono::steady_clock::now() - start;
+  return cost.count() / rounds;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    std::cerr << "Used engine_server_json_benchmark xxx.xodr [rounds]"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  int rounds = argc > 2 ? std::atoi(argv[2]) : 20;
+  opendrive::engine::common::Param param;
+  param.map_file = argv[1];
+  opendrive::engine::Engine engine;
+  auto status = engine.Init(param);
+  if (opendrive::engine::ErrorCode::OK != status.error_code) {
+    std::cerr << "engine init fault: " << status.msg << std::endl;
+    return EXIT_FAILURE;
+  }
+  auto lanes = engine.GetLanes();
+  WriterResponse(lanes);  // warm up the thread local buffer
+
+  size_t dom_bytes = 0;
+  size_t writer_bytes = 0;
+  double dom_ms = Measure(rounds, dom_bytes,
+                          [&lanes]() { return DomResponse(lanes); });
+  double writer_ms = Measure(rounds, writer_bytes, [&lanes]() {
+    return std::string(WriterResponse(lanes));
+  });
+  double writer_only_ms = Measure(rounds, writer_bytes,
+                                  [&lanes]() -> const std::string& {
+                                    return WriterResponse(lanes);
+                                  });
+  std::cout << "lanes: " << lanes.size() << ", rounds: " << rounds
+            << std::endl;
+  std::cout << "dom + dump:     " << dom_ms << " ms, " << dom_bytes
+            << " bytes" << std::endl;
+  std::cout << "writer + copy:  " << writer_ms << " ms" << std::endl;
+  std::cout << "writer:         " << writer_only_ms << " ms, "
+            << writer_bytes << " bytes" << std::endl;
+  return EXIT_SUCCESS;
+}
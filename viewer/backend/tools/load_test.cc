@@ -0,0 +1,370 @@
+// Closed-loop load generator for engine_server over loopback.
+// usage: engine_server_load_test [--host=127.0.0.1] [--port=9070]
+//            [--connections=8] [--duration=10]
+//            [--mix=map:1,nearest_lane:20,map_match:0,tile:0]
+//            [--bbox=xmin,ymin,xmax,ymax]
+// Every connection sends one request at a time over keep-alive http/1.1 and
+// picks the request kind by weight. Latency is measured per request from
+// the first byte sent to the last body byte received.
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+enum Kind { kMap = 0, kNearestLane, kMapMatch, kTile, kKindNum };
+const char* const kKindNames[kKindNum] = {"map", "nearest_lane", "map_match",
+                                          "tile"};
+// the tile endpoint does not exist yet, requests are reported as errors
+const char* const kTilePath = "/opendrive/engine/tile/";
+// viewer HttpStatusCode::SUCCESS and BUSY
+const int kCodeSuccess = 1000;
+const int kCodeBusy = 1003;
+
+struct Options {
+  std::string host = "127.0.0.1";
+  int port = 9070;
+  int connections = 8;
+  double duration = 10;
+  double weights[kKindNum] = {1, 20, 0, 0};
+  double bbox[4] = {-100, -100, 100, 100};
+};
+
+struct Sample {
+  Kind kind;
+  uint64_t nanoseconds;
+  bool ok;
+  bool busy;
+};
+
+bool ParseList(const std::string& value, double* out, size_t num) {
+  size_t pos = 0;
+  for (size_t i = 0; i < num; ++i) {
+    size_t end = value.find(',', pos);
+    out[i] = std::atof(value.substr(pos, end - pos).c_str());
+    if (end == std::string::npos) return i + 1 == num;
+    pos = end + 1;
+  }
+  return true;
+}
+
+bool ParseMix(const std::string& value, double* weights) {
+  std::fill(weights, weights + kKindNum, 0);
+  size_t pos = 0;
+  while (pos <= value.size()) {
+    size_t end = std::min(value.find(',', pos), value.size());
+    std::string item = value.substr(pos, end - pos);
+    size_t colon = item.find(':');
+    if (colon == std::string::npos) return false;
+    std::string name = item.substr(0, colon);
+    int kind = 0;
+    while (kind < kKindNum && name != kKindNames[kind]) ++kind;
+    if (kKindNum == kind) return false;
+    weights[kind] = std::max(0.0, std::atof(item.c_str() + colon + 1));
+    pos = end + 1;
+  }
+  return true;
+}
+
+bool ParseOptions(int argc, char* argv[], Options& options) {
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    size_t eq = arg.find('=');
+    if (0 != arg.compare(0, 2, "--") || eq == std::string::npos) return false;
+    std::string key = arg.substr(2, eq - 2);
+    std::string value = arg.substr(eq + 1);
+    if ("host" == key) {
+      options.host = value;
+    } else if ("port" == key) {
+      options.port = std::atoi(value.c_str());
+    } else if ("connections" == key) {
+      options.connections = std::max(1, std::atoi(value.c_str()));
+    } else if ("duration" == key) {
+      options.duration = std::max(0.1, std::atof(value.c_str()));
+    } else if ("mix" == key) {
+      if (!ParseMix(value, options.weights)) return false;
+    } else if ("bbox" == key) {
+      if (!ParseList(value, options.bbox, 4)) return false;
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+class Connection {
+ public:
+  explicit Connection(const Options& options) : options_(options) {}
+  ~Connection() { Close(); }
+
+  // sends the request and reads the whole response, reconnecting once when
+  // the server dropped the keep-alive connection.
+  bool RoundTrip(const std::string& request, int& http_status,
+                 std::string& body) {
+    for (int attempt = 0; attempt < 2; ++attempt) {
+      if (fd_ < 0 && !Connect()) return false;
+      if (Send(request) && Receive(http_status, body)) return true;
+      Close();
+    }
+    return false;
+  }
+
+ private:
+  bool Connect() {
+    fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd_ < 0) return false;
+    int flag = 1;
+    setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(options_.port);
+    if (1 != inet_pton(AF_INET, options_.host.c_str(), &addr.sin_addr) ||
+        0 != connect(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr))) {
+      Close();
+      return false;
+    }
+    buffer_.clear();
+    return true;
+  }
+
+  void Close() {
+    if (fd_ >= 0) close(fd_);
+    fd_ = -1;
+  }
+
+  bool Send(const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+      ssize_t n = send(fd_, data.data() + sent, data.size() - sent,
+                       MSG_NOSIGNAL);
+      if (n <= 0) return false;
+      sent += n;
+    }
+    return true;
+  }
+
+  // false on eof before anything was read
+  bool Fill() {
+    char chunk[64 * 1024];
+    ssize_t n = recv(fd_, chunk, sizeof(chunk), 0);
+    if (n <= 0) return false;
+    buffer_.append(chunk, n);
+    return true;
+  }
+
+  bool Receive(int& http_status, std::string& body) {
+    size_t header_end;
+    while ((header_end = buffer_.find("\r\n\r\n")) == std::string::npos) {
+      if (!Fill()) return false;
+    }
+    std::string header = buffer_.substr(0, header_end);
+    buffer_.erase(0, header_end + 4);
+    http_status = 0;
+    std::sscanf(header.c_str(), "HTTP/%*d.%*d %d", &http_status);
+    std::transform(header.begin(), header.end(), header.begin(), ::tolower);
+    size_t length_pos = header.find("content-length:");
+    bool keep_alive = header.find("connection: close") == std::string::npos;
+    if (length_pos == std::string::npos) {
+      // no length, the body runs until the server closes
+      while (Fill()) {
+      }
+      body.swap(buffer_);
+      buffer_.clear();
+      Close();
+      return true;
+    }
+    size_t length = std::strtoul(header.c_str() + length_pos + 15, nullptr, 10);
+    while (buffer_.size() < length) {
+      if (!Fill()) return false;
+    }
+    body.assign(buffer_, 0, length);
+    buffer_.erase(0, length);
+    if (!keep_alive) Close();
+    return true;
+  }
+
+  const Options& options_;
+  int fd_ = -1;
+  std::string buffer_;
+};
+
+std::string MakeRequest(Kind kind, const Options& options, int client,
+                        std::mt19937& rng) {
+  std::uniform_real_distribution<double> x_dist(options.bbox[0],
+                                                options.bbox[2]);
+  std::uniform_real_distribution<double> y_dist(options.bbox[1],
+                                                options.bbox[3]);
+  const std::string host = options.host + ":" + std::to_string(options.port);
+  std::string body;
+  std::string path;
+  switch (kind) {
+    case kMap:
+      path = "/opendrive/engine/map/";
+      break;
+    case kNearestLane:
+      path = "/opendrive/engine/nearest_lane/";
+      body = "{\"x\":" + std::to_string(x_dist(rng)) +
+             ",\"y\":" + std::to_string(y_dist(rng)) + "}";
+      break;
+    case kMapMatch: {
+      path = "/opendrive/engine/map_match/";
+      const double x = x_dist(rng);
+      const double y = y_dist(rng);
+      body = "{\"session\":\"load_test_" + std::to_string(client) +
+             "\",\"poses\":[";
+      for (int i = 0; i < 10; ++i) {
+        if (i) body += ",";
+        body += "{\"x\":" + std::to_string(x + i) +
+                ",\"y\":" + std::to_string(y) + ",\"heading\":0}";
+      }
+      body += "]}";
+      break;
+    }
+    default:
+      path = std::string(kTilePath) + "?x=" + std::to_string(x_dist(rng)) +
+             "&y=" + std::to_string(y_dist(rng));
+      break;
+  }
+  std::string request = (body.empty() ? "GET " : "POST ") + path +
+                        " HTTP/1.1\r\nHost: " + host +
+                        "\r\nConnection: keep-alive\r\n";
+  if (!body.empty()) {
+    request += "Content-Type: application/json\r\nContent-Length: " +
+               std::to_string(body.size()) + "\r\n";
+  }
+  return request + "\r\n" + body;
+}
+
+int ResponseCode(const std::string& body) {
+  const char* key = "\"code\":";
+  size_t pos = body.find(key);
+  if (pos == std::string::npos) return 0;
+  return std::atoi(body.c_str() + pos + std::strlen(key));
+}
+
+void Client(const Options& options, int client, Clock::time_point deadline,
+            std::vector<Sample>& samples) {
+  std::mt19937 rng(client * 7919 + 17);
+  std::discrete_distribution<int> kind_dist(options.weights,
+                                            options.weights + kKindNum);
+  Connection connection(options);
+  std::string body;
+  while (Clock::now() < deadline) {
+    Sample sample;
+    sample.kind = static_cast<Kind>(kind_dist(rng));
+    std::string request = MakeRequest(sample.kind, options, client, rng);
+    int http_status = 0;
+    auto start = Clock::now();
+    bool done = connection.RoundTrip(request, http_status, body);
+    sample.nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             Clock::now() - start)
+                             .count();
+    int code = done ? ResponseCode(body) : 0;
+    sample.busy = kCodeBusy == code;
+    sample.ok = done && 200 == http_status && kCodeSuccess == code;
+    samples.emplace_back(sample);
+    if (!done) {
+      // server down, do not spin
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+}
+
+const char* const kHeaderFormat = "%-13s %9s %10s %7s %7s %9s %9s %9s %9s";
+const char* const kRowFormat =
+    "%-13s %9zu %10.1f %7zu %7zu %9.3f %9.3f %9.3f %9.3f";
+
+double Percentile(const std::vector<uint64_t>& sorted, double p) {
+  if (sorted.empty()) return 0;
+  size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+  return sorted[index] * 1e-6;
+}
+
+void Report(const std::string& name, const std::vector<Sample>& samples,
+            int kind, double seconds) {
+  std::vector<uint64_t> latency;
+  size_t errors = 0;
+  size_t busy = 0;
+  for (const auto& sample : samples) {
+    if (kind >= 0 && sample.kind != kind) continue;
+    latency.emplace_back(sample.nanoseconds);
+    if (sample.busy) {
+      ++busy;
+    } else if (!sample.ok) {
+      ++errors;
+    }
+  }
+  if (latency.empty()) return;
+  std::sort(latency.begin(), latency.end());
+  char line[256];
+  std::snprintf(line, sizeof(line), kRowFormat, name.c_str(), latency.size(),
+                latency.size() / seconds, errors, busy,
+                Percentile(latency, 0.5), Percentile(latency, 0.99),
+                Percentile(latency, 0.999), latency.back() * 1e-6);
+  std::cout << line << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  Options options;
+  if (!ParseOptions(argc, argv, options) ||
+      std::all_of(options.weights, options.weights + kKindNum,
+                  [](double weight) { return weight <= 0; })) {
+    std::cerr << "Used engine_server_load_test [--host=127.0.0.1] "
+                 "[--port=9070] [--connections=8] [--duration=10] "
+                 "[--mix=map:1,nearest_lane:20,map_match:0,tile:0] "
+                 "[--bbox=xmin,ymin,xmax,ymax]"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::vector<std::vector<Sample>> samples(options.connections);
+  std::vector<std::thread> clients;
+  auto start = Clock::now();
+  auto deadline =
+      start + std::chrono::duration_cast<Clock::duration>(
+                  std::chrono::duration<double>(options.duration));
+  for (int i = 0; i < options.connections; ++i) {
+    clients.emplace_back(Client, std::cref(options), i, deadline,
+                         std::ref(samples[i]));
+  }
+  for (auto& client : clients) {
+    client.join();
+  }
+  double seconds =
+      std::chrono::duration<double>(Clock::now() - start).count();
+
+  std::vector<Sample> all;
+  for (const auto& item : samples) {
+    all.insert(all.end(), item.begin(), item.end());
+  }
+  std::cout << "connections: " << options.connections
+            << ", duration: " << seconds << " s" << std::endl;
+  char header[256];
+  std::snprintf(header, sizeof(header), kHeaderFormat, "kind", "requests",
+                "req/s", "errors", "busy", "p50(ms)", "p99(ms)", "p999(ms)",
+                "max(ms)");
+  std::cout << header << std::endl;
+  for (int kind = 0; kind < kKindNum; ++kind) {
+    Report(kKindNames[kind], all, kind, seconds);
+  }
+  Report("total", all, -1, seconds);
+  return EXIT_SUCCESS;
+}